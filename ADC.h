@@ -8,6 +8,7 @@
 #ifndef SOURCES_ADC_H_
 #define SOURCES_ADC_H_
 
+#include "MK64F12.h"
 #include "DataTypeDefinitions.h"
 
 /**
@@ -20,6 +21,8 @@ typedef struct{
 	uint8 flag :1;
 	/*MailBoxData has the ADC convertion result*/
 	float MailBoxData;
+	/*timeStamp has the lifetime timer value when the convertion completed*/
+	uint64 timeStamp;
 }ADC_MailBoxType;
 
 /**
@@ -129,6 +132,44 @@ typedef struct{
 	hardwareAverageSamples averageSamples :2;
 }ADC_ConfigType;
 
+/**
+ * Registers of each ADC, indexed by ADC_ChannelType, so the driver doesn't need a switch
+ * for each instance. Channels A and B are indexed by AB_ChannelType in SC1 and R.
+ * **/
+extern ADC_Type* const ADC_handle[2];
+
+/**
+ * The next inline functions are the fast path. They receive the registers of the ADC
+ * (ADC0, ADC1 or ADC_handle[]), so they compile to a couple of accesses, with no branches.
+ */
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts a convertion of the input channel, keeping the
+ 	 interruption enable of the channel
+ 	 \param[in] adc - registers of the ADC
+ 	 \param[in] nchannel - channel A or B
+ 	 \param[in] inputChannel - input to convert
+ 	 \return void
+ */
+static inline void ADC_start(ADC_Type* adc, AB_ChannelType nchannel, inputChannelSelect inputChannel){
+	adc->SC1[nchannel] = (inputChannel & ADC_SC1_ADCH_MASK) | (adc->SC1[nchannel] & ADC_SC1_AIEN_MASK);
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function reads the result of the last convertion
+ 	 \param[in] adc - registers of the ADC
+ 	 \param[in] nchannel - channel A or B
+ 	 \return uint32 - convertion result
+ */
+static inline uint32 ADC_result(ADC_Type* adc, AB_ChannelType nchannel){
+	return adc->R[nchannel];
+}
+
 /**
  * This first set of functions, are for writting to status and control registers, and
  * configuration register of the ADC directly
@@ -356,6 +397,16 @@ float ADC_mailBoxData(ADC_ChannelType xchannel);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the lifetime timer value (see PIT_lifetimeRead()) taken
+ 	 when the last convertion completed. It doesn't change the mailBox flag
+ 	 \param[in] xchannel - ADC of the convertion
+ 	 \return uint64 - timestamp of the convertion
+ */
+uint64 ADC_mailBoxTimeStamp(ADC_ChannelType xchannel);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
 /*!
  	 \brief	 This function star the seqential conversion depending of which ADC Channel, AB Channel and
  	 Input Channel is triggered
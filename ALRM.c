@@ -0,0 +1,126 @@
+/**
+	\file
+	\brief
+		This is the source file for the temperature alarm. The samples of the window are at
+		x = 0 (the oldest one) to n - 1 (the newest one), so the sums of x and of x*x only
+		depend on n, and the fit keeps the sum of y and the sum of x*y. When the window is
+		full and a sample enters, every sample gets one position older:
+			sum(x*y) = sum(x*y) - (sum(y) - oldest) + (ALRM_WINDOW - 1)*newest
+		The slope is num/den, with num = n*sum(x*y) - sum(x)*sum(y) and
+		den = n*sum(x*x) - sum(x)^2. The line at the newest sample, multiplied by 2*n*den, is
+		2*den*sum(y) + (n - 1)*n*num, so the samples until it reaches the threshold are
+		margin/(2*n*num), with margin the distance to the threshold also multiplied by
+		2*n*den. It is compared with the horizon without dividing.
+	\date	19/10/2026
+ */
+
+#include "ALRM.h"
+
+/*Samples of the window, ALRM_next is where the next one is written*/
+static sint32 ALRM_window[ALRM_WINDOW];
+static uint16 ALRM_next = 0;
+static uint16 ALRM_count = 0;
+/*Sums of the fit*/
+static sint32 ALRM_sumY = 0;
+static sint64 ALRM_sumXY = 0;
+/*Horizon of the prealarm, in samples, and time between samples*/
+static uint32 ALRM_horizon = 0;
+static uint32 ALRM_samplePeriod = 1;
+/*State of the alarm*/
+static ALRM_LevelType ALRM_current = ALRM_NONE;
+
+/*Add a sample to the window, the oldest one leaves if it is full*/
+static void ALRM_add(sint32 temperature){
+	sint32 oldest;
+
+	if(ALRM_WINDOW == ALRM_count){
+		oldest = ALRM_window[ALRM_next];
+		ALRM_sumXY -= ALRM_sumY - oldest;
+		ALRM_sumY -= oldest;
+		ALRM_sumXY += (sint64)(ALRM_WINDOW - 1) * temperature;
+	} else {
+		ALRM_sumXY += (sint64)ALRM_count * temperature;
+		ALRM_count++;
+	}
+	ALRM_sumY += temperature;
+	ALRM_window[ALRM_next] = temperature;
+	ALRM_next = (ALRM_next + 1 == ALRM_WINDOW) ? 0 : ALRM_next + 1;
+}
+
+/*Numerator of the slope*/
+static sint64 ALRM_slopeNum(){
+	sint64 n = ALRM_count;
+
+	return n * ALRM_sumXY - (n * (n - 1) / 2) * ALRM_sumY;
+}
+
+/*Denominator of the slope, n^2*(n^2 - 1)/12*/
+static sint64 ALRM_slopeDen(){
+	sint64 n = ALRM_count;
+
+	return n * n * (n * n - 1) / 12;
+}
+
+/*Tells if the line reaches the threshold within horizon samples. With release, the horizon
+ * is stretched by ALRM_RELEASE_PERCENT*/
+static uint8 ALRM_reaches(sint32 threshold, uint8 release){
+	sint64 n = ALRM_count;
+	sint64 num = ALRM_slopeNum();
+	sint64 den = ALRM_slopeDen();
+	sint64 margin;
+	sint64 horizon = ALRM_horizon;
+
+	/*A line that doesn't go up never reaches it*/
+	if(num <= 0){
+		return FALSE;
+	}
+	margin = 2 * n * den * threshold - (2 * den * ALRM_sumY + (n - 1) * n * num);
+	if(release){
+		horizon = horizon * ALRM_RELEASE_PERCENT / 100;
+	}
+	return (margin < horizon * 2 * n * num) ? TRUE : FALSE;
+}
+
+void ALRM_init(uint32 samplePeriod, uint16 horizon){
+	ALRM_next = 0;
+	ALRM_count = 0;
+	ALRM_sumY = 0;
+	ALRM_sumXY = 0;
+	ALRM_samplePeriod = samplePeriod ? samplePeriod : 1;
+	ALRM_horizon = (uint32)horizon * 1000 / ALRM_samplePeriod;
+	ALRM_current = ALRM_NONE;
+}
+
+ALRM_LevelType ALRM_update(sint32 temperature, sint32 threshold){
+	ALRM_add(temperature);
+
+	/*The alarm, until the temperature is ALRM_HYSTERESIS under the threshold*/
+	if(temperature >= threshold){
+		ALRM_current = ALRM_ALARM;
+		return ALRM_current;
+	}
+	if((ALRM_ALARM == ALRM_current) && (temperature >= threshold - ALRM_HYSTERESIS)){
+		return ALRM_current;
+	}
+
+	/*The prealarm, until the line is well beyond the horizon*/
+	if(ALRM_count < ALRM_MIN_SAMPLES){
+		ALRM_current = ALRM_NONE;
+	} else if(ALRM_PREALARM == ALRM_current){
+		ALRM_current = ALRM_reaches(threshold, TRUE) ? ALRM_PREALARM : ALRM_NONE;
+	} else {
+		ALRM_current = ALRM_reaches(threshold, FALSE) ? ALRM_PREALARM : ALRM_NONE;
+	}
+	return ALRM_current;
+}
+
+ALRM_LevelType ALRM_level(){
+	return ALRM_current;
+}
+
+sint32 ALRM_slope(){
+	if(ALRM_count < ALRM_MIN_SAMPLES){
+		return 0;
+	}
+	return (sint32)(ALRM_slopeNum() * 60000 / ((sint64)ALRM_samplePeriod * ALRM_slopeDen()));
+}
@@ -0,0 +1,79 @@
+/**
+	\file
+	\brief
+		This is the header file for the temperature alarm. Besides the alarm, that is on
+		while the temperature is at the threshold or over it, there is a prealarm that warns
+		before: a least-squares line is fitted to the last ALRM_WINDOW samples, and if it
+		reaches the threshold within the horizon, the prealarm is on. Both have hysteresis,
+		so a temperature that hovers around the threshold doesn't make them chatter.
+		Everything is done with integers, in hundredths of degree, and each sample costs
+		O(1): the sums of the fit are updated with the sample that enters the window and the
+		one that leaves it.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_ALRM_H_
+#define SOURCES_ALRM_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+
+/** Samples of the window of the fit */
+#define ALRM_WINDOW 32
+/** Samples that the window needs before the prealarm is checked */
+#define ALRM_MIN_SAMPLES 8
+/** Default horizon of the prealarm, in seconds */
+#define ALRM_HORIZON_S 60
+/** The prealarm is turned off when the threshold is farther than this percentage of the
+ * horizon */
+#define ALRM_RELEASE_PERCENT 150
+/** The alarm is turned off when the temperature is this much under the threshold, in
+ * hundredths of degree */
+#define ALRM_HYSTERESIS 50
+
+/*! This enumerated constant is the state of the alarm*/
+typedef enum {ALRM_NONE, ALRM_PREALARM, ALRM_ALARM} ALRM_LevelType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function empties the window of the fit and turns off the alarm
+ 	 \param[in] samplePeriod - time between two samples, in ms
+ 	 \param[in] horizon - the prealarm is on if the threshold is reached within these
+ 	 seconds
+ 	 \return void
+ */
+void ALRM_init(uint32 samplePeriod, uint16 horizon);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function adds a sample to the window of the fit, and updates the alarm
+ 	 \param[in] temperature - temperature of the sample, in hundredths of Celsius degree
+ 	 \param[in] threshold - alarm threshold, in hundredths of Celsius degree
+ 	 \return ALRM_LevelType - state of the alarm after the sample
+ */
+ALRM_LevelType ALRM_update(sint32 temperature, sint32 threshold);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the state of the alarm, as the last sample left it
+ 	 \return ALRM_LevelType - state of the alarm
+ */
+ALRM_LevelType ALRM_level();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the slope of the fit
+ 	 \return sint32 - hundredths of Celsius degree per minute, 0 with less than
+ 	 ALRM_MIN_SAMPLES samples
+ */
+sint32 ALRM_slope();
+
+#endif /* SOURCES_ALRM_H_ */
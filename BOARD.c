@@ -0,0 +1,54 @@
+/**
+	\file
+	\brief
+		This is the source file for the board description, it has the pinout of the
+		temperature controller board: buttons, LCD, motor PWM, frequency meter, buzzer and
+		serial port.
+	\date	19/10/2026
+ */
+
+#include "MK64F12.h"
+#include "BOARD.h"
+#include "LCDNokia5110.h"
+
+/**
+ * Pinout of the board. A pin must appear only once.
+ * **/
+static const BOARD_PinGroupType BOARD_pins[] = {
+		/*Buttons B0 to B5, interruption on the press*/
+		{GPIOC, GPIO_MASK(BOARD_BUTTON_0_PIN) | GPIO_MASK(BOARD_BUTTON_1_PIN) |
+				GPIO_MASK(BOARD_BUTTON_2_PIN) | GPIO_MASK(BOARD_BUTTON_3_PIN) |
+				GPIO_MASK(BOARD_BUTTON_4_PIN) | GPIO_MASK(BOARD_BUTTON_5_PIN),
+				GPIO_MUX1 | INTR_RISING_EDGE, GPIO_INPUT, 0},
+		/*Motor PWM, FTM0 channel 1*/
+		{GPIOC, GPIO_MASK(BOARD_PWM_PIN), GPIO_MUX4, GPIO_INPUT, 0},
+		/*Frequency meter, FTM2 channel 1*/
+		{GPIOB, GPIO_MASK(BOARD_CAPTURE_PIN), GPIO_MUX3, GPIO_INPUT, 0},
+		/*Alarm buzzer tone, FTM2 channel 0*/
+		{GPIOB, GPIO_MASK(BOARD_BUZZER_PIN), GPIO_MUX3, GPIO_INPUT, 0},
+		/*Serial port, UART0 receiver and transmitter*/
+		{GPIOB, GPIO_MASK(BOARD_UART_RX_PIN) | GPIO_MASK(BOARD_UART_TX_PIN), GPIO_MUX3, GPIO_INPUT, 0},
+		/*LCD SPI0 clock and data out*/
+		{GPIOD, GPIO_MASK(BOARD_SPI_CLK_PIN) | GPIO_MASK(BOARD_SPI_SOUT_PIN), GPIO_MUX2, GPIO_INPUT, 0},
+		/*LCD data or command and reset, the LCD is kept in reset until LCDNokia_init()*/
+		{GPIOD, GPIO_MASK(DATA_OR_CMD_PIN) | GPIO_MASK(RESET_PIN), GPIO_MUX1, GPIO_OUTPUT, 0}
+};
+
+/*Number of groups in BOARD_pins*/
+#define BOARD_PIN_GROUPS (sizeof(BOARD_pins)/sizeof(BOARD_pins[0]))
+
+void BOARD_init(){
+	const BOARD_PinGroupType* group;
+	uint8 index;
+
+	for(index = 0; index < BOARD_PIN_GROUPS; index++){
+		group = &BOARD_pins[index];
+		/*The pin control registers of a port can't be written without its clock*/
+		GPIO_clockGating(group->portName);
+		if(GPIO_OUTPUT == group->direction){
+			GPIO_writeMask(GPIO_handle[group->portName], group->mask, group->value);
+		}
+		GPIO_dataDirectionMask(group->portName, group->mask, group->direction);
+		GPIO_pinControlMask(group->portName, group->mask, group->pinControl);
+	}
+}
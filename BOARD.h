@@ -0,0 +1,68 @@
+/**
+	\file
+	\brief
+		This is the header file for the board description. Every pin that the application
+		uses is listed once, in a const table in BOARD.c, with its function, electrical
+		configuration, direction and initial value. BOARD_init() applies the whole table
+		in a single pass at startup, so the drivers don't configure their own pins.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_BOARD_H_
+#define SOURCES_BOARD_H_
+
+#include "DataTypeDefinitions.h"
+#include "GPIO.h"
+
+/**
+ * Pins of the buttons, in PORTC
+ * **/
+#define BOARD_BUTTON_0_PIN BIT5
+#define BOARD_BUTTON_1_PIN BIT7
+#define BOARD_BUTTON_2_PIN BIT0
+#define BOARD_BUTTON_3_PIN BIT9
+#define BOARD_BUTTON_4_PIN BIT8
+#define BOARD_BUTTON_5_PIN BIT1
+
+/** Pin of the alarm buzzer (FTM2 channel 0), in PORTB */
+#define BOARD_BUZZER_PIN BIT18
+/** Pin of the motor PWM (FTM0 channel 1), in PORTC */
+#define BOARD_PWM_PIN BIT2
+/** Pin of the frequency meter input capture (FTM2 channel 1), in PORTB */
+#define BOARD_CAPTURE_PIN BIT19
+/** Pins of the LCD SPI clock and data out (SPI0), in PORTD */
+#define BOARD_SPI_CLK_PIN BIT1
+#define BOARD_SPI_SOUT_PIN BIT2
+/** Pins of the serial port receiver and transmitter (UART0), in PORTB */
+#define BOARD_UART_RX_PIN BIT16
+#define BOARD_UART_TX_PIN BIT17
+
+/**
+ * Struct BOARD_PinGroupType describes a group of pins of a port that share the same
+ * configuration
+ * **/
+typedef struct{
+	/*port of the pins*/
+	GPIO_portNameType portName;
+	/*pins of the group (GPIO_MASK(pin) | ...)*/
+	uint32 mask;
+	/*value of the pin control registers (GPIO_MUXn | GPIO_PE | INTR_...)*/
+	uint32 pinControl;
+	/*GPIO_INPUT or GPIO_OUTPUT, only used by the pins in GPIO_MUX1*/
+	GPIO_PIN_CONFIG direction;
+	/*initial value of the outputs, it is written before they become outputs*/
+	uint32 value;
+}BOARD_PinGroupType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function enables the clock of every port in the board table, and configures
+ 	 each group of pins with one or two writes to the global pin control registers. It must
+ 	 be called before the drivers are initialized.
+ 	 \return void
+ */
+void BOARD_init();
+
+#endif /* SOURCES_BOARD_H_ */
@@ -8,90 +8,233 @@
 #include "BTTN.h"
 #include "NVIC.h"
 #include "GlobalFunctions.h"
-
-/*BTTN_MailBoxType to store the button pressed and the flag of data available*/
-BTTN_MailBoxType BTTN_MailBox = {
-		FALSE,
-		0
+#include "PIT.h"
+#include "BOARD.h"
+
+/*Pin of PORTC of each button, indexed by button*/
+static const uint8 BTTN_pin[BTTN_COUNT] = {
+		BOARD_BUTTON_0_PIN,
+		BOARD_BUTTON_1_PIN,
+		BOARD_BUTTON_2_PIN,
+		BOARD_BUTTON_3_PIN,
+		BOARD_BUTTON_4_PIN,
+		BOARD_BUTTON_5_PIN
 };
 
-/*Intialize the BTTN*/
-void BTTN_init(){
+/*Queue of button events, written by the interruption and the tick, and read by the main loop*/
+static BTTN_EventType BTTN_queue[BTTN_QUEUE_SIZE];
+/*Number of events written and read, they only grow, the index is taken modulo the size*/
+static volatile uint8 BTTN_queueIn = 0;
+static volatile uint8 BTTN_queueOut = 0;
+/*Events lost because the queue was full*/
+static uint16 BTTN_queueOverflows = 0;
+
+/*Time of the last accepted press of each button, for the debouncer*/
+static uint64 BTTN_lastPress[BTTN_COUNT];
+
+/*Buttons pressed by the interruption, the tick takes them out when they are released*/
+static volatile uint16 BTTN_held = 0;
+/*Buttons followed by the tick, and the ones that already gave their BTTN_LONG event*/
+static uint16 BTTN_tracked = 0;
+static uint16 BTTN_longSent = 0;
+/*Scheduler tick of the next BTTN_LONG or BTTN_REPEAT event of each button*/
+static uint32 BTTN_nextEvent[BTTN_COUNT];
+/*Interval until the next BTTN_REPEAT event of each button, it shrinks with every repeat*/
+static uint16 BTTN_repeatInterval[BTTN_COUNT];
+/*Scheduler timer that samples the held buttons*/
+static SCHED_TimerType BTTN_tickTimer;
+
+/*Get the button mask from a value of a PORTC register (PDIR or ISFR)*/
+static uint16 BTTN_decode(uint32 port){
+	uint16 buttons = 0;
+	uint8 button;
+
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		buttons |= ((port >> BTTN_pin[button]) & 1) << button;
+	}
+	return buttons;
+}
+
+/*Put an event in the queue, or count it as lost if there is no room. It is called from the
+ * interruption and from the main loop, so the interruptions are masked*/
+static void BTTN_queuePush(uint16 buttons, BTTN_EventKindType event, uint64 timeStamp){
+	uint32 primask = __get_PRIMASK();
+
+	__disable_irq();
+	if((uint8)(BTTN_queueIn - BTTN_queueOut) >= BTTN_QUEUE_SIZE){
+		BTTN_queueOverflows++;
+	} else {
+		BTTN_queue[BTTN_queueIn & (BTTN_QUEUE_SIZE - 1)].buttons = buttons;
+		BTTN_queue[BTTN_queueIn & (BTTN_QUEUE_SIZE - 1)].event = event;
+		BTTN_queue[BTTN_queueIn & (BTTN_QUEUE_SIZE - 1)].timeStamp = timeStamp;
+		BTTN_queueIn++;
+	}
+	__set_PRIMASK(primask);
+}
+
+/*Scheduler callback, it samples the pins of the held buttons and gives the release, long
+ * press and repeat events, no interruptions are needed for them*/
+static void BTTN_tick(){
+	uint32 now = SCHED_ticks();
+	uint16 pressed;
+	uint16 released;
+	uint16 longPress = 0;
+	uint16 repeat = 0;
+	uint8 button;
+
+	/*Nothing to do while no button is held*/
+	if(!(BTTN_held | BTTN_tracked)){
+		return;
+	}
 
+	/*Start following the buttons that the interruption has pressed since the last tick*/
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		if((BTTN_held & ~BTTN_tracked) & BTTN_MASK(button)){
+			BTTN_nextEvent[button] = now + BTTN_LONG_MS;
+			BTTN_repeatInterval[button] = BTTN_REPEAT_START_MS;
+			BTTN_tracked |= BTTN_MASK(button);
+		}
+	}
+
+	/*A single read of the pins for every button*/
+	pressed = BTTN_decode(PTC->PDIR) & BTTN_tracked;
+	released = BTTN_tracked & ~pressed;
+
+	/*The buttons that are still held give a long press and then repeats that accelerate*/
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		if((pressed & BTTN_MASK(button)) && (sint32)(now - BTTN_nextEvent[button]) >= 0){
+			if(BTTN_longSent & BTTN_MASK(button)){
+				repeat |= BTTN_MASK(button);
+				BTTN_nextEvent[button] = now + BTTN_repeatInterval[button];
+				if(BTTN_repeatInterval[button] >= BTTN_REPEAT_MIN_MS + BTTN_REPEAT_STEP_MS){
+					BTTN_repeatInterval[button] -= BTTN_REPEAT_STEP_MS;
+				} else {
+					BTTN_repeatInterval[button] = BTTN_REPEAT_MIN_MS;
+				}
+			} else {
+				longPress |= BTTN_MASK(button);
+				BTTN_longSent |= BTTN_MASK(button);
+				BTTN_nextEvent[button] = now + BTTN_repeatInterval[button];
+			}
+		}
+	}
+
+	if(released){
+		/*BTTN_held is also written by the interruption*/
+		__disable_irq();
+		BTTN_held &= ~released;
+		__enable_irq();
+		BTTN_tracked &= ~released;
+		BTTN_longSent &= ~released;
+		BTTN_queuePush(released, BTTN_RELEASE, PIT_lifetimeRead());
+	}
+	if(longPress){
+		BTTN_queuePush(longPress, BTTN_LONG, PIT_lifetimeRead());
+	}
+	if(repeat){
+		BTTN_queuePush(repeat, BTTN_REPEAT, PIT_lifetimeRead());
+	}
+}
 
-	/*Enable the clock gating for PORTC*/
-	GPIO_clockGating(GPIOC);
+/*GPIO callback of the button pins, it receives the flags that PORTC_IRQHandler already
+ * read and cleared*/
+static void BTTN_interrupt(uint32 flags){
+	/*The pins are read only once*/
+	uint32 pins = PTC->PDIR;
+	uint64 timeStamp = PIT_lifetimeRead();
+	uint16 buttons;
+	uint8 button;
+
+	/*A button is pressed if its pin triggered the interruption and is still high*/
+	buttons = BTTN_decode(flags & pins);
+
+	/*Digital Debouncer, the edges that come too close to the last press are dropped*/
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		if(buttons & BTTN_MASK(button)){
+			if((timeStamp - BTTN_lastPress[button]) < (uint64)BTTN_DEBOUNCE_US*PIT_TICKS_PER_US){
+				buttons &= ~BTTN_MASK(button);
+			} else {
+				BTTN_lastPress[button] = timeStamp;
+			}
+		}
+	}
+	if(!buttons){
+		return;
+	}
 
-	/*Sets the configuration needed to receive an interruption when there is data available*/
-	GPIO_pinControlRegisterType pinControlRegisterPORTC = GPIO_MUX1|INTR_RISING_EDGE;
-	/*Sets PORT B pin 20, with the functionality of MUX_1  and the interruption actives with the rising edge*/
+	/*The tick follows the pressed buttons until they are released*/
+	BTTN_held |= buttons;
 
-	GPIO_pinControlRegister(GPIOC,BIT5,&pinControlRegisterPORTC); //B0
-	GPIO_pinControlRegister(GPIOC,BIT7,&pinControlRegisterPORTC); //B1
-	GPIO_pinControlRegister(GPIOC,BIT0,&pinControlRegisterPORTC);//B2
-	GPIO_pinControlRegister(GPIOC,BIT9,&pinControlRegisterPORTC);//B3
-	GPIO_pinControlRegister(GPIOC,BIT8,&pinControlRegisterPORTC);//B4
-	GPIO_pinControlRegister(GPIOC,BIT1,&pinControlRegisterPORTC);//B5
+	BTTN_queuePush(buttons, BTTN_PRESS, timeStamp);
+}
 
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT5);//B0
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT7);//B1
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT0);//B2
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT9);//B3
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT8);//B4
-	GPIO_dataDirectionPIN(GPIOC,GPIO_INPUT,BIT1);//B5
+/*Intialize the BTTN*/
+void BTTN_init(){
+	/*Pins of PORTC that have a button*/
+	uint32 pinMask = 0;
+	uint8 button;
+
+	/*The pins are configured by BOARD_init()*/
+	/*Attend the interruptions of the button pins*/
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		pinMask |= BIT_ON << BTTN_pin[button];
+	}
+	GPIO_callbackInstall(GPIOC, pinMask, BTTN_interrupt);
 
 	/*Enable interruptions*/
 	NVIC_enableInterruptAndPriority(PORTC_IRQ, PRIORITY_8);
-}
 
-void PORTC_IRQHandler(){
-	/**/
-	BTTN_MailBox.mailBoxData = GPIO_readPIN(GPIOC, BIT5) << 5| GPIO_readPIN(GPIOC, BIT7) << 4| GPIO_readPIN(GPIOC, BIT0) << 3
-			|GPIO_readPIN(GPIOC, BIT9) << 2| GPIO_readPIN(GPIOC, BIT8) << 1| GPIO_readPIN(GPIOC, BIT1) ;
-
-	BTTN_MailBox.flag = TRUE;
-	/*Double check of the interruption*/
-	/*Clear the interruption flags*/
-	GPIO_clearInterrupt(GPIOC);
-	/*Digital Debouncer*/
-	delay(100);
+	/*Start sampling the held buttons*/
+	SCHED_timerStart(&BTTN_tickTimer, BTTN_TICK_MS, BTTN_TICK_MS, BTTN_tick);
 }
 
+
 /*return the flag*/
 uint8 BTTN_mailBoxFlag(){
 
-	return BTTN_MailBox.flag;
+	return (BTTN_queueIn != BTTN_queueOut) ? TRUE : FALSE;
 }
 
-/*return the captured button*/
-uint16 BTTN_mailBoxData(){
-
-	/*clear flag*/
-	BTTN_MailBox.flag = FALSE;
-
-	/*return button*/
-	switch(BTTN_MailBox.mailBoxData){
-	case rawBUTTON_0:
-		return BUTTON_0;
+/*take the oldest event*/
+uint8 BTTN_eventRead(BTTN_EventType* event){
 
-	case rawBUTTON_1:
-		return BUTTON_1;
-
-	case rawBUTTON_2:
-		return BUTTON_2;
+	if(BTTN_queueIn == BTTN_queueOut){
+		return FALSE;
+	}
+	*event = BTTN_queue[BTTN_queueOut & (BTTN_QUEUE_SIZE - 1)];
+	BTTN_queueOut++;
+	return TRUE;
+}
 
-	case rawBUTTON_3:
-		return BUTTON_3;
+/*return the time of the oldest press*/
+uint64 BTTN_mailBoxTimeStamp(){
 
-	case rawBUTTON_4:
-		return BUTTON_4;
+	if(BTTN_queueIn == BTTN_queueOut){
+		return 0;
+	}
+	return BTTN_queue[BTTN_queueOut & (BTTN_QUEUE_SIZE - 1)].timeStamp;
+}
 
-	case rawBUTTON_5:
-		return BUTTON_5;
+/*return the captured button*/
+uint16 BTTN_mailBoxData(){
+	BTTN_EventType event;
+	uint16 button;
 
-	default:
+	if(FALSE == BTTN_eventRead(&event)){
 		return NULL_BUTTON;
 	}
 
+	/*only single presses have a button*/
+	for(button = BUTTON_0; button < BTTN_COUNT; button++){
+		if((BTTN_PRESS == event.event) && (event.buttons == BTTN_MASK(button))){
+			return button;
+		}
+	}
+	return NULL_BUTTON;
+}
+
+/*return the lost events*/
+uint16 BTTN_overflows(){
 
+	return BTTN_queueOverflows;
 }
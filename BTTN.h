@@ -10,6 +10,27 @@
 
 #include "GPIO.h"
 #include "NVIC.h"
+#include "SCHED.h"
+
+/*Edges of a button that come closer than this to the last accepted press are bouncing,
+ * in microseconds*/
+#define BTTN_DEBOUNCE_US 800
+/*Number of button events that can wait to be attended, it must be a power of 2*/
+#define BTTN_QUEUE_SIZE 8
+/*Number of buttons*/
+#define BTTN_COUNT 6
+/*Bit of a button in the button masks of BTTN_EventType*/
+#define BTTN_MASK(button) (1 << (button))
+
+/*Period of the tick that follows the held buttons, in scheduler ticks (ms)*/
+#define BTTN_TICK_MS 10
+/*Time a button must be held to give a BTTN_LONG event, in ms*/
+#define BTTN_LONG_MS 600
+/*Time between the BTTN_LONG event and the first BTTN_REPEAT, in ms*/
+#define BTTN_REPEAT_START_MS 250
+/*Every repeat comes this much sooner than the previous one, until BTTN_REPEAT_MIN_MS, in ms*/
+#define BTTN_REPEAT_STEP_MS 30
+#define BTTN_REPEAT_MIN_MS 50
 
 /*Replace BUTTON_0 with a 0, this represent the pushbutton BO for state machines*/
 #define BUTTON_0	0
@@ -26,31 +47,31 @@
 /*Replace NULL_BUTTON with a 6, this represent noise*/
 #define NULL_BUTTON 6
 
-/*rawBUTTON_0 is 32, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_0 32
-/*rawBUTTON_1 is 16, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_1 16
-/*rawBUTTON_2 is 8, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_2 8
-/*rawBUTTON_3 is 4, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_3 4
-/*rawBUTTON_4 is 2, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_4 2
-/*rawBUTTON_5 is 1, is the value that is readed from the portC when this button is pressed*/
-#define rawBUTTON_5 1
-
+/*! This enumerated constant has the kinds of button events:
+ * BTTN_PRESS the buttons were pressed (from the interruption),
+ * BTTN_RELEASE the buttons were released,
+ * BTTN_LONG the buttons have been held for BTTN_LONG_MS, it is sent once per press,
+ * BTTN_REPEAT the buttons are still held, it is sent with shorter and shorter intervals*/
+typedef enum {BTTN_PRESS, BTTN_RELEASE, BTTN_LONG, BTTN_REPEAT} BTTN_EventKindType;
 
-/*Type of data that represent a binary semaphore with two variables that represent a status flag and information*/
+/*Type of data that represents a change in the buttons*/
 typedef struct{
-	uint8 flag :1;
-	uint16 mailBoxData;
-}BTTN_MailBoxType;
+	/*one bit per button (BTTN_MASK), more than one bit is a chord*/
+	uint16 buttons;
+	/*what happened to the buttons*/
+	BTTN_EventKindType event;
+	/*lifetime timer value when the event happened*/
+	uint64 timeStamp;
+}BTTN_EventType;
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	This function configures the port C and PINs 0,1,5,7,8 and 9 as GPIO input, also
- 	 enable the interruption in the port C, set a level of priority 8 and enable the interruption
+ 	 \brief	This function attends the interruptions of the button pins of port C (configured
+ 	 by BOARD_init()), and enables the interruption of the port C with a level of priority 8.
+ 	 The presses come from the interruption; the releases, long presses and repeats come from
+ 	 a scheduler timer that samples the held buttons every BTTN_TICK_MS, so SCHED_init() must
+ 	 be called first
  	 \return void
  */
 void BTTN_init();
@@ -58,24 +79,46 @@ void BTTN_init();
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	This function return the value of the flag of struct BTTN_MailBOxType
- 	 \return This Function return 0 if the value of flag is FALSE or 1 if the value of the flag is TRUE
+ 	 \brief	This function tells if there are button events waiting to be attended
+ 	 \return This Function return 0 if there are no events or 1 if there is at least one
  */
 uint8 BTTN_mailBoxFlag();
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	This function set the value of flag in false and clean the signal received from the pushbuttons from
- 	  	  	the port C
- 	 \return This Function return 0 if the value of mailBoxdata is 32, return 1 if the value of mailBoxData is 16,
- 	 	 	 return 3 if the value of mailBoxData is 4, return 4 if the value of mailBoxData is 2, return 5 if the
- 	 	 	 value of mailBoxData is 1 or return 6 if the value of mailBoxData has a different value than ones
- 	 	 	 already mentiones
-
-
+ 	 \brief	This function takes the oldest button event
+ 	 \param[out] event - buttons, kind of event and its time
+ 	 \return TRUE if there was an event, FALSE if there were no events
+ */
+uint8 BTTN_eventRead(BTTN_EventType* event);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	This function takes the oldest button event, and returns its button
+ 	 \return BUTTON_0 to BUTTON_5, or NULL_BUTTON if there were no events, the event wasn't a
+ 	 	 	 press or more than one button was pressed (use BTTN_eventRead() to attend the
+ 	 	 	 other events and the chords)
  */
 uint16 BTTN_mailBoxData();
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	This function returns the lifetime timer value (see PIT_lifetimeRead()) of the
+ 	 	 	oldest button event. It doesn't take the event
+ 	 \return uint64 - timestamp of the button event, 0 if there are no events
+ */
+uint64 BTTN_mailBoxTimeStamp();
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	This function returns how many button events were lost because the queue was full
+ 	 \return uint16 - lost events
+ */
+uint16 BTTN_overflows();
 
 
 #endif /* SOURCES_BTTN_H_ */
@@ -0,0 +1,68 @@
+/**
+	\file
+	\brief
+		This is the source file for the alarm buzzer. The sequencer runs in the overflow
+		interruption of FTM2, it writes CnV only when the tone goes on or off.
+	\date	19/10/2026
+ */
+
+#include "BUZZ.h"
+#include "FlexTimer.h"
+
+/*Steps of each pattern, bit 0 is the first step, 1 is tone on. Indexed by BUZZ_PatternType*/
+static const uint32 BUZZ_pattern[BUZZ_PATTERNS] = {
+		0x00000000,
+		0x00000005,
+		0xFFFFFFFF
+};
+
+/*Pattern selected by the application, and the one being played by the interruption*/
+static volatile BUZZ_PatternType BUZZ_selected = BUZZ_OFF;
+static BUZZ_PatternType BUZZ_playing = BUZZ_OFF;
+/*Step being played, overflows since it started, and the tone*/
+static uint8 BUZZ_step = 0;
+static uint8 BUZZ_overflows = 0;
+static uint8 BUZZ_on = FALSE;
+
+/*Overflow of FTM2, step the pattern*/
+static void BUZZ_overflow(){
+	uint8 on;
+
+	if(BUZZ_selected != BUZZ_playing){
+		/*A new pattern, from its first step*/
+		BUZZ_playing = BUZZ_selected;
+		BUZZ_step = 0;
+		BUZZ_overflows = 0;
+	} else if(++BUZZ_overflows < BUZZ_STEP_OVERFLOWS){
+		return;
+	} else {
+		BUZZ_overflows = 0;
+		BUZZ_step = (BUZZ_step + 1 == BUZZ_STEPS) ? 0 : BUZZ_step + 1;
+	}
+
+	on = (BUZZ_pattern[BUZZ_playing] >> BUZZ_step) & 1;
+	if(on != BUZZ_on){
+		BUZZ_on = on;
+		FTM_writeChannelValue(FTM2, CHANNEL_N_0, on ? BUZZ_DUTY : 0);
+	}
+}
+
+void BUZZ_init(){
+	uint32 channelStatusAndControl = FLEX_TIMER_MSB | FLEX_TIMER_ELSB;
+
+	/*Edge aligned PWM, high true, silent (0% duty)*/
+	BUZZ_selected = BUZZ_OFF;
+	BUZZ_playing = BUZZ_OFF;
+	BUZZ_on = FALSE;
+	FTM_updateCHValue(FTM_2, CHANNEL_N_0, 0);
+	FTM_CSC(FTM_2, CHANNEL_N_0, &channelStatusAndControl);
+	FTM_overflowCallbackSet(FTM_2, BUZZ_overflow);
+}
+
+void BUZZ_set(BUZZ_PatternType pattern){
+	BUZZ_selected = pattern;
+}
+
+BUZZ_PatternType BUZZ_get(){
+	return BUZZ_selected;
+}
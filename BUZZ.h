@@ -0,0 +1,69 @@
+/**
+	\file
+	\brief
+		This is the header file for the alarm buzzer. The tone is a PWM in FTM2 channel 0
+		(PTB18), so the buzzer sounds with no CPU time. FTM2 is shared with the input
+		capture of the frequency meter, that needs it free running, so the tone is its
+		overflow frequency, SYSTEM_CLOCK/65536 (320 Hz). The cadence of the beeps is a
+		pattern, stepped by the overflow interruption of FTM2 that the capture already has:
+		each bit of the pattern is a step of BUZZ_STEP_OVERFLOWS overflows, with the tone on
+		or off. The application only selects the pattern.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_BUZZ_H_
+#define SOURCES_BUZZ_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+
+/** Overflows of FTM2 in a step of a pattern, 32 are about 100 ms */
+#define BUZZ_STEP_OVERFLOWS 32
+/** Steps of a pattern, one per bit, the pattern repeats after the last one */
+#define BUZZ_STEPS 32
+/** Duty cycle of the tone (CnV), half of the period of FTM2 */
+#define BUZZ_DUTY 0x8000
+
+/*! This enumerated constant is a pattern of beeps (see BUZZ_pattern in BUZZ.c)*/
+typedef enum {
+	/*silent*/
+	BUZZ_OFF,
+	/*two short beeps every 3.2 s*/
+	BUZZ_CHIRP,
+	/*the tone all the time*/
+	BUZZ_CONTINUOUS,
+	BUZZ_PATTERNS
+} BUZZ_PatternType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function configures FTM2 channel 0 as the PWM of the tone, silent, and
+ 	 starts the sequencer in the overflow interruption of FTM2. FTM2 must be initialized
+ 	 before (FTM_init() of the input capture), with the overflow interruption enabled
+ 	 \return void
+ */
+void BUZZ_init();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function selects the pattern of the buzzer. A new pattern starts from its
+ 	 first step with the next overflow, selecting the current one again changes nothing
+ 	 \param[in] pattern - pattern to play
+ 	 \return void
+ */
+void BUZZ_set(BUZZ_PatternType pattern);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the pattern selected
+ 	 \return BUZZ_PatternType - pattern of the buzzer
+ */
+BUZZ_PatternType BUZZ_get();
+
+#endif /* SOURCES_BUZZ_H_ */
@@ -0,0 +1,272 @@
+/**
+	\file
+	\brief
+		This is the source file for the command channel. The bytes received are kept until
+		a delimiter; then the frame is decoded in place, and the request is checked whole
+		before anything is written: the writes are merged in a copy of the settings, which
+		is applied at once.
+	\date	19/10/2026
+ */
+
+#include "CMD.h"
+#include "CRC.h"
+
+/*Functions of the serial port and the flags*/
+static const CMD_SystemType* CMD_system = 0;
+/*Bytes received since the last delimiter, a frame that doesn't fit is discarded*/
+static uint8 CMD_received[CMD_ENCODED_SIZE];
+static uint16 CMD_length = 0;
+static uint8 CMD_overflow = FALSE;
+/*Response being built, and encoded as it is sent*/
+static uint8 CMD_response[CMD_FRAME_SIZE];
+static uint8 CMD_encoded[CMD_ENCODED_SIZE];
+static uint16 CMD_encodedLength = 0;
+static uint8 CMD_pending = FALSE;
+/*A request received whole waits in CMD_received until the response is sent*/
+static uint8 CMD_waiting = FALSE;
+static CMD_StatsType CMD_statistics = {0, 0, 0};
+
+/*Bytes of the value of a field*/
+static uint8 CMD_size(uint8 field){
+	return ((CMD_TEMPERATURE == field) || (CMD_FREC == field)) ? 4 : 1;
+}
+
+/*Write a value in little endian*/
+static void CMD_put(uint16 offset, uint32 value, uint8 bytes){
+	while(bytes--){
+		CMD_response[offset++] = (uint8)value;
+		value >>= 8;
+	}
+}
+
+/*Value of a field*/
+static uint32 CMD_value(const CMD_FlagsType* flags, uint8 field){
+	switch(field){
+	case CMD_STATE:
+		return flags->state;
+	case CMD_ALARM:
+		return flags->alarm;
+	case CMD_SPEED:
+		return flags->speed;
+	case CMD_FORMAT:
+		return flags->format;
+	case CMD_PERINC:
+		return flags->perInc;
+	case CMD_MANUAL:
+		return flags->manual;
+	case CMD_TEMPERATURE:
+		return (uint32)flags->temperature;
+	default:
+		return (uint32)flags->frec;
+	}
+}
+
+/*Merge the value of a write in the settings, FALSE if the field can't be written*/
+static uint8 CMD_merge(NVS_SettingsType* settings, uint8 field, uint8 value){
+	switch(field){
+	case CMD_ALARM:
+		settings->alarm = value;
+		return TRUE;
+	case CMD_SPEED:
+		settings->speed = value;
+		return TRUE;
+	case CMD_FORMAT:
+		settings->format = value;
+		return TRUE;
+	case CMD_PERINC:
+		settings->perInc = value;
+		return TRUE;
+	case CMD_MANUAL:
+		settings->manual = value;
+		return TRUE;
+	default:
+		return FALSE;
+	}
+}
+
+/*Check every operation of a request, and merge its writes in the settings. Returns the
+ * status, operation has the operations checked (the one that is wrong) and size the size
+ * of the response*/
+static CMD_StatusType CMD_check(const uint8* request, uint16 length, NVS_SettingsType* settings,
+		uint8* writes, uint8* operation, uint16* size){
+	uint8 field;
+	uint16 index = 0;
+
+	*writes = FALSE;
+	*operation = 0;
+	*size = CMD_RESPONSE_HEADER;
+	while(index < length){
+		field = request[index] & ~CMD_WRITE;
+		if(field >= CMD_FIELDS){
+			return CMD_UNKNOWN_FIELD;
+		}
+		if(request[index++] & CMD_WRITE){
+			if(index == length){
+				return CMD_MALFORMED;
+			}
+			if(!CMD_merge(settings, field, request[index++])){
+				return CMD_READ_ONLY;
+			}
+			*writes = TRUE;
+		} else {
+			*size += 1 + CMD_size(field);
+			if(*size > CMD_FRAME_SIZE - CMD_CRC_SIZE){
+				return CMD_TOO_LONG;
+			}
+		}
+		(*operation)++;
+	}
+	return CMD_OK;
+}
+
+/*Run a request, and fill the response after its header. Returns the status, operation has
+ * the operations done or the one that is wrong, and size the size of the response*/
+static CMD_StatusType CMD_execute(const uint8* request, uint16 length, uint8* operation, uint16* size){
+	CMD_FlagsType flags;
+	NVS_SettingsType settings;
+	CMD_StatusType status;
+	uint8 writes;
+	uint8 field;
+	uint16 index;
+
+	CMD_system->read(&flags);
+	settings.alarm = flags.alarm;
+	settings.format = flags.format;
+	settings.perInc = flags.perInc;
+	settings.manual = flags.manual;
+	settings.speed = flags.speed;
+	status = CMD_check(request, length, &settings, &writes, operation, size);
+	if(CMD_OK != status){
+		*size = CMD_RESPONSE_HEADER;
+		return status;
+	}
+	if(writes){
+		if(!CMD_system->write(&settings)){
+			*size = CMD_RESPONSE_HEADER;
+			return CMD_RANGE;
+		}
+		/*The fields are read after the writes*/
+		CMD_system->read(&flags);
+	}
+
+	*size = CMD_RESPONSE_HEADER;
+	for(index = 0; index < length; index++){
+		field = request[index];
+		if(field & CMD_WRITE){
+			index++;
+			continue;
+		}
+		CMD_response[(*size)++] = field;
+		CMD_put(*size, CMD_value(&flags, field), CMD_size(field));
+		*size += CMD_size(field);
+	}
+	return CMD_OK;
+}
+
+/*A frame received, answer it if it is a valid request*/
+static void CMD_frame(uint16 length){
+	uint8 operation;
+	uint16 size;
+	uint16 crc;
+
+	length = COBS_decode(CMD_received, length, CMD_received);
+	if((COBS_INVALID == length) || (length < CMD_REQUEST_HEADER + CMD_CRC_SIZE) ||
+			(CMD_KIND_REQUEST != CMD_received[0])){
+		CMD_statistics.errors++;
+		return;
+	}
+	length -= CMD_CRC_SIZE;
+	crc = CRC_ccitt(CRC_INIT, CMD_received, length);
+	if(((uint8)crc != CMD_received[length]) || ((uint8)(crc >> 8) != CMD_received[length + 1])){
+		CMD_statistics.errors++;
+		return;
+	}
+
+	CMD_response[0] = CMD_KIND_RESPONSE;
+	CMD_response[1] = CMD_received[1];
+	CMD_response[2] = CMD_execute(&CMD_received[CMD_REQUEST_HEADER], length - CMD_REQUEST_HEADER,
+			&operation, &size);
+	CMD_response[3] = operation;
+	CMD_put(size, CRC_ccitt(CRC_INIT, CMD_response, size), CMD_CRC_SIZE);
+	CMD_encodedLength = COBS_encode(CMD_response, size + CMD_CRC_SIZE, CMD_encoded);
+	CMD_pending = TRUE;
+	CMD_statistics.requests++;
+	if(CMD_OK != CMD_response[2]){
+		CMD_statistics.rejected++;
+	}
+}
+
+void CMD_init(const CMD_SystemType* system){
+	CMD_system = system;
+	CMD_length = 0;
+	CMD_overflow = FALSE;
+	CMD_pending = FALSE;
+	CMD_waiting = FALSE;
+}
+
+/*Send the response, if there is one and the transmitter is free. Telemetry and the mirror
+ * share the transmitter, so it may be busy for a while*/
+static void CMD_send(){
+	if(CMD_pending && !CMD_system->busy()){
+		CMD_pending = !CMD_system->send(CMD_encoded, CMD_encodedLength);
+	}
+}
+
+void CMD_poll(){
+	uint8 byte;
+	uint8 count;
+	uint8 received;
+
+	if(!CMD_system){
+		return;
+	}
+	CMD_send();
+	/*A request that came while the previous response was waiting, it is answered now*/
+	if(CMD_waiting){
+		if(CMD_pending){
+			return;
+		}
+		CMD_waiting = FALSE;
+		CMD_frame(CMD_length);
+		CMD_length = 0;
+		CMD_send();
+	}
+	/*The receiver is drained even while the transmitter is busy, so its ring doesn't
+	 * overrun*/
+	for(count = 0; count < CMD_POLL_BYTES; count++){
+		received = CMD_system->receive(&byte);
+		if(!received){
+			return;
+		}
+		/*Bytes were lost, the frame being received is discarded at its delimiter*/
+		if(CMD_LOST == received){
+			CMD_overflow = TRUE;
+			continue;
+		}
+		if(COBS_DELIMITER != byte){
+			if(CMD_length < CMD_ENCODED_SIZE){
+				CMD_received[CMD_length++] = byte;
+			} else {
+				CMD_overflow = TRUE;
+			}
+			continue;
+		}
+		if(CMD_overflow){
+			CMD_statistics.errors++;
+		} else if(CMD_length && CMD_pending){
+			/*The response of the previous request is still being sent, this one waits in
+			 * CMD_received, and the next bytes wait in the ring*/
+			CMD_waiting = TRUE;
+			return;
+		} else if(CMD_length){
+			CMD_frame(CMD_length);
+			CMD_send();
+		}
+		CMD_length = 0;
+		CMD_overflow = FALSE;
+	}
+}
+
+void CMD_stats(CMD_StatsType* stats){
+	*stats = CMD_statistics;
+}
@@ -0,0 +1,169 @@
+/**
+	\file
+	\brief
+		This is the header file for the command channel, that reads and writes the
+		SystemUpdateFlags through the serial port. A request is a batch of operations, each
+		one reads or writes a field; the writes of a request are applied together, with a
+		single update of the flags, or none of them is applied if one is wrong. The
+		requests and the responses are COBS frames with a CRC, like the telemetry frames
+		(TLM.h), that share the serial port with them.
+
+		CMD_poll() takes the bytes received a few at a time and never waits, so it is
+		called periodically from the main loop. The receiver is drained on every call, also
+		while the transmitter is busy with the telemetry or the mirror. A response is sent
+		when the transmitter is free; a request that ends before that is kept until the
+		response is sent, and the bytes after it wait in the ring of the receiver.
+
+		The command channel doesn't touch the hardware nor SYSUPD directly, it uses the
+		functions of a CMD_SystemType, so it can run on a host (see tools/cmdtool.c).
+
+		Request layout (little endian), before COBS:
+		 - uint8 CMD_KIND_REQUEST
+		 - uint8 tag, it is returned in the response
+		 - the operations, one after the other: a uint8 with the field (CMD_FieldType), plus
+		   CMD_WRITE and the uint8 value to write for a write
+		 - uint16 CRC_ccitt() of the bytes above
+
+		Response layout (little endian), before COBS:
+		 - uint8 CMD_KIND_RESPONSE
+		 - uint8 tag of the request
+		 - uint8 status (CMD_StatusType)
+		 - uint8 operations done, or the operation that is wrong
+		 - if the status is CMD_OK, the fields read, in the order of the request: a uint8
+		   with the field and its value, a uint8, or a sint32 in hundredths for the
+		   temperature and the frequency. The fields are read after the writes
+		 - uint16 CRC_ccitt() of the bytes above
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_CMD_H_
+#define SOURCES_CMD_H_
+
+#include "DataTypeDefinitions.h"
+#include "COBS.h"
+#include "NVS.h"
+
+/** Kinds of frame of the command channel */
+#define CMD_KIND_REQUEST 0x10
+#define CMD_KIND_RESPONSE 0x11
+/** Bit of an operation that makes it a write */
+#define CMD_WRITE 0x80
+/** Largest request or response, before COBS, and encoded */
+#define CMD_FRAME_SIZE 64
+#define CMD_ENCODED_SIZE COBS_MAX_SIZE(CMD_FRAME_SIZE)
+/** Size of the header of a request and a response, and of the CRC */
+#define CMD_REQUEST_HEADER 2
+#define CMD_RESPONSE_HEADER 4
+#define CMD_CRC_SIZE 2
+/** Bytes taken from the receiver in a call to CMD_poll() at most */
+#define CMD_POLL_BYTES 64
+/** Returned by the receive function of CMD_SystemType when bytes were lost, no byte is
+ * taken, and the frame being received is discarded */
+#define CMD_LOST 2
+
+/*! This enumerated constant is a field of the flags, as in SystemUpdateFlags. Only the
+ * settings (alarm, speed, format, percentage and manual) can be written*/
+typedef enum {
+	CMD_STATE,
+	CMD_ALARM,
+	CMD_SPEED,
+	CMD_FORMAT,
+	CMD_PERINC,
+	CMD_MANUAL,
+	CMD_TEMPERATURE,
+	CMD_FREC,
+	CMD_FIELDS
+} CMD_FieldType;
+
+/*! This enumerated constant is the result of a request*/
+typedef enum {
+	/*done*/
+	CMD_OK,
+	/*an operation is cut, a value is missing*/
+	CMD_MALFORMED,
+	/*the field doesn't exist*/
+	CMD_UNKNOWN_FIELD,
+	/*the field can't be written*/
+	CMD_READ_ONLY,
+	/*a value is out of its range, nothing was written*/
+	CMD_RANGE,
+	/*the fields read don't fit in a response*/
+	CMD_TOO_LONG
+} CMD_StatusType;
+
+/**
+ * Struct CMD_FlagsType has the fields of the flags, as they are read
+ * **/
+typedef struct{
+	uint8 state;
+	uint8 alarm;
+	uint8 speed;
+	uint8 format;
+	uint8 perInc;
+	uint8 manual;
+	/*hundredths of Celsius degree*/
+	sint32 temperature;
+	/*hundredths of Hz*/
+	sint32 frec;
+}CMD_FlagsType;
+
+/**
+ * Struct CMD_SystemType has the functions that the command channel uses
+ * **/
+typedef struct{
+	/*takes a byte received, FALSE if there is none, CMD_LOST if bytes were lost*/
+	uint8 (*receive)(uint8* byte);
+	/*starts sending bytes, FALSE if the previous ones are still being sent*/
+	uint8 (*send)(const uint8* data, uint16 length);
+	/*tells if bytes are still being sent*/
+	uint8 (*busy)();
+	/*a consistent copy of the flags*/
+	void (*read)(CMD_FlagsType* flags);
+	/*applies the settings with a single update, FALSE if one is out of range*/
+	uint8 (*write)(const NVS_SettingsType* settings);
+}CMD_SystemType;
+
+/**
+ * Struct CMD_StatsType tells how the command channel is doing
+ * **/
+typedef struct{
+	/*requests answered*/
+	uint32 requests;
+	/*requests that were answered with an error*/
+	uint32 rejected;
+	/*frames received with a bad COBS block, size, kind or CRC*/
+	uint32 errors;
+}CMD_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts the command channel
+ 	 \param[in] system - functions of the serial port and the flags
+ 	 \return void
+ */
+void CMD_init(const CMD_SystemType* system);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function sends the pending response when the transmitter is free, and
+ 	 takes up to CMD_POLL_BYTES bytes received, answering the request that they end.
+ 	 It must be called periodically, from the main loop (for example, a scheduler timer)
+ 	 \return void
+ */
+void CMD_poll();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the statistics of the command channel
+ 	 \param[out] stats - requests and errors
+ 	 \return void
+ */
+void CMD_stats(CMD_StatsType* stats);
+
+#endif /* SOURCES_CMD_H_ */
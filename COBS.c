@@ -0,0 +1,63 @@
+/**
+	\file
+	\brief
+		This is the source file for the COBS framing. The encoder leaves a hole for the code
+		of each block and fills it when the block ends, in a single pass.
+	\date	19/10/2026
+ */
+
+#include "COBS.h"
+
+/*Code of the longest block, 254 bytes that are not zero and no zero after them*/
+#define COBS_FULL_BLOCK 0xFF
+
+uint16 COBS_encode(const uint8* data, uint16 length, uint8* frame){
+	uint16 codeIndex = 0;
+	uint16 size = 1;
+	uint8 code = 1;
+
+	while(length--){
+		if(COBS_DELIMITER == *data){
+			/*The zero ends the block*/
+			frame[codeIndex] = code;
+			codeIndex = size++;
+			code = 1;
+		} else {
+			frame[size++] = *data;
+			if(COBS_FULL_BLOCK == ++code){
+				frame[codeIndex] = code;
+				codeIndex = size++;
+				code = 1;
+			}
+		}
+		data++;
+	}
+	frame[codeIndex] = code;
+	frame[size++] = COBS_DELIMITER;
+	return size;
+}
+
+uint16 COBS_decode(const uint8* frame, uint16 length, uint8* data){
+	uint16 index = 0;
+	uint16 size = 0;
+	uint8 code;
+	uint8 count;
+
+	while(index < length){
+		code = frame[index++];
+		if(COBS_DELIMITER == code){
+			return COBS_INVALID;
+		}
+		for(count = 1; count < code; count++){
+			if((index == length) || (COBS_DELIMITER == frame[index])){
+				return COBS_INVALID;
+			}
+			data[size++] = frame[index++];
+		}
+		/*A short block had a zero after it, except the last one*/
+		if((COBS_FULL_BLOCK != code) && (index < length)){
+			data[size++] = 0;
+		}
+	}
+	return size;
+}
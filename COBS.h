@@ -0,0 +1,50 @@
+/**
+	\file
+	\brief
+		This is the header file for the COBS (Consistent Overhead Byte Stuffing) framing.
+		The encoding removes every 0x00 from a frame, so a 0x00 can end it: a receiver that
+		loses bytes finds the start of the next frame at the next 0x00. A block of up to 254
+		bytes that are not zero is sent after a code byte with its length plus one; the
+		overhead is one byte every 254, plus the delimiter.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_COBS_H_
+#define SOURCES_COBS_H_
+
+#include "DataTypeDefinitions.h"
+
+/** Delimiter that ends each encoded frame */
+#define COBS_DELIMITER 0x00
+/** Largest encoded size of length bytes, with the delimiter */
+#define COBS_MAX_SIZE(length) ((length) + (length) / 254 + 2)
+/** Result of COBS_decode() when the frame is not valid */
+#define COBS_INVALID 0xFFFF
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function encodes bytes in a frame, ended by COBS_DELIMITER
+ 	 \param[in] data - bytes to encode
+ 	 \param[in] length - number of bytes
+ 	 \param[out] frame - encoded frame, COBS_MAX_SIZE(length) bytes at least
+ 	 \return uint16 - size of the frame, with the delimiter
+ */
+uint16 COBS_encode(const uint8* data, uint16 length, uint8* frame);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function decodes a frame, without its delimiter. The bytes decoded are
+ 	 never more than the bytes of the frame, so data may be the frame itself
+ 	 \param[in] frame - encoded frame, without the delimiter
+ 	 \param[in] length - size of the frame
+ 	 \param[out] data - bytes decoded
+ 	 \return uint16 - number of bytes decoded, COBS_INVALID if the frame has a zero or a
+ 	 block is cut
+ */
+uint16 COBS_decode(const uint8* frame, uint16 length, uint8* data);
+
+#endif /* SOURCES_COBS_H_ */
@@ -0,0 +1,23 @@
+/**
+	\file
+	\brief
+		This is the source file for the CRC.
+	\date	19/10/2026
+ */
+
+#include "CRC.h"
+
+/*CRC of each nibble, shifted to the top of the register*/
+static const uint16 CRC_nibble[16] = {
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+uint16 CRC_ccitt(uint16 crc, const uint8* data, uint16 length){
+	while(length--){
+		crc = (uint16)((crc << 4) ^ CRC_nibble[(crc >> 12) ^ (*data >> 4)]);
+		crc = (uint16)((crc << 4) ^ CRC_nibble[(crc >> 12) ^ (*data & 0x0F)]);
+		data++;
+	}
+	return crc;
+}
@@ -0,0 +1,31 @@
+/**
+	\file
+	\brief
+		This is the header file for the CRC. It has the CRC-16/CCITT-FALSE (polynomial
+		0x1021, initial value 0xFFFF, no reflection), computed a nibble at a time with a
+		table of 16 entries, so it needs neither a 512 byte table nor a loop per bit.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_CRC_H_
+#define SOURCES_CRC_H_
+
+#include "DataTypeDefinitions.h"
+
+/** Initial value of the CRC */
+#define CRC_INIT 0xFFFF
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function adds bytes to a CRC. To compute it in parts, the result of a part
+ 	 is the crc of the next one
+ 	 \param[in] crc - CRC of the previous bytes, CRC_INIT for the first ones
+ 	 \param[in] data - bytes to add
+ 	 \param[in] length - number of bytes
+ 	 \return uint16 - CRC with the bytes added
+ */
+uint16 CRC_ccitt(uint16 crc, const uint8* data, uint16 length);
+
+#endif /* SOURCES_CRC_H_ */
@@ -0,0 +1,75 @@
+/**
+	\file
+	\brief
+		This is the source file for the delay service. Every wait is converted to lifetime
+		timer ticks with integer math, and ends when that many ticks have elapsed, no
+		matter what woke the core in the meantime.
+	\date	19/10/2026
+ */
+
+#include "MK64F12.h"
+#include "DELAY.h"
+#include "NVIC.h"
+
+/*Set by the DELAY_PIT interruption when the one-shot expires*/
+static volatile uint8 DELAY_expired = FALSE;
+
+/*DELAY_PIT callback, the channel is stopped so it works as a one-shot*/
+static void DELAY_wakeUp(){
+	PIT_timerDisable(DELAY_PIT);
+	DELAY_expired = TRUE;
+}
+
+/*Wait up to DELAY_MAX_TICKS ticks*/
+static void DELAY_ticks(uint32 ticks){
+	uint32 start = PIT_lifetimeRead32();
+
+	/*Sleeping is only possible in thread mode with the interruptions enabled, otherwise
+	 * the PIT interruption would never wake the core*/
+	if((ticks >= DELAY_SLEEP_THRESHOLD_US*PIT_TICKS_PER_US) && !__get_IPSR() && !__get_PRIMASK()){
+		DELAY_expired = FALSE;
+		PIT_timerDisable(DELAY_PIT);
+		PIT_loadCycles(DELAY_PIT, ticks);
+		PIT_timerEnable(DELAY_PIT);
+		/*The flag is checked with the interruptions masked, so the PIT can't expire between
+		 * the check and the WFI. A pending interruption still wakes the core, and it is
+		 * attended as soon as they are unmasked. Other interruptions also wake the core,
+		 * go back to sleep until the PIT expires*/
+		__disable_irq();
+		while(!DELAY_expired){
+			__WFI();
+			__enable_irq();
+			__disable_irq();
+		}
+		__enable_irq();
+	}
+
+	/*The lower 32 bits are enough, the wait is shorter than their wrap*/
+	while((PIT_lifetimeRead32() - start) < ticks){
+	}
+}
+
+void DELAY_init(){
+	PIT_clockGating();
+	PIT_enable();
+	PIT_callbackInstall(DELAY_PIT, DELAY_wakeUp);
+	PIT_timerInterruptEnable(DELAY_PIT);
+	NVIC_enableInterruptAndPriority(PIT_CH3_IRQ, PRIORITY_5);
+}
+
+void DELAY_us(uint32 micros){
+	/*Split the waits that don't fit in a single step*/
+	while(micros > DELAY_MAX_TICKS / PIT_TICKS_PER_US){
+		DELAY_ticks((DELAY_MAX_TICKS / PIT_TICKS_PER_US) * PIT_TICKS_PER_US);
+		micros -= DELAY_MAX_TICKS / PIT_TICKS_PER_US;
+	}
+	DELAY_ticks(micros * PIT_TICKS_PER_US);
+}
+
+void DELAY_ms(uint32 millis){
+	while(millis > 1000){
+		DELAY_us(1000UL * 1000);
+		millis -= 1000;
+	}
+	DELAY_us(millis * 1000);
+}
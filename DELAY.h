@@ -0,0 +1,54 @@
+/**
+	\file
+	\brief
+		This is the header file for the delay service. The waits are measured with the
+		lifetime timer (see PIT_lifetimeInit()), so their length doesn't depend on the
+		compiler optimization level. Short waits poll the lifetime timer, long waits
+		arm PIT channel 3 as a one-shot and sleep the core with WFI until it expires.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_DELAY_H_
+#define SOURCES_DELAY_H_
+
+#include "DataTypeDefinitions.h"
+#include "PIT.h"
+
+/** PIT channel used to wake the core at the end of a long wait */
+#define DELAY_PIT PIT_3
+/** Waits shorter than this (in microseconds) are polled, sleeping would cost more than
+ * the wait itself */
+#define DELAY_SLEEP_THRESHOLD_US 50
+/** Longest wait (in ticks) done in a single step, longer waits are split */
+#define DELAY_MAX_TICKS 0x7FFFFFFFUL
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function configures DELAY_PIT and its interruption. PIT_lifetimeInit() has
+ 	 to be called before.
+ 	 \return void
+ */
+void DELAY_init();
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function waits the given number of microseconds. From an interruption, or
+ 	 with interruptions masked, the wait is always polled.
+ 	 \param[in] micros - microseconds to wait
+ 	 \return void
+ */
+void DELAY_us(uint32 micros);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function waits the given number of milliseconds, see DELAY_us()
+ 	 \param[in] millis - milliseconds to wait
+ 	 \return void
+ */
+void DELAY_ms(uint32 millis);
+
+#endif /* SOURCES_DELAY_H_ */
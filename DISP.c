@@ -35,167 +35,332 @@
 #include "DISP.h"
 #include "SPI.h"
 #include "LCDNokia5110.h"
+#include "PIT.h"
+#include "SCHED.h"
+#include "GRAPH.h"
 #include "stdio.h"
 
-/*Struct array, that contains a function pointer according to the
- * current State, indicating what will be printed in the LCD*/
-StateDisplay stateDisplay[7] = {
-		{DEFAULT_DISP, defaultMenu},
-		{MENU_DISP, mainMenu},
-		{ALARM_DISP, alarmMenu},
-		{FORMAT_TEMP_DISP, temperatureMenu},
-		{PERCEN_DEC_DISP, percentageMenu},
-		{CTRL_MANUAL_DISP, motorControlMenu},
-		{FREC_DISP, frequencyMenu}
+/*Event to LCD latency statistics*/
+static DISP_LatencyType DISP_latencyStats = {0, 0, 0};
+
+/*Length of the text drawn by each chain of elements of the current screen, indexed by the
+ * element that starts the chain*/
+static uint8 DISP_chainLength[DISP_MAX_ELEMENTS];
+/*Screen on the LCD*/
+static MenuStateType DISP_shownState = DEFAULT_DISP;
+
+/*Layout of the default screen: motor speed and temperature*/
+static const DISP_ElementType DISP_defaultLayout[] = {
+		{DISP_TEXT, 10, 0, 0, {"Velocidad", 0}},
+		{DISP_FIELD, 31, 1, SDF_SPEED_DIRTY, {0, 0}},
+		{DISP_TEXT, 4, 2, 0, {"Temperatura", 0}},
+		{DISP_FIELD, 14, 3, SDF_TEMPERATURE_DIRTY, {0, 0}}
+};
+
+/*Layout of the main menu*/
+static const DISP_ElementType DISP_mainLayout[] = {
+		{DISP_TEXT, 0, 0, 0, {"1)Alarma", 0}},
+		{DISP_TEXT, 0, 1, 0, {"2)Formato temp", 0}},
+		{DISP_TEXT, 0, 2, 0, {"3)% de inc", 0}},
+		{DISP_TEXT, 0, 3, 0, {"4)Ctrl manual", 0}},
+		{DISP_TEXT, 0, 4, 0, {"5)Frecuencia", 0}},
+		{DISP_TEXT, 0, 5, 0, {"5 largo)Graf", 0}}
+};
+
+/*Layout of the alarm menu*/
+static const DISP_ElementType DISP_alarmLayout[] = {
+		{DISP_TEXT, 24, 1, 0, {"Alarm", 0}},
+		{DISP_FIELD, 28, 2, SDF_ALARM_DIRTY, {0, 0}},
+		{DISP_TEXT, 7, 3, 0, {"(-)B1(+)B2", 0}},
+		{DISP_TEXT, 21, 4, 0, {"(OK)B3", 0}}
+};
+
+/*Layout of the temperature format menu*/
+static const DISP_ElementType DISP_temperatureLayout[] = {
+		{DISP_TEXT, 3, 1, 0, {"Temp Format", 0}},
+		{DISP_TEXT, 0, 2, 0, {"Temp=", 0}},
+		{DISP_FIELD, DISP_NEXT, 0, SDF_TEMPERATURE_DIRTY, {0, 0}},
+		{DISP_TEXT, 7, 3, 0, {"(C)B1(F)B2", 0}},
+		{DISP_TEXT, 21, 4, 0, {"(OK)B3", 0}}
+};
+
+/*Layout of the percentage menu*/
+static const DISP_ElementType DISP_percentageLayout[] = {
+		{DISP_TEXT, 7, 1, 0, {"% de decre", 0}},
+		{DISP_TEXT, 28, 2, 0, {"%", 0}},
+		{DISP_FIELD, DISP_NEXT, 0, SDF_PERINC_DIRTY, {0, 0}},
+		{DISP_TEXT, 7, 3, 0, {"(-)B1(+)B2", 0}},
+		{DISP_TEXT, 21, 4, 0, {"(OK)B3", 0}}
+};
+
+/*Layout of the motor control menu*/
+static const DISP_ElementType DISP_motorControlLayout[] = {
+		{DISP_CHOICE, 3, 0, SDF_MANUAL_DIRTY, {"Ctrl autom", "Ctrl manual"}},
+		{DISP_TEXT, 30, 1, 0, {"%", 0}},
+		{DISP_FIELD, DISP_NEXT, 0, SDF_SPEED_DIRTY, {0, 0}},
+		{DISP_TEXT, 0, 2, 0, {"ON)B1 OFF)B2", 0}},
+		{DISP_TEXT, 21, 3, 0, {"(OK)B3", 0}},
+		{DISP_TEXT, 7, 4, 0, {"(-)B4(+)B5", 0}}
+};
+
+/*Layout of the frequency menu*/
+static const DISP_ElementType DISP_frequencyLayout[] = {
+		{DISP_TEXT, 7, 1, 0, {"Frecuencia", 0}},
+		{DISP_TEXT, 28, 2, 0, {"(Hz)", 0}},
+		{DISP_FIELD, 0, 3, SDF_FREC_DIRTY, {0, 0}}
+};
+
+/*Layout of the trend graph*/
+static const DISP_ElementType DISP_graphLayout[] = {
+		{DISP_GRAPH, 0, 0, 0, {0, 0}}
+};
+
+/*Struct array, that contains the layout according to the current State, indicating what
+ * will be printed in the LCD*/
+static const StateDisplay stateDisplay[8] = {
+		{DEFAULT_DISP, DISP_defaultLayout, DISP_ELEMENTS(DISP_defaultLayout)},
+		{MENU_DISP, DISP_mainLayout, DISP_ELEMENTS(DISP_mainLayout)},
+		{ALARM_DISP, DISP_alarmLayout, DISP_ELEMENTS(DISP_alarmLayout)},
+		{FORMAT_TEMP_DISP, DISP_temperatureLayout, DISP_ELEMENTS(DISP_temperatureLayout)},
+		{PERCEN_DEC_DISP, DISP_percentageLayout, DISP_ELEMENTS(DISP_percentageLayout)},
+		{CTRL_MANUAL_DISP, DISP_motorControlLayout, DISP_ELEMENTS(DISP_motorControlLayout)},
+		{FREC_DISP, DISP_frequencyLayout, DISP_ELEMENTS(DISP_frequencyLayout)},
+		{GRAPH_DISP, DISP_graphLayout, DISP_ELEMENTS(DISP_graphLayout)}
 };
 
-/*Print in the LCD the alarm menu, that takes in count the values in SDF*/
-void alarmMenu(SystemDisplayFlags* SDF){
-	//Clear screen
-	LCDNokia_clear();
-	//Write alarm
-	LCDNokia_gotoXY(24,1);
-	LCDNokia_sendString("Alarm");
-	//Write alarm threshold
-	LCDNokia_gotoXY(28,2);
-	LCDNokia_sendString( SDF->currentAlarm);
-	//Write 'C or 'F
-	if(SDF->currentFormat == CELSIUS){
-	LCDNokia_sendString("'C");
-	} else {
-	LCDNokia_sendString("'F");
-	}
-	//Write the option buttons
-	LCDNokia_gotoXY(7,3);
-	LCDNokia_sendString("(-)B1(+)B2");
-	LCDNokia_gotoXY(21,4);
-	LCDNokia_sendString("(OK)B3");
+/*Formats of the numeric fields of SDF, the temperatures have one per format (CELSIUS,
+ * FAHRENHEIT)*/
+static const LCD_NumberFormatType DISP_temperatureFormat[2] = {{5, 2, "'C"}, {5, 2, "'F"}};
+static const LCD_NumberFormatType DISP_alarmFormat[2] = {{3, 0, "'C"}, {3, 0, "'F"}};
+static const LCD_NumberFormatType DISP_percentageFormat = {3, 0, 0};
+static const LCD_NumberFormatType DISP_frecFormat = {9, 2, 0};
+
+/*Draw the number of SDF that a DISP_FIELD element shows, returns its length*/
+static uint8 DISP_sendField(const SystemDisplayFlags* SDF, uint8 field){
+	switch(field){
+	case SDF_ALARM_DIRTY:
+		return LCDNokia_sendNumber(SDF->currentAlarm, &DISP_alarmFormat[SDF->currentFormat]);
+	case SDF_SPEED_DIRTY:
+		return LCDNokia_sendNumber(SDF->currentSpeed, &DISP_percentageFormat);
+	case SDF_PERINC_DIRTY:
+		return LCDNokia_sendNumber(SDF->currentPerInc, &DISP_percentageFormat);
+	case SDF_TEMPERATURE_DIRTY:
+		return LCDNokia_sendNumber(SDF->currentTemperature, &DISP_temperatureFormat[SDF->currentFormat]);
+	case SDF_FREC_DIRTY:
+		return LCDNokia_sendNumber((sint32)SDF->currentFrec, &DISP_frecFormat);
+	default:
+		return 0;
+	}
 }
 
-/*Print in the LCD the temperature menu, that takes in count the values in SDF*/
-void temperatureMenu(SystemDisplayFlags* SDF){
-	//Clear LCD
-	LCDNokia_clear();
-	//Write the temp format
-	LCDNokia_gotoXY(3,1);
-	LCDNokia_sendString("Temp Format");
-	//Write the temperature
-	LCDNokia_gotoXY(0,2);
-	LCDNokia_sendString("Temp=");
-	LCDNokia_sendString(SDF->currentTemperature);
-	//Write 'C or 'F
-	if(SDF->currentFormat == CELSIUS){
-	LCDNokia_sendString("'C");
-	} else {
-	LCDNokia_sendString("'F");
-	}
-	//Write the option buttons
-	LCDNokia_gotoXY(7,3);
-	LCDNokia_sendString("(C)B1(F)B2");
-	LCDNokia_gotoXY(21,4);
-	LCDNokia_sendString("(OK)B3");
+/*Return the value of SDF that chooses the text of a DISP_CHOICE element*/
+static uint8 DISP_fieldValue(const SystemDisplayFlags* SDF, uint8 field){
+	switch(field){
+	case SDF_FORMAT_DIRTY:
+		return SDF->currentFormat;
+	case SDF_MANUAL_DIRTY:
+		return SDF->currentManual;
+	default:
+		return 0;
+	}
 }
 
-/*Print in the LCD the percentage menu, that takes in count the values in SDF*/
-void percentageMenu(SystemDisplayFlags* SDF){
-	//Clear the screen
-	LCDNokia_clear();
-	//Write % de decre
-	LCDNokia_gotoXY(7,1);
-	LCDNokia_sendString( "% de decre");
-	//Write percentage of decrement
-	LCDNokia_gotoXY(28,2);
-	LCDNokia_sendString( "%");
-	LCDNokia_sendString(SDF->currentPerInc);
-	LCDNokia_gotoXY(7,3);
-	//Write the option buttons
-	LCDNokia_sendString("(-)B1(+)B2");
-	LCDNokia_gotoXY(21,4);
-	LCDNokia_sendString("(OK)B3");
+/*Return the text that a DISP_TEXT or DISP_CHOICE element shows*/
+static const char* DISP_elementText(const DISP_ElementType* element, const SystemDisplayFlags* SDF){
+	if(DISP_CHOICE == element->kind){
+		return element->text[DISP_fieldValue(SDF, element->field) ? 1 : 0];
+	}
+	return element->text[0];
 }
 
-/*Print in the LCD the motor control menu, that takes in count the values in SDF*/
-void motorControlMenu(SystemDisplayFlags* SDF){
-	//Clear LCD
-	LCDNokia_clear();
-	LCDNokia_gotoXY(3,0);
-	//Write autom or manual
-	if(SDF->currentManual == MANUAL){
-		LCDNokia_sendString("Ctrl manual");
-	} else {
-		LCDNokia_sendString("Ctrl autom");
-	}
-	//Write current speed percentage
-	LCDNokia_gotoXY(30,1);
-	LCDNokia_sendString("%");
-	LCDNokia_sendString(SDF->currentSpeed);
-	LCDNokia_gotoXY(0,2);
-	//Write option buttons
-	LCDNokia_sendString("ON)B1 OFF)B2");
-	LCDNokia_gotoXY(21,3);
-	LCDNokia_sendString("(OK)B3");
-	LCDNokia_gotoXY(7,4);
-	LCDNokia_sendString("(-)B4(+)B5");
+/*Write a text where the LCD cursor is, returns its length*/
+static uint8 DISP_send(const char* text){
+	uint8 length = 0;
+
+	while(text[length]){
+		LCDNokia_sendChar(text[length]);
+		length++;
+	}
+	return length;
 }
 
-/*Print in the LCD the frequency menu, that takes in count the values in SDF*/
-void frequencyMenu(SystemDisplayFlags* SDF){
-	//Clear LCD
-	LCDNokia_clear();
-	//Write the current frequency
-	LCDNokia_gotoXY(7,1);
-	LCDNokia_sendString("Frecuencia");
-	LCDNokia_gotoXY(28,2);
-	LCDNokia_sendString("(Hz)");
-	LCDNokia_gotoXY(0,3);
-	LCDNokia_sendString(SDF->currentFrec);
+/*Fields of SDF that a screen shows*/
+static uint8 DISP_fields(MenuStateType state){
+	uint8 fields = 0;
+	uint8 index;
+
+	for(index = 0; index < stateDisplay[state].count; index++){
+		fields |= stateDisplay[state].layout[index].field;
+	}
+	return fields;
 }
 
-/*Print in the LCD the default menu, that takes in count the values in SDF*/
-void defaultMenu(SystemDisplayFlags* SDF){
-	//Clear LCD
-	LCDNokia_clear();
-	//Write the motor speed
-	LCDNokia_gotoXY(10,0);
-	LCDNokia_sendString("Velocidad");
-	LCDNokia_gotoXY(31,1);
-	LCDNokia_sendString(SDF->currentSpeed);
-	//Write the current temperature
-	LCDNokia_gotoXY(4,2);
-	LCDNokia_sendString("Temperatura");
-	LCDNokia_gotoXY(14,3);
-	LCDNokia_sendString(SDF->currentTemperature);
-	//Write 'C or 'F
-	if(SDF->currentFormat == CELSIUS){
-	LCDNokia_sendString("'C");
-	} else {
-	LCDNokia_sendString("'F");
+/*Draw the layout of a screen. With full, the LCD is cleared and every element is drawn,
+ * otherwise only the chains that have a dirty field are drawn again, over the previous
+ * frame*/
+static void DISP_renderLayout(const StateDisplay* screen, const SystemDisplayFlags* SDF, uint8 dirty, uint8 full){
+	uint8 start = 0;
+	uint8 end;
+	uint8 index;
+	uint8 chainDirty;
+	uint8 length;
+
+	if(full){
+		LCDNokia_clear();
 	}
+	/*A chain is an element with a position followed by the DISP_NEXT elements, they are
+	 * drawn together because the position of each one depends on the previous*/
+	while(start < screen->count){
+		chainDirty = full;
+		for(end = start; end < screen->count && (end == start || DISP_NEXT == screen->layout[end].x); end++){
+			chainDirty |= (screen->layout[end].field & dirty) ? TRUE : FALSE;
+		}
+		if(chainDirty){
+			length = 0;
+			LCDNokia_gotoXY(screen->layout[start].x, screen->layout[start].y);
+			for(index = start; index < end; index++){
+				if(DISP_FIELD == screen->layout[index].kind){
+					length += DISP_sendField(SDF, screen->layout[index].field);
+				} else if(DISP_GRAPH == screen->layout[index].kind){
+					GRAPH_draw();
+				} else {
+					length += DISP_send(DISP_elementText(&screen->layout[index], SDF));
+				}
+			}
+			/*Erase what is left of the previous frame*/
+			for(index = length; !full && index < DISP_chainLength[start]; index++){
+				LCDNokia_sendChar(' ');
+			}
+			DISP_chainLength[start] = length;
+		}
+		start = end;
+	}
+}
 
+/*update the Display, according to the SDF current State*/
+void update_Display(SystemDisplayFlags* SDF, uint8 dirty){
+	/*Nothing that this menu shows has changed*/
+	if(!(dirty & (SDF_STATE_DIRTY | DISP_fields(SDF->currentState)))){
+		return;
+	}
+	/*Draw the layout of the current state, the whole screen only if the state changed*/
+	DISP_renderLayout(&stateDisplay[SDF->currentState], SDF, dirty, (dirty & SDF_STATE_DIRTY) ? TRUE : FALSE);
+	DISP_shownState = SDF->currentState;
+	/*Send to the LCD only what changed in the frame*/
+	LCDNokia_flush();
 }
 
-/*Print in the LCD the main menu*/
-void mainMenu(SystemDisplayFlags* SDF){
-	//Clear LCD
-	LCDNokia_clear();
-	//Write the menu options
-	LCDNokia_gotoXY(0,0);
-	LCDNokia_sendString("1)Alarma");
-	LCDNokia_gotoXY(0,1);
-	LCDNokia_sendString("2)Formato temp");
-	LCDNokia_gotoXY(0,2);
-	LCDNokia_sendString("3)% de inc");
-	LCDNokia_gotoXY(0,3);
-	LCDNokia_sendString("4)Ctrl manual");
-	LCDNokia_gotoXY(0,4);
-	LCDNokia_sendString("5)Frecuencia");
+/*Timer of the display refresh*/
+static SCHED_TimerType DISP_refreshTimer;
+/*There is a request waiting for the refresh, and the time of its first event*/
+static uint8 DISP_pending = FALSE;
+static uint64 DISP_pendingTimeStamp = 0;
+/*Dirty fields that haven't been drawn yet*/
+static uint8 DISP_dirty = 0;
+/*Temperature (in the degrees of its format) and frequency on the screen, for the deadbands*/
+static float DISP_shownTemperature = 0;
+static uint8 DISP_shownFormat = CELSIUS;
+static float DISP_shownFrec = 0;
+/*Redraws saved*/
+static uint32 DISP_suppressedCount = 0;
+
+/*Tells if value moved more than deadband from shown*/
+static uint8 DISP_beyondDeadband(float value, float shown, float deadband){
+	return ((value - shown) > deadband || (shown - value) > deadband) ? TRUE : FALSE;
 }
 
-/*update the Display, according to the SDF current State*/
-void update_Display(SystemDisplayFlags* SDF){
-	/*Call the function that the function pointer ponits, accdoring to the current
-	 * state*/
-	stateDisplay[SDF->currentState].StateDisplay(SDF);
+/*Draw the pending changes, unless they are within the deadbands*/
+static void DISP_render(){
+	SystemDisplayFlags displayFlags;
+	SystemUpdateFlags workingFlags;
+	float temperature;
+	uint8 dirty;
+
+	DISP_dirty |= SYSUPD_SDFsnapshot(&displayFlags);
+	SYSUPD_SUFsnapshot(&workingFlags);
+	DISP_pending = FALSE;
+
+	/*Small moves of the temperature and frequency are not worth a redraw. The temperature
+	 * is compared as it is shown, so the deadband is in degrees of the format shown*/
+	dirty = DISP_dirty;
+	temperature = displayFlags.currentTemperature / 100.0f;
+	if((displayFlags.currentFormat == DISP_shownFormat) &&
+			!DISP_beyondDeadband(temperature, DISP_shownTemperature, DISP_TEMPERATURE_DEADBAND)){
+		dirty &= ~SDF_TEMPERATURE_DIRTY;
+	}
+	if(!DISP_beyondDeadband(workingFlags.currentFrec, DISP_shownFrec, DISP_FREC_DEADBAND)){
+		dirty &= ~SDF_FREC_DIRTY;
+	}
+	/*The dirty fields within the deadband wait, they are drawn with the next redraw*/
+	if(!(dirty & (SDF_STATE_DIRTY | DISP_fields(displayFlags.currentState)))){
+		DISP_suppressedCount++;
+		return;
+	}
+
+	update_Display(&displayFlags, dirty);
+	DISP_latencyRecord(DISP_pendingTimeStamp);
+
+	/*A new screen is drawn whole, otherwise only the dirty fields were drawn*/
+	if(dirty & SDF_STATE_DIRTY){
+		dirty = SDF_ALL_DIRTY;
+	}
+	DISP_dirty &= ~dirty;
+	if(dirty & SDF_TEMPERATURE_DIRTY){
+		DISP_shownTemperature = temperature;
+		DISP_shownFormat = displayFlags.currentFormat;
+	}
+	if(dirty & SDF_FREC_DIRTY){
+		DISP_shownFrec = workingFlags.currentFrec;
+	}
 }
 
+/*Scheduler callback of the display refresh*/
+static void DISP_refresh(){
+	if(DISP_pending){
+		DISP_render();
+	}
+	/*The graph scrolls when the history has new samples*/
+	if((GRAPH_DISP == DISP_shownState) && GRAPH_update()){
+		LCDNokia_flush();
+	}
+}
+
+/*Start the display refresh*/
+void DISP_init(){
+	SCHED_timerStart(&DISP_refreshTimer, DISP_REFRESH_MS, DISP_REFRESH_MS, DISP_refresh);
+}
+
+/*Ask for a redraw, now or with the next refresh*/
+void DISP_request(uint64 eventTimeStamp, uint8 immediate){
+	if(!DISP_pending){
+		DISP_pending = TRUE;
+		DISP_pendingTimeStamp = eventTimeStamp;
+	} else if(!immediate){
+		/*It will be drawn with the request that is already waiting*/
+		DISP_suppressedCount++;
+	}
+	if(immediate){
+		DISP_render();
+	}
+}
 
+/*Return the redraws saved*/
+uint32 DISP_suppressed(){
+	return DISP_suppressedCount;
+}
+
+/*Record the time from the event to the end of the LCD update*/
+void DISP_latencyRecord(uint64 eventTimeStamp){
+	uint32 latency = (uint32)PIT_ticksToMicros(PIT_lifetimeElapsed(eventTimeStamp));
+
+	DISP_latencyStats.last = latency;
+	if(latency > DISP_latencyStats.max){
+		DISP_latencyStats.max = latency;
+	}
+	DISP_latencyStats.count++;
+}
+
+/*Return the latency statistics*/
+const DISP_LatencyType* DISP_latency(){
+	return &DISP_latencyStats;
+}
@@ -11,6 +11,56 @@
 #include "DataTypeDefinitions.h"
 #include "GlobalFunctions.h"
 #include "SYSUPD.h"
+#include "SCHED.h"
+
+/** Period of the display refresh, in scheduler ticks (ms). The updates requested by the
+ * samples are coalesced and drawn at most once per period (10 Hz) */
+#define DISP_REFRESH_MS 100
+/** The temperature is drawn again only if it moved more than this from the value on the
+ * screen, in degrees of the format shown (Celsius or Fahrenheit) */
+#define DISP_TEMPERATURE_DEADBAND 0.2
+/** The frequency is drawn again only if it moved more than this from the value on the
+ * screen, in Hz */
+#define DISP_FREC_DEADBAND 1.0
+
+/** Value of DISP_ElementType.x of an element that goes right after the previous one */
+#define DISP_NEXT 0xFF
+/** Maximum number of elements in a layout */
+#define DISP_MAX_ELEMENTS 8
+/** Number of elements of a layout array */
+#define DISP_ELEMENTS(layout) (sizeof(layout)/sizeof(DISP_ElementType))
+
+/*! This enumerated constant is the kind of an element of a screen layout*/
+typedef enum{
+	/*fixed text, text[0]*/
+	DISP_TEXT,
+	/*the number of SDF selected by field, drawn with its format (see DISP.c) straight from
+	 * the font*/
+	DISP_FIELD,
+	/*text[0] if the value of SDF selected by field is 0 (CELSIUS, AUTOMATIC), otherwise
+	 * text[1]*/
+	DISP_CHOICE,
+	/*the trend graph of GRAPH.h, over the whole LCD, x and y are ignored. It follows the
+	 * history by itself, with the display refresh*/
+	DISP_GRAPH
+}DISP_ElementKindType;
+
+/**
+ * Struct DISP_ElementType is one element of a screen layout, something that is written in
+ * a position of the LCD
+ * **/
+typedef struct{
+	/*what the element shows*/
+	DISP_ElementKindType kind;
+	/*column in pixels (0 to 83) and row (0 to 5), if x is DISP_NEXT the element is written
+	 * right after the previous one and y is ignored*/
+	uint8 x;
+	uint8 y;
+	/*field of SDF bound to the element (SDF_..._DIRTY), 0 for DISP_TEXT*/
+	uint8 field;
+	/*texts of DISP_TEXT and DISP_CHOICE*/
+	const char* text[2];
+}DISP_ElementType;
 
 /**
  * Struct StateDisplay, will indicate, according to the currentState, what to display in
@@ -19,83 +69,92 @@
 typedef struct{
 	/*currentState is determined by the SDF received*/
 	MenuStateType currentState;
-	/*StateDisplay is a function pointer that receives the SDF, that indicates
-	 * what to print in the LCD, taking in account SDF*/
-	void (*StateDisplay)(SystemDisplayFlags*);
+	/*layout of the screen, the fields that it shows are the fields of its elements, and
+	 * the screen is drawn again only if one of them changed*/
+	const DISP_ElementType* layout;
+	/*number of elements in layout, up to DISP_MAX_ELEMENTS*/
+	uint8 count;
 }StateDisplay;
 
+/**
+ * Struct DISP_LatencyType has the time between an event (ADC sample, capture, button)
+ * and the end of the LCD update that shows it, in microseconds
+ * **/
+typedef struct{
+	/*latency of the last update*/
+	uint32 last;
+	/*worst latency seen*/
+	uint32 max;
+	/*number of updates measured*/
+	uint32 count;
+}DISP_LatencyType;
+
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function displays in the LCD, the default Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
- 	 \return void
- */
-static void defaultMenu(SystemDisplayFlags* SDF);
-/********************************************************************************************/
-/********************************************************************************************/
-/********************************************************************************************/
-/*!
- 	 \brief	 This function displays in the LCD, the main Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
- 	 \return void
- */
-static void mainMenu(SystemDisplayFlags* SDF);
-/********************************************************************************************/
-/********************************************************************************************/
-/********************************************************************************************/
-/*!
- 	 \brief	 This function displays in the LCD, the alarm Menu
+ 	 \brief	 This function according to SDF (currentState), chooses which layout to draw
+ 	 in the LCD. If the state changed the whole layout is drawn, otherwise only the elements
+ 	 bound to a dirty field (and the ones written after them) are drawn over the previous
+ 	 frame. If none of the fields that the layout shows is dirty, the LCD is left as it is.
+ 	 The trend graph is drawn whole with its screen, the refresh adds the new samples
  	 \param[in] SDF - Data to take account for displaying in the LCD
+ 	 \param[in] dirty - fields of SDF that changed (returned by SYSUPD_SDFsnapshot())
  	 \return void
  */
-static void alarmMenu(SystemDisplayFlags* SDF);
+void update_Display(SystemDisplayFlags* SDF, uint8 dirty);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function displays in the LCD, the temperature Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
+ 	 \brief	 This function starts the display refresh timer. SCHED_init() and
+ 	 LCDNokia_init() must be called before
  	 \return void
  */
-static void temperatureMenu(SystemDisplayFlags* SDF);
+void DISP_init();
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function displays in the LCD, the percentage Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
+ 	 \brief	 This function asks for the display to show the current SystemDisplayFlags.
+ 	 The requests that aren't immediate wait for the next refresh (every DISP_REFRESH_MS), so
+ 	 many requests cost a single redraw; when it comes, the temperature and the frequency only
+ 	 count as changed if they moved beyond their deadband. The immediate requests (screen
+ 	 changes from the buttons) are drawn right away.
+ 	 \param[in] eventTimeStamp - lifetime timer value (see PIT_lifetimeRead()) of the event
+ 	 that caused the request, for the latency statistics
+ 	 \param[in] immediate - TRUE to draw now, FALSE to wait for the refresh
  	 \return void
  */
-static void percentageMenu(SystemDisplayFlags* SDF);
+void DISP_request(uint64 eventTimeStamp, uint8 immediate);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function displays in the LCD, the motor Control Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
- 	 \return void
+ 	 \brief	 This function returns how many redraws were saved, because the request was
+ 	 coalesced with a pending one, or because nothing beyond the deadbands changed. It is
+ 	 meant to tune DISP_REFRESH_MS and the deadbands
+ 	 \return uint32 - suppressed redraws
  */
-static void motorControlMenu(SystemDisplayFlags* SDF);
+uint32 DISP_suppressed();
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function displays in the LCD, the frequency Menu
- 	 \param[in] SDF - Data to take account for displaying in the LCD
+ 	 \brief	 This function is called right after update_Display (DISP_request() does it),
+ 	 with the timestamp of the event that caused the update, and records the event to LCD
+ 	 latency
+ 	 \param[in] eventTimeStamp - lifetime timer value (see PIT_lifetimeRead()) of the event
  	 \return void
  */
-static void frequencyMenu(SystemDisplayFlags* SDF);
+void DISP_latencyRecord(uint64 eventTimeStamp);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
- 	 \brief	 This function according to SDF (currentState), chooses which menu to display
- 	 in the LCD
- 	 \param[in] SDF - Data to take account for displaying in the LCD
- 	 \return void
+ 	 \brief	 This function returns the event to LCD latency statistics
+ 	 \return const DISP_LatencyType* - latency statistics
  */
-void update_Display(SystemDisplayFlags* SDF);
+const DISP_LatencyType* DISP_latency();
 
 #endif /* SOURCES_DISP_H_ */
@@ -61,6 +61,10 @@ typedef short int sint16;
 typedef unsigned long int uint32;
 /*! This data type is 16-bit signed integer*/
 typedef long int sint32;
+/*! This data type is 64-bit unsigned integer*/
+typedef unsigned long long uint64;
+/*! This data type is 64-bit signed integer*/
+typedef long long sint64;
 
 
 #endif /* SOURCES_DATATYPEDEFINITIONS_H_ */
@@ -0,0 +1,89 @@
+/**
+	\file
+	\brief
+		This is the source file for the FTFE of the K64. A command is written in the FCCOB
+		registers and launched clearing CCIF; CCIF is set again when it is done. The FMC keeps
+		the flash read before the command in its cache and prefetch buffers, so they are
+		invalidated when the command is done, before the flash is read through the memory
+		map again.
+	\date	19/10/2026
+ */
+
+#include "MK64F12.h"
+#include "FLASH.h"
+
+/*A command was launched, and the cache wasn't invalidated after it*/
+static uint8 FLASH_launched = FALSE;
+
+/*Tells if a command is running. When the last one is done, the cache and the speculation
+ * buffers are invalidated: the bits are in PFB0CR, for both banks (PFB1CR has none)*/
+static uint8 FLASH_busy(){
+	if(!(FTFE->FSTAT & FLASH_CCIF)){
+		return TRUE;
+	}
+	if(FLASH_launched){
+		FMC->PFB0CR |= FLASH_CINV_WAY | FLASH_S_B_INV;
+		FLASH_launched = FALSE;
+	}
+	return FALSE;
+}
+
+/*Tells if the last command failed*/
+static uint8 FLASH_failed(){
+	return (FTFE->FSTAT & (FLASH_ACCERR | FLASH_FPVIOL | FLASH_MGSTAT0)) ? TRUE : FALSE;
+}
+
+/*Write the command and its address in FCCOB0 to FCCOB3, after clearing the errors of the
+ * previous one*/
+static void FLASH_command(uint8 command, uint32 address){
+	FTFE->FSTAT = FLASH_ACCERR | FLASH_FPVIOL;
+	FTFE->FCCOB0 = command;
+	FTFE->FCCOB1 = (uint8)(address >> 16);
+	FTFE->FCCOB2 = (uint8)(address >> 8);
+	FTFE->FCCOB3 = (uint8)address;
+}
+
+/*Start programming a phrase, FCCOB4 to FCCOB7 have the first word and FCCOB8 to FCCOBB the
+ * second one, most significant byte first*/
+static uint8 FLASH_program(uint32 address, const uint8* data){
+	if(FLASH_busy()){
+		return FALSE;
+	}
+	FLASH_command(FLASH_PROGRAM_PHRASE, address);
+	FTFE->FCCOB4 = data[3];
+	FTFE->FCCOB5 = data[2];
+	FTFE->FCCOB6 = data[1];
+	FTFE->FCCOB7 = data[0];
+	FTFE->FCCOB8 = data[7];
+	FTFE->FCCOB9 = data[6];
+	FTFE->FCCOBA = data[5];
+	FTFE->FCCOBB = data[4];
+	/*Launch it*/
+	FLASH_launched = TRUE;
+	FTFE->FSTAT = FLASH_CCIF;
+	return TRUE;
+}
+
+/*Start erasing a sector*/
+static uint8 FLASH_erase(uint32 address){
+	if(FLASH_busy()){
+		return FALSE;
+	}
+	FLASH_command(FLASH_ERASE_SECTOR, address);
+	FLASH_launched = TRUE;
+	FTFE->FSTAT = FLASH_CCIF;
+	return TRUE;
+}
+
+/*The flash is in the memory map*/
+static const uint8* FLASH_read(uint32 address){
+	return (const uint8*)address;
+}
+
+const FLASH_DriverType FLASH_ftfe = {
+		FLASH_busy,
+		FLASH_failed,
+		FLASH_program,
+		FLASH_erase,
+		FLASH_read
+};
@@ -0,0 +1,64 @@
+/**
+	\file
+	\brief
+		This is the header file for the flash. The users of the flash (NVS.h) go through a
+		table of functions, FLASH_DriverType, so the same code runs on the FTFE of the K64
+		(FLASH_ftfe) or, on the host, on a simulated flash in RAM (tools/nvssim.c). The
+		commands don't wait: they are started, and the user polls busy() until they are
+		done, so a sector erase doesn't stall the application.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_FLASH_H_
+#define SOURCES_FLASH_H_
+
+#include "DataTypeDefinitions.h"
+
+/** Size of the unit of programming (phrase), in bytes */
+#define FLASH_PHRASE 8
+/** Size of the unit of erasing (sector), in bytes */
+#define FLASH_SECTOR_SIZE 4096
+/** Value of an erased byte */
+#define FLASH_ERASED 0xFF
+
+/*defines for the flash status register (FTFE_FSTAT)*/
+#define FLASH_CCIF    0x80
+#define FLASH_RDCOLERR 0x40
+#define FLASH_ACCERR  0x20
+#define FLASH_FPVIOL  0x10
+#define FLASH_MGSTAT0 0x01
+
+/*defines for the cache and prefetch buffers of the flash controller (FMC_PFB0CR), writing
+ * them invalidates all the ways of the cache and the speculation buffers of both banks*/
+#define FLASH_CINV_WAY 0x00F00000
+#define FLASH_S_B_INV  0x00080000
+
+/*defines for the flash commands (FTFE_FCCOB0)*/
+#define FLASH_PROGRAM_PHRASE 0x07
+#define FLASH_ERASE_SECTOR 0x09
+
+/**
+ * Struct FLASH_DriverType is a flash, as NVS sees it. The addresses are the ones of the
+ * memory map, the program and erase functions return FALSE if the command couldn't be
+ * started, because another one is running
+ * **/
+typedef struct{
+	/*TRUE while a command is running*/
+	uint8 (*busy)(void);
+	/*TRUE if the last command failed (access or protection error, or verify failed)*/
+	uint8 (*failed)(void);
+	/*start programming FLASH_PHRASE bytes at an address aligned to FLASH_PHRASE*/
+	uint8 (*program)(uint32 address, const uint8* data);
+	/*start erasing the sector that has the address*/
+	uint8 (*erase)(uint32 address);
+	/*bytes of the flash at an address, to read them*/
+	const uint8* (*read)(uint32 address);
+}FLASH_DriverType;
+
+/**
+ * The FTFE of the K64. Only the sectors that are not being executed may be programmed or
+ * erased: the code runs from program flash block 0, so NVS uses the last sectors of block 1
+ * **/
+extern const FLASH_DriverType FLASH_ftfe;
+
+#endif /* SOURCES_FLASH_H_ */
@@ -14,39 +14,54 @@
 #include "NVIC.h"
 #include "DataTypeDefinitions.h"
 #include "GlobalFunctions.h"
+#include "PIT.h"
 
 /*uint8 testNumber, that indicates which test has been taken in the
  * input capture mode*/
 static uint8 testNumber = 0;
 
-/*FTM0_Mailbox initialization*/
-FTM_MailBoxType FTM0_MailBox = {
-		FALSE,
-		0
-};
-
-/*FTM2_Mailbox2 initialization*/
+/*FTM2_Mailbox2 initialization, it has the second capture of FTM_2*/
 FTM_MailBoxType FTM2_MailBox2 = {
 		FALSE,
+		0,
 		0
 };
 
-/*FTM1_Mailbox initialization*/
-FTM_MailBoxType FTM1_MailBox = {
-		FALSE,
-		0
+/*Mailboxes initialization, indexed by FTM_ChannelType*/
+FTM_MailBoxType FTM_MailBox[4] = {
+		{FALSE, 0, 0},
+		{FALSE, 0, 0},
+		{FALSE, 0, 0},
+		{FALSE, 0, 0}
 };
 
-/*FTM2_Mailbox initialization*/
-FTM_MailBoxType FTM2_MailBox = {
-		FALSE,
-		0
-};
+/*Registers of each Flex timer, indexed by FTM_ChannelType*/
+FTM_Type* const FTM_handle[4] = {FTM0, FTM1, FTM2, FTM3};
 
-/*FTM3_Mailbox initialization*/
-FTM_MailBoxType FTM3_MailBox = {
-		FALSE,
-		0
+/*Functions called on each overflow, indexed by FTM_ChannelType, 0 for none*/
+static FTM_CallbackType FTM_overflowCallback[4] = {0, 0, 0, 0};
+
+/**
+ * Struct FTM_InstanceType has what changes from one Flex timer to another, apart from
+ * the registers
+ * **/
+typedef struct{
+	/*SIM register that has the clock gating of the Flex timer*/
+	__IO uint32_t* clockGatingRegister;
+	/*bit of the Flex timer in clockGatingRegister*/
+	uint32 clockGating;
+	/*NVIC interruption of the Flex timer*/
+	InterruptType interrupt;
+	/*priority of the interruption*/
+	PriorityLevelType priority;
+}FTM_InstanceType;
+
+/*Clock gating and interruption of each Flex timer, indexed by FTM_ChannelType*/
+static const FTM_InstanceType FTM_instance[4] = {
+		{&SIM_SCGC6, FTM0_CLOCK_GATING, FTM0_IRQ, PRIORITY_9},
+		{&SIM_SCGC6, FTM1_CLOCK_GATING, FTM1_IRQ, PRIORITY_9},
+		{&SIM_SCGC6, FTM2_CLOCK_GATING, FTM2_IRQ, PRIORITY_7},
+		{&SIM_SCGC3, FTM3_CLOCK_GATING, FTM3_IRQ, PRIORITY_9}
 };
 
 
@@ -54,7 +69,10 @@ void FTM0_IRQHandler()
 {
 	/**Clearing the overflow interrupt flag*/
 	FTM0_SC &= ~FLEX_TIMER_TOF;
-	FTM0_MailBox.flag = TRUE;
+	FTM_MailBox[FTM_0].flag = TRUE;
+	if(FTM_overflowCallback[FTM_0]){
+		FTM_overflowCallback[FTM_0]();
+	}
 }
 
 void FTM1_IRQHandler()
@@ -62,12 +80,20 @@ void FTM1_IRQHandler()
 	/**Clearing the overflow interrupt flag*/
 	FTM1_SC &= ~FLEX_TIMER_TOF;
 
-	FTM1_MailBox.flag = TRUE;
+	FTM_MailBox[FTM_1].flag = TRUE;
+	if(FTM_overflowCallback[FTM_1]){
+		FTM_overflowCallback[FTM_1]();
+	}
 }
 
 void FTM2_IRQHandler(){
-	/**Clearing the overflow interrupt flag*/
-	FTM2_SC &= ~FLEX_TIMER_TOF;
+	/**Clearing the overflow interrupt flag, and attending the overflow*/
+	if(FTM2_SC & FLEX_TIMER_TOF){
+		FTM2_SC &= ~FLEX_TIMER_TOF;
+		if(FTM_overflowCallback[FTM_2]){
+			FTM_overflowCallback[FTM_2]();
+		}
+	}
 
 	/*Making sure that the interruption is because of the channel 1 in the flex timer 2*/
 	if(!(FTM2_C1SC & FLEX_TIMER_CHF)){
@@ -89,7 +115,7 @@ void FTM2_IRQHandler(){
 
 	/*If test number is 1, we get the first CnV value, that is time1*/
 	} else if(testNumber == 1){
-		FTM2_MailBox.MailBoxData = FTM_readCHValue(FTM_2, CHANNEL_N_1);
+		FTM_MailBox[FTM_2].MailBoxData = FTM_readChannelValue(FTM2, CHANNEL_N_1);
 
 		/*get next test number*/
 		testNumber = 2;
@@ -99,8 +125,9 @@ void FTM2_IRQHandler(){
 	} else {
 
 		/*Set the flag, to indicate that we have 2 values*/
-		FTM2_MailBox.flag = TRUE;
-		FTM2_MailBox2.MailBoxData = FTM_readCHValue(FTM_2, CHANNEL_N_1);
+		FTM_MailBox[FTM_2].timeStamp = PIT_lifetimeRead();
+		FTM_MailBox[FTM_2].flag = TRUE;
+		FTM2_MailBox2.MailBoxData = FTM_readChannelValue(FTM2, CHANNEL_N_1);
 		testNumber = 0;
 	}
 }
@@ -109,686 +136,89 @@ void FTM3_IRQHandler()
 {
 	/**Clearing the overflow interrupt flag*/
 	FTM2_SC &= ~FLEX_TIMER_TOF;
-	FTM3_MailBox.flag = TRUE;
+	FTM_MailBox[FTM_3].flag = TRUE;
+	if(FTM_overflowCallback[FTM_3]){
+		FTM_overflowCallback[FTM_3]();
+	}
 }
 
 /*Enable the clock gating according the Flex timer*/
 void FTM_clockGating(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		SIM_SCGC6  |= FTM0_CLOCK_GATING;
-		break;
-
-	case FTM_1:
-		SIM_SCGC6  |= FTM1_CLOCK_GATING;
-		break;
-
-	case FTM_2:
-		SIM_SCGC6  |= FTM2_CLOCK_GATING;
-		break;
-
-	case FTM_3:
-		SIM_SCGC3  |= FTM3_CLOCK_GATING;
-		break;
-	}
+	*FTM_instance[channel].clockGatingRegister |= FTM_instance[channel].clockGating;
 }
 
 /*Disable protection disable according to the Flex timer*/
 void FTM_WPDIS(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		FTM0_MODE = FTM_MODE_WPDIS_MASK;
-
-		break;
-
-	case FTM_1:
-		FTM1_MODE = (FTM_MODE_WPDIS_MASK);
-
-		break;
-
-	case FTM_2:
-		FTM2_MODE = (FTM_MODE_WPDIS_MASK);
-
-		break;
-
-	case FTM_3:
-		FTM3_MODE = (FTM_MODE_WPDIS_MASK);
-
-		break;
-	}
+	FTM_handle[channel]->MODE = FTM_MODE_WPDIS_MASK;
 }
 
 /*Write in the COMBINE register, according to the flex timer and combine config value*/
 void FTM_COMBINE(FTM_ChannelType channel, uint32* combineConfig){
-	switch(channel){
-	case FTM_0:
-		FTM0_MODE &= ~(*combineConfig);
-		FTM0_MODE |= *combineConfig;
-		break;
-
-	case FTM_1:
-		FTM1_MODE &= ~(*combineConfig);
-		FTM1_MODE |= *combineConfig;
-		break;
-
-	case FTM_2:
-		FTM2_MODE &= ~(*combineConfig);
-		FTM2_MODE |= *combineConfig;
-		break;
-
-	case FTM_3:
-		FTM3_MODE &= ~(*combineConfig);
-		FTM3_MODE |= *combineConfig;
-		break;
-	}
+	FTM_handle[channel]->MODE &= ~(*combineConfig);
+	FTM_handle[channel]->MODE |= *combineConfig;
 }
 
 /*Write in the MOD register, according to the flex timer and MOD value*/
 void FTM_MOD(FTM_ChannelType channel, uint16 MOD){
-	switch(channel){
-	case FTM_0:
-		FTM0_MOD = MOD;
-		break;
-
-	case FTM_1:
-		FTM1_MOD = MOD;
-		break;
-
-	case FTM_2:
-		FTM2_MOD = MOD;
-		break;
-
-	case FTM_3:
-		FTM3_MOD = MOD;
-		break;
-
-	}
+	FTM_handle[channel]->MOD = MOD;
 }
 
 /*Read the CNT register according to flex timer*/
 uint32 FTM_CNT(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		return FTM0_CNT;
-
-	case FTM_1:
-		return FTM1_CNT;
-
-	case FTM_2:
-		return FTM2_CNT;
-
-
-	case FTM_3:
-		return FTM3_CNT;
-
-	default:
-		return FALSE;
-	}
+	return FTM_handle[channel]->CNT;
 }
 
 /*Write in the SC register, according to the flex timer and sc config value*/
 void FTM_SC(FTM_ChannelType channel, uint32* statusAndControl){
-	switch(channel){
-	case FTM_0:
-		FTM0_SC &= ~(*statusAndControl);
-		FTM0_SC |= *statusAndControl;
-		break;
-
-	case FTM_1:
-		FTM1_SC &= ~(*statusAndControl);
-		FTM1_SC |= *statusAndControl;
-		break;
-
-	case FTM_2:
-		FTM2_SC &= ~(*statusAndControl);
-		FTM2_SC |= *statusAndControl;
-		break;
-
-	case FTM_3:
-		FTM3_SC &= ~(*statusAndControl);
-		FTM3_SC |= *statusAndControl;
-		break;
-	}
+	FTM_handle[channel]->SC &= ~(*statusAndControl);
+	FTM_handle[channel]->SC |= *statusAndControl;
 }
 
 /*Write in the CSC register, according to the flex timer, channel and config value*/
 void FTM_CSC(FTM_ChannelType channel, N_ChannelType n_channel, uint32* channelStatusAndControl){
-	switch(channel){
-	case FTM_0:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM0_C0SC &= ~(*channelStatusAndControl);
-			FTM0_C0SC |= *channelStatusAndControl;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM0_C1SC &= ~(*channelStatusAndControl);
-			FTM0_C1SC |= *channelStatusAndControl;
-
-			break;
-
-		case CHANNEL_N_2:
-
-			FTM0_C2SC &= ~(*channelStatusAndControl);
-			FTM0_C2SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_3:
-
-			FTM0_C3SC &= ~(*channelStatusAndControl);
-			FTM0_C3SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_4:
-
-			FTM0_C4SC &= ~(*channelStatusAndControl);
-			FTM0_C4SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_5:
-
-			FTM0_C5SC &= ~(*channelStatusAndControl);
-			FTM0_C5SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_6:
-
-			FTM0_C6SC &= ~(*channelStatusAndControl);
-			FTM0_C6SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_7:
-
-			FTM0_C7SC &= ~(*channelStatusAndControl);
-			FTM0_C7SC |= *channelStatusAndControl;
-			break;
-
-		}
-
-		break;
-
-	case FTM_1:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM1_C0SC &= ~(*channelStatusAndControl);
-			FTM1_C0SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM1_C1SC &= ~(*channelStatusAndControl);
-			FTM1_C1SC |= *channelStatusAndControl;
-			break;
-
-		}
-
-		break;
-
-	case FTM_2:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM2_C0SC &= ~(*channelStatusAndControl);
-			FTM2_C0SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM2_C1SC &= ~(*channelStatusAndControl);
-			FTM2_C1SC |= *channelStatusAndControl;
-			break;
-
-		}
-
-		break;
-
-	case FTM_3:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM3_C0SC &= ~(*channelStatusAndControl);
-			FTM3_C0SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM3_C1SC &= ~(*channelStatusAndControl);
-			FTM3_C1SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_2:
-
-			FTM3_C2SC &= ~(*channelStatusAndControl);
-			FTM3_C2SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_3:
-
-			FTM3_C3SC &= ~(*channelStatusAndControl);
-			FTM3_C3SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_4:
-
-			FTM3_C4SC &= ~(*channelStatusAndControl);
-			FTM3_C4SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_5:
-
-			FTM3_C5SC &= ~(*channelStatusAndControl);
-			FTM3_C5SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_6:
-
-			FTM3_C6SC &= ~(*channelStatusAndControl);
-			FTM3_C6SC |= *channelStatusAndControl;
-			break;
-
-		case CHANNEL_N_7:
-
-			FTM3_C7SC &= ~(*channelStatusAndControl);
-			FTM3_C7SC |= *channelStatusAndControl;
-			break;
-
-		}
-
-		break;
-	}
+	FTM_writeChannelControl(FTM_handle[channel], n_channel, *channelStatusAndControl);
 }
 
+/*Write in the CnV register, according to the flex timer and channel*/
 void FTM_updateCHValue(FTM_ChannelType channel, N_ChannelType n_channel, sint16 channelValue){
 	/**Assigns a new value for the duty cycle*/
-	switch(channel){
-	case FTM_0:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM0_C0V = channelValue;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM0_C1V = channelValue;
-
-			break;
-
-		case CHANNEL_N_2:
-
-			FTM0_C2V = channelValue;
-
-			break;
-
-		case CHANNEL_N_3:
-
-			FTM0_C3V = channelValue;
-
-			break;
-
-		case CHANNEL_N_4:
-
-			FTM0_C4V = channelValue;
-
-			break;
-
-		case CHANNEL_N_5:
-
-			FTM0_C5V = channelValue;
-
-			break;
-
-		case CHANNEL_N_6:
-
-			FTM0_C6V = channelValue;
-
-			break;
-
-		case CHANNEL_N_7:
-
-			FTM0_C7V = channelValue;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_1:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM1_C0V = channelValue;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM1_C1V = channelValue;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_2:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM2_C0V = channelValue;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM2_C1V = channelValue;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_3:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			FTM3_C0V = channelValue;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			FTM3_C1V = channelValue;
-
-			break;
-
-		case CHANNEL_N_2:
-
-			FTM3_C2V = channelValue;
-
-			break;
-
-		case CHANNEL_N_3:
-
-			FTM3_C3V = channelValue;
-
-			break;
-
-		case CHANNEL_N_4:
-
-			FTM3_C4V = channelValue;
-
-			break;
-
-		case CHANNEL_N_5:
-
-			FTM3_C5V = channelValue;
-
-			break;
-
-		case CHANNEL_N_6:
-
-			FTM3_C6V = channelValue;
-
-			break;
-
-		case CHANNEL_N_7:
-
-			FTM3_C7V = channelValue;
-
-			break;
-
-		}
-
-		break;
-	}
-
+	FTM_writeChannelValue(FTM_handle[channel], n_channel, channelValue);
 }
 
 /*Read in the CnV register, according to the flex timer and channel*/
 sint16 FTM_readCHValue(FTM_ChannelType channel, N_ChannelType n_channel){
-	/**Assigns a new value for the duty cycle*/
-	switch(channel){
-	case FTM_0:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			return FTM0_C0V;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			return FTM0_C1V;
-
-			break;
-
-		case CHANNEL_N_2:
-
-			return FTM0_C2V;
-
-			break;
-
-		case CHANNEL_N_3:
-
-			return FTM0_C3V;
-
-			break;
-
-		case CHANNEL_N_4:
-
-			return FTM0_C4V;
-
-			break;
-
-		case CHANNEL_N_5:
-
-			return FTM0_C5V;
-
-			break;
-
-		case CHANNEL_N_6:
-
-			return FTM0_C6V;
-
-			break;
-
-		case CHANNEL_N_7:
-
-			return FTM0_C7V;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_1:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			return FTM1_C0V;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			return FTM1_C1V;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_2:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			return FTM2_C0V;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			return FTM2_C1V;
-
-			break;
-
-		}
-
-		break;
-
-	case FTM_3:
-
-		switch(n_channel){
-		case CHANNEL_N_0:
-
-			return FTM3_C0V;
-
-			break;
-
-		case CHANNEL_N_1:
-
-			return FTM3_C1V;
-
-			break;
-
-		case CHANNEL_N_2:
-
-			return FTM3_C2V;
-
-			break;
-
-		case CHANNEL_N_3:
-
-			return FTM3_C3V;
-
-			break;
-
-		case CHANNEL_N_4:
-
-			return FTM3_C4V;
-
-			break;
-
-		case CHANNEL_N_5:
-
-			return FTM3_C5V;
-
-			break;
-
-		case CHANNEL_N_6:
-
-			return FTM3_C6V;
-
-			break;
-
-		case CHANNEL_N_7:
-
-			return FTM3_C7V;
-
-			break;
-
-		}
-
-		return FALSE;
-	}
-
+	return FTM_readChannelValue(FTM_handle[channel], n_channel);
 }
 
 /*Enable the NVIC interruption according to the flex timer*/
 void FTM_IRQEnable(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		NVIC_enableInterruptAndPriority(FTM0_IRQ, PRIORITY_9);
-
-		break;
-
-	case FTM_1:
-		NVIC_enableInterruptAndPriority(FTM1_IRQ, PRIORITY_9);
-
-		break;
-
-	case FTM_2:
-		NVIC_enableInterruptAndPriority(FTM2_IRQ, PRIORITY_7);
-
-		break;
-
-	case FTM_3:
-		NVIC_enableInterruptAndPriority(FTM3_IRQ, PRIORITY_9);
-
-		break;
-	}
-
+	NVIC_enableInterruptAndPriority(FTM_instance[channel].interrupt, FTM_instance[channel].priority);
+}
 
+/*Set the function called on each overflow of the Flex timer*/
+void FTM_overflowCallbackSet(FTM_ChannelType channel, FTM_CallbackType callback){
+	FTM_overflowCallback[channel] = callback;
 }
 
 /*Reads the mail box flag according to the Flex timer*/
 uint8 FTM_mailBoxFlag(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		return FTM0_MailBox.flag;
-
-	case FTM_1:
-		return FTM1_MailBox.flag;
-
-	case FTM_2:
-		return FTM2_MailBox.flag;
-
-	case FTM_3:
-		return FTM3_MailBox.flag;
-
-	default:
-		return FALSE;
-
-	}
+	return FTM_MailBox[channel].flag;
 }
 
 /*Reads the mail box data according to the Flex timer*/
 uint16 FTM_readMailBoxData(FTM_ChannelType channel){
-	switch(channel){
-	case FTM_0:
-		FTM0_MailBox.flag = FALSE;
-		return FTM0_MailBox.MailBoxData;
-
-	case FTM_1:
-		FTM1_MailBox.flag = FALSE;
-		return FTM1_MailBox.MailBoxData;
-
-	case FTM_2:
-		FTM2_MailBox.flag = FALSE;
-		return FTM2_MailBox.MailBoxData;
-
-	case FTM_3:
-		FTM3_MailBox.flag = FALSE;
-		return FTM3_MailBox.MailBoxData;
-
-	case 4:
-		FTM2_MailBox.flag = FALSE;
+	/*Channel 4 is the second capture of FTM_2, it shares the flag of FTM_2*/
+	if(FTM_CAPTURE_2 == channel){
+		FTM_MailBox[FTM_2].flag = FALSE;
 		return FTM2_MailBox2.MailBoxData;
-
-	default:
-		return FALSE;
 	}
+	FTM_MailBox[channel].flag = FALSE;
+	return FTM_MailBox[channel].MailBoxData;
+}
+
+/*Reads the mail box timestamp according to the Flex timer*/
+uint64 FTM_mailBoxTimeStamp(FTM_ChannelType channel){
+	return FTM_MailBox[channel].timeStamp;
 }
 
 /*Initializes the flex timer, according to the struct config*/
@@ -92,8 +92,25 @@ typedef struct{
 	/*received data (sometimes not needed). When the data is readed, the flag is set to
 	 * FALSE*/
 	uint16 MailBoxData;
+	/*lifetime timer value when the flag was set*/
+	uint64 timeStamp;
 }FTM_MailBoxType;
 
+/**
+ * Registers of each Flex timer, indexed by FTM_ChannelType, so the driver doesn't need
+ * a switch for each instance. The channels are indexed by N_ChannelType in the CONTROLS
+ * array. FTM_1 and FTM_2 only have channels 0 and 1.
+ * **/
+extern FTM_Type* const FTM_handle[4];
+
+/**
+ * Function called from the interruption of a Flex timer, on each overflow
+ * **/
+typedef void (*FTM_CallbackType)(void);
+
+/*Value for FTM_readMailBoxData() that returns the second capture of FTM_2*/
+#define FTM_CAPTURE_2 4
+
 /*defines for enabling clock gating for different flex timers*/
 #define FTM0_CLOCK_GATING 0x01000000
 #define FTM1_CLOCK_GATING 0x02000000
@@ -149,6 +166,53 @@ typedef struct{
 #define  FLEX_TIMER_CHIE  0x40
 #define  FLEX_TIMER_CHF   0x80
 
+/**
+ * The next inline functions are the fast path. They receive the registers of the Flex
+ * timer (FTM0..FTM3 or FTM_handle[]), so they compile to a single access, with no
+ * branches. The channel is not checked.
+ */
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function writes the CnV of a channel
+ 	 \param[in] ftm - registers of the Flex timer
+ 	 \param[in] n_channel - channel where to write
+ 	 \param[in] channelValue - CnV value to write
+ 	 \return void
+ */
+static inline void FTM_writeChannelValue(FTM_Type* ftm, N_ChannelType n_channel, uint16 channelValue){
+	ftm->CONTROLS[n_channel].CnV = channelValue;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function reads the CnV of a channel
+ 	 \param[in] ftm - registers of the Flex timer
+ 	 \param[in] n_channel - channel where to read
+ 	 \return uint16 - CnV
+ */
+static inline uint16 FTM_readChannelValue(FTM_Type* ftm, N_ChannelType n_channel){
+	return ftm->CONTROLS[n_channel].CnV;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function writes the bits of channelStatusAndControl in the CnSC of a
+ 	 channel, the other bits are kept
+ 	 \param[in] ftm - registers of the Flex timer
+ 	 \param[in] n_channel - channel where to write
+ 	 \param[in] channelStatusAndControl - bits to set
+ 	 \return void
+ */
+static inline void FTM_writeChannelControl(FTM_Type* ftm, N_ChannelType n_channel, uint32 channelStatusAndControl){
+	ftm->CONTROLS[n_channel].CnSC &= ~channelStatusAndControl;
+	ftm->CONTROLS[n_channel].CnSC |= channelStatusAndControl;
+}
+
 /**
  * This first set of functions, are for writting to configuration or control registers
  * for a defined Flex timer and channel
@@ -268,6 +332,17 @@ uint16 FTM_readMailBoxData(FTM_ChannelType channel);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the lifetime timer value (see PIT_lifetimeRead()) taken
+ 	 when the mailBox flag of a Flex timer was set. For the input capture, it is the time of
+ 	 the second edge. It doesn't change the flag.
+ 	 \param[in] channel - Flex timer where to read
+ 	 \return uint64 - timestamp of the event
+ */
+uint64 FTM_mailBoxTimeStamp(FTM_ChannelType channel);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
 /*!
  	 \brief	 This function enables the NVIC interruption for a Flex timer
  	 \param[in] channel - Flex timer to enable the interruption
@@ -277,6 +352,17 @@ void FTM_IRQEnable(FTM_ChannelType channel);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/*!
+ 	 \brief	 This function sets a function to be called from the interruption of a Flex
+ 	 timer, each time it overflows. The overflow interruption must be enabled by FTM_init()
+ 	 \param[in] channel - Flex timer
+ 	 \param[in] callback - function to call, 0 for none
+ 	 \return void
+ */
+void FTM_overflowCallbackSet(FTM_ChannelType channel, FTM_CallbackType callback);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
 /*!
  	 \brief	 This function initializes a Flex timer, according to the values in the
  	 FTM_Config struct
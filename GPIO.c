@@ -12,267 +12,187 @@
 #include "DataTypeDefinitions.h"
 
 
+/*Port (pin control) registers of each GPIO, indexed by GPIO_portNameType*/
+PORT_Type* const PORT_handle[GPIO_PORTS] = {PORTA, PORTB, PORTC, PORTD, PORTE};
+
+/*GPIO (data) registers of each GPIO, indexed by GPIO_portNameType*/
+GPIO_Type* const GPIO_handle[GPIO_PORTS] = {PTA, PTB, PTC, PTD, PTE};
+
+/*Bit of each port in SIM_SCGC5, indexed by GPIO_portNameType*/
+static const uint32 GPIO_clockGatingMask[GPIO_PORTS] = {
+		GPIO_CLOCK_GATING_PORTA,
+		GPIO_CLOCK_GATING_PORTB,
+		GPIO_CLOCK_GATING_PORTC,
+		GPIO_CLOCK_GATING_PORTD,
+		GPIO_CLOCK_GATING_PORTE
+};
+
+/**
+ * Struct GPIO_CallbackEntryType tells who attends the interruption of a pin
+ * **/
+typedef struct{
+	/*function that attends the pin, 0 if the pin has none*/
+	GPIO_CallbackType callback;
+	/*pins of the group of the pin, they are attended with a single call*/
+	uint32 mask;
+}GPIO_CallbackEntryType;
+
+/*Function that attends each pin, indexed by GPIO_portNameType and pin*/
+static GPIO_CallbackEntryType GPIO_callback[GPIO_PORTS][GPIO_PINS];
+
+/*Attends the interruption of a port. The flags are read once, and only the set ones are
+ * cleared and visited, highest pin first*/
+static void GPIO_dispatch(GPIO_portNameType portName){
+	uint32 flags = PORT_handle[portName]->ISFR;
+	uint32 pending = flags;
+	const GPIO_CallbackEntryType* entry;
+	uint8 pin;
+
+	/*An edge that comes after the read keeps its flag*/
+	PORT_handle[portName]->ISFR = flags;
+
+	while(pending){
+		pin = 31 - __CLZ(pending);
+		entry = &GPIO_callback[portName][pin];
+		/*the whole group is attended now*/
+		pending &= ~(entry->mask | GPIO_MASK(pin));
+		if(entry->callback){
+			entry->callback(flags & entry->mask);
+		}
+	}
+}
+
+void PORTA_IRQHandler(){
+	GPIO_dispatch(GPIOA);
+}
+
+void PORTB_IRQHandler(){
+	GPIO_dispatch(GPIOB);
+}
+
+void PORTC_IRQHandler(){
+	GPIO_dispatch(GPIOC);
+}
+
+void PORTD_IRQHandler(){
+	GPIO_dispatch(GPIOD);
+}
+
+void PORTE_IRQHandler(){
+	GPIO_dispatch(GPIOE);
+}
+
 void GPIO_clearInterrupt(GPIO_portNameType portName){
-	switch(portName){
-		case GPIOA:
-			PORTA_ISFR=0xFFFFFFFF;
-			break;
-		case GPIOB:
-			PORTB_ISFR=0xFFFFFFFF;
-			break;
-		case GPIOC:
-			PORTC_ISFR=0xFFFFFFFF;
-			break;
-		case GPIOD:
-			PORTD_ISFR=0xFFFFFFFF;
-			break;
-		case GPIOE:
-			PORTE_ISFR=0xFFFFFFFF;
-			break;
-		default:
-			break;
+	PORT_handle[portName]->ISFR = 0xFFFFFFFF;
+}
+
+void GPIO_clearInterruptMask(GPIO_portNameType portName, uint32 mask){
+	PORT_handle[portName]->ISFR = mask;
+}
+
+uint8 GPIO_callbackInstall(GPIO_portNameType portName, uint32 mask, GPIO_CallbackType callback){
+	uint8 pin;
+
+	if(portName >= GPIO_PORTS){
+		return FALSE;
+	}
+	for(pin = 0; pin < GPIO_PINS; pin++){
+		if(mask & GPIO_MASK(pin)){
+			GPIO_callback[portName][pin].callback = callback;
+			/*the pins without function are skipped one by one*/
+			GPIO_callback[portName][pin].mask = (callback) ? mask : GPIO_MASK(pin);
+		}
 	}
+	return TRUE;
 }
 
 uint8 GPIO_clockGating(GPIO_portNameType portName){
-	switch(portName){
-		case GPIOA:
-			SIM_SCGC5 |= GPIO_CLOCK_GATING_PORTA;
-			break;
-		case GPIOB:
-			SIM_SCGC5 |= GPIO_CLOCK_GATING_PORTB;
-			break;
-		case GPIOC:
-			SIM_SCGC5 |= GPIO_CLOCK_GATING_PORTC;
-			break;
-		case GPIOD:
-			SIM_SCGC5 |= GPIO_CLOCK_GATING_PORTD;
-			break;
-		case GPIOE:
-			SIM_SCGC5 |= GPIO_CLOCK_GATING_PORTE;
-			break;
-		default:
-			return FALSE;
+	if(portName >= GPIO_PORTS){
+		return FALSE;
 	}
+	SIM_SCGC5 |= GPIO_clockGatingMask[portName];
 	return TRUE;
 }
 
 uint8 GPIO_pinControlRegister(GPIO_portNameType portName,uint8 pin,GPIO_pinControlRegisterType* pinControlRegister){
-	switch(portName){
-		case GPIOA:
-			PORTA_PCR(pin) = *pinControlRegister;
-			break;
-		case GPIOB:
-			PORTB_PCR(pin) = *pinControlRegister;
-			break;
-		case GPIOC:
-			PORTC_PCR(pin) = *pinControlRegister;
-			break;
-		case GPIOD:
-			PORTD_PCR(pin) = *pinControlRegister;
-			break;
-		case GPIOE:
-			PORTE_PCR(pin) = *pinControlRegister;
-			break;
-		default:
-			return FALSE;
+	if(portName >= GPIO_PORTS){
+		return FALSE;
 	}
+	PORT_handle[portName]->PCR[pin] = *pinControlRegister;
 	return TRUE;
 }
 
-void GPIO_dataDirectionPORT(GPIO_portNameType portName, uint32 direction){
-	switch(portName){
-		case GPIOA:
-			GPIOA_PDDR = direction;
-			break;
-		case GPIOB:
-			GPIOB_PDDR = direction;
-			break;
-		case GPIOC:
-			GPIOC_PDDR = direction;
-			break;
-		case GPIOD:
-			GPIOD_PDDR = direction;
-			break;
-		case GPIOE:
-			GPIOE_PDDR = direction;
-			break;
+uint8 GPIO_pinControlMask(GPIO_portNameType portName, uint32 mask, uint32 pinControl){
+	PORT_Type* port;
+	uint8 pin;
+
+	if(portName >= GPIO_PORTS){
+		return FALSE;
 	}
+	port = PORT_handle[portName];
+
+	/*The interruption configuration needs a write per pin*/
+	if(pinControl & ~GPIO_GLOBAL_PCR_MASK){
+		while(mask){
+			pin = 31 - __CLZ(mask);
+			port->PCR[pin] = pinControl;
+			mask &= ~GPIO_MASK(pin);
+		}
+		return TRUE;
+	}
+
+	/*The write enable of each pin goes in the upper half of the global registers*/
+	if(mask & 0x0000FFFF){
+		port->GPCLR = (mask << 16) | pinControl;
+	}
+	if(mask & 0xFFFF0000){
+		port->GPCHR = (mask & 0xFFFF0000) | pinControl;
+	}
+	return TRUE;
 }
 
-void GPIO_dataDirectionPIN(GPIO_portNameType portName, uint8 state, uint8 pin){
+void GPIO_dataDirectionPORT(GPIO_portNameType portName, uint32 direction){
+	GPIO_handle[portName]->PDDR = direction;
+}
 
-	switch(portName){
-		case(GPIOA):
-				if(state == GPIO_OUTPUT){
-					GPIOA_PDDR |= (BIT_ON << pin);
-				}
-				else{
-					GPIOA_PDDR &= ~(BIT_ON << pin);
-				}
-				break;
-		case(GPIOB):
-				if(state == GPIO_OUTPUT){
-					GPIOB_PDDR |= (BIT_ON << pin);
-				}
-				else{
-					GPIOB_PDDR &= ~(BIT_ON << pin);
-				}
-				break;
-		case(GPIOC):
-				if(state == GPIO_OUTPUT){
-					GPIOC_PDDR |= (BIT_ON << pin);
-				}
-				else{
-					GPIOC_PDDR &= ~(BIT_ON << pin);
-				}
-				break;
-		case(GPIOD):
-				if(state == GPIO_OUTPUT){
-					GPIOD_PDDR |= (BIT_ON << pin);
-				}
-				else{
-					GPIOD_PDDR &= ~(BIT_ON << pin);
-				}
-				break;
-		case(GPIOE):
-				if(state == GPIO_OUTPUT){
-					GPIOE_PDDR |= (BIT_ON << pin);
-				}
-				else{
-					GPIOE_PDDR &= ~(BIT_ON << pin);
-				}
-				break;
+void GPIO_dataDirectionPIN(GPIO_portNameType portName, uint8 state, uint8 pin){
+	if(state == GPIO_OUTPUT){
+		GPIO_handle[portName]->PDDR |= (BIT_ON << pin);
+	}
+	else{
+		GPIO_handle[portName]->PDDR &= ~(BIT_ON << pin);
 	}
 }
 
-uint32 GPIO_readPORT(GPIO_portNameType portName){
-
-	switch(portName){
-		case(GPIOA):
-				return GPIOA_PDIR;
-				break;
-		case(GPIOB):
-				return GPIOB_PDIR;
-				break;
-		case(GPIOC):
-				return GPIOC_PDIR;
-				break;
-		case(GPIOD):
-				return GPIOD_PDIR;
-				break;
-		case(GPIOE):
-				return GPIOE_PDIR;
-				break;
-		default:
-				return FALSE;
+void GPIO_dataDirectionMask(GPIO_portNameType portName, uint32 mask, uint8 state){
+	if(state == GPIO_OUTPUT){
+		GPIO_handle[portName]->PDDR |= mask;
+	}
+	else{
+		GPIO_handle[portName]->PDDR &= ~mask;
 	}
+}
 
+uint32 GPIO_readPORT(GPIO_portNameType portName){
+	return GPIO_handle[portName]->PDIR;
 }
 
 uint8 GPIO_readPIN(GPIO_portNameType portName, uint8 pin){
-	switch(portName){
-		case(GPIOA):
-				return (GPIOA_PDIR & (1 << pin))?1:0;
-				break;
-		case(GPIOB):
-				return (GPIOB_PDIR & (1 << pin))?1:0;
-				break;
-		case(GPIOC):
-				return (GPIOC_PDIR & (1 << pin))?1:0;
-				break;
-		case(GPIOD):
-				return (GPIOD_PDIR & (1 << pin))?1:0;
-				break;
-		case(GPIOE):
-				return (GPIOE_PDIR & (1 << pin))?1:0;
-				break;
-		default:
-			return FALSE;
-	}
+	return (GPIO_handle[portName]->PDIR >> pin) & 1;
 }
 
 void GPIO_writePORT(GPIO_portNameType portName, uint32 data){
-
-	switch(portName){
-		case GPIOA:
-			GPIOA_PDOR = data;
-			break;
-		case GPIOB:
-			GPIOB_PDOR = data;
-			break;
-		case GPIOC:
-			GPIOC_PDOR = data;
-			break;
-		case GPIOD:
-			GPIOD_PDOR = data;
-			break;
-		case GPIOE:
-			GPIOE_PDOR = data;
-			break;
-	}
+	GPIO_handle[portName]->PDOR = data;
 }
 
 void GPIO_setPIN(GPIO_portNameType portName, uint8 pin){
-
-switch(portName){
-	case(GPIOA):
-			GPIOA_PSOR = (BIT_ON << pin);
-			break;
-	case(GPIOB):
-			GPIOB_PSOR = (BIT_ON << pin);
-			break;
-	case(GPIOC):
-			GPIOC_PSOR = (BIT_ON << pin);
-			break;
-	case(GPIOD):
-			GPIOD_PSOR = (BIT_ON << pin);
-			break;
-	case(GPIOE):
-			GPIOE_PSOR = (BIT_ON << pin);
-			break;
-	}
+	GPIO_setMask(GPIO_handle[portName], BIT_ON << pin);
 }
 
 void GPIO_clearPIN(GPIO_portNameType portName, uint8 pin){
-	switch(portName){
-		case GPIOA:
-			GPIOA_PCOR = (BIT_ON << pin);
-			break;
-		case GPIOB:
-			GPIOB_PCOR = (BIT_ON << pin);
-			break;
-		case GPIOC:
-			GPIOC_PCOR = (BIT_ON << pin);
-			break;
-		case GPIOD:
-			GPIOD_PCOR = (BIT_ON << pin);
-			break;
-		case GPIOE:
-			GPIOE_PCOR = (BIT_ON << pin);
-			break;
-	}
+	GPIO_clearMask(GPIO_handle[portName], BIT_ON << pin);
 }
 
 void GPIO_tooglePIN(GPIO_portNameType portName, uint8 pin){
-	switch(portName){
-		case GPIOA:
-			GPIOA_PTOR = (BIT_ON << pin);
-			break;
-		case GPIOB:
-			GPIOB_PTOR = (BIT_ON << pin);
-			break;
-		case GPIOC:
-			GPIOC_PTOR = (BIT_ON << pin);
-			break;
-		case GPIOD:
-			GPIOD_PTOR = (BIT_ON << pin);
-			break;
-		case GPIOE:
-			GPIOE_PTOR = (BIT_ON << pin);
-			break;
-	}
+	GPIO_toggleMask(GPIO_handle[portName], BIT_ON << pin);
 }
-
-
-
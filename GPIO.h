@@ -11,6 +11,7 @@
 #define SOURCES_GPIO_H_
 
 
+#include "MK64F12.h"
 #include "DataTypeDefinitions.h"
 
 
@@ -85,6 +86,159 @@ typedef enum{GPIOA, /*!< Definition to select GPIO A */
 /*! This data type is used to configure the pin control register*/
 typedef const uint32 GPIO_pinControlRegisterType;
 
+/** Number of ports that exist in the K64 (GPIOA to GPIOE) */
+#define GPIO_PORTS 5
+/** Number of pins in each port */
+#define GPIO_PINS 32
+/** Mask of a pin, to build the masks of the functions that receive several pins */
+#define GPIO_MASK(pin) (1UL << (pin))
+/** Bits of the pin control register that the global pin control registers (GPCLR/GPCHR) can
+ * write, the interruption configuration (INTR_...) is outside of them */
+#define GPIO_GLOBAL_PCR_MASK 0x0000FFFF
+
+/*! Function called from the port interruption when one or more of its pins have their
+ * interruption flag set. It receives the flags of its pins that were set (already cleared)*/
+typedef void (*GPIO_CallbackType)(uint32 flags);
+
+/**
+ * Registers of each port, indexed by GPIO_portNameType, so the driver doesn't need a
+ * switch for each port. PORT_handle has the pin control and interruption registers,
+ * GPIO_handle has the data registers.
+ * **/
+extern PORT_Type* const PORT_handle[GPIO_PORTS];
+extern GPIO_Type* const GPIO_handle[GPIO_PORTS];
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function sets the pins in mask, with a single write to PSOR.
+ 	 It receives the registers of the port (PTA..PTE or GPIO_handle[])
+ 	 \param[in] gpio - data registers of the port
+ 	 \param[in] mask - pins to set
+ 	 \return void
+ */
+static inline void GPIO_setMask(GPIO_Type* gpio, uint32 mask){
+	gpio->PSOR = mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function clears the pins in mask, with a single write to PCOR
+ 	 \param[in] gpio - data registers of the port
+ 	 \param[in] mask - pins to clear
+ 	 \return void
+ */
+static inline void GPIO_clearMask(GPIO_Type* gpio, uint32 mask){
+	gpio->PCOR = mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function toggles the pins in mask, with a single write to PTOR
+ 	 \param[in] gpio - data registers of the port
+ 	 \param[in] mask - pins to toggle
+ 	 \return void
+ */
+static inline void GPIO_toggleMask(GPIO_Type* gpio, uint32 mask){
+	gpio->PTOR = mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function writes value in the pins of mask, the other pins of the port are
+ 	 not touched. It uses PSOR and PCOR, so there is no read-modify-write of PDOR that an
+ 	 interruption could break
+ 	 \param[in] gpio - data registers of the port
+ 	 \param[in] mask - pins to write
+ 	 \param[in] value - value of the pins, only the bits in mask are used
+ 	 \return void
+ */
+static inline void GPIO_writeMask(GPIO_Type* gpio, uint32 mask, uint32 value){
+	gpio->PSOR = value & mask;
+	gpio->PCOR = ~value & mask;
+}
+
+/**
+ * Struct GPIO_PinType is a handle of one pin (or several pins of the same port), computed
+ * once, usually as a static const, so the fast path functions below are a single store
+ * to PSOR, PCOR or PTOR, with no switch and no shift. Example:
+ * static const GPIO_PinType buzzer = GPIO_PIN(PTB, BIT18);
+ * **/
+typedef struct{
+	/*data registers of the port*/
+	GPIO_Type* gpio;
+	/*pins of the handle*/
+	uint32 mask;
+}GPIO_PinType;
+
+/** Initializer of a GPIO_PinType of a single pin */
+#define GPIO_PIN(gpio, pin) {(gpio), 1UL << (pin)}
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function sets the pins of the handle
+ 	 \param[in] pin - pin handle
+ 	 \return void
+ */
+static inline void GPIO_pinSet(const GPIO_PinType* pin){
+	pin->gpio->PSOR = pin->mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function clears the pins of the handle
+ 	 \param[in] pin - pin handle
+ 	 \return void
+ */
+static inline void GPIO_pinClear(const GPIO_PinType* pin){
+	pin->gpio->PCOR = pin->mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function toggles the pins of the handle
+ 	 \param[in] pin - pin handle
+ 	 \return void
+ */
+static inline void GPIO_pinToggle(const GPIO_PinType* pin){
+	pin->gpio->PTOR = pin->mask;
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function sets the pins of the handle if value isn't 0, or clears them
+ 	 \param[in] pin - pin handle
+ 	 \param[in] value - FALSE to clear, anything else to set
+ 	 \return void
+ */
+static inline void GPIO_pinWrite(const GPIO_PinType* pin, uint8 value){
+	if(value){
+		pin->gpio->PSOR = pin->mask;
+	} else {
+		pin->gpio->PCOR = pin->mask;
+	}
+}
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function reads the pins of the handle
+ 	 \param[in] pin - pin handle
+ 	 \return TRUE if any of the pins is 1 logic, FALSE if all of them are 0
+ */
+static inline uint8 GPIO_pinRead(const GPIO_PinType* pin){
+	return (pin->gpio->PDIR & pin->mask) ? TRUE : FALSE;
+}
+
 
 /********************************************************************************************/
 /********************************************************************************************/
@@ -94,9 +248,38 @@ typedef const uint32 GPIO_pinControlRegisterType;
 
  	 \param[in]  portName Port to clear interrupts.
  	 \return void
- 	 \todo Implement a mechanism to clear interrupts by a specific pin.
  */
 void GPIO_clearInterrupt(GPIO_portNameType portName);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function clears only the interrupts of the pins in mask, the flags of the
+ 	 other pins are kept.
+
+ 	 \param[in]  portName Port to clear interrupts.
+ 	 \param[in]  mask Pins to clear.
+ 	 \return void
+ */
+void GPIO_clearInterruptMask(GPIO_portNameType portName, uint32 mask);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function installs the function that attends the interruptions of a group of
+ 	 pins of a port. The PORTA to PORTE handlers are in GPIO.c; they read the flags once, clear
+ 	 only the ones that were set, and go through the set flags only, so the cost depends on the
+ 	 pins that triggered and not on the pins that exist. The callback is called once per
+ 	 interruption, with the flags of every pin of the group that triggered, so simultaneous
+ 	 edges (e.g. button chords) arrive together. The pin control register (interruption
+ 	 edge) and the NVIC are still configured by the caller.
+
+ 	 \param[in]  portName Port of the pins.
+ 	 \param[in]  mask Pins attended by callback, they must not belong to another group.
+ 	 \param[in]  callback Function to be called, 0 uninstalls the pins.
+ 	 \return 1 if the portName is valid else return 0
+ */
+uint8 GPIO_callbackInstall(GPIO_portNameType portName, uint32 mask, GPIO_CallbackType callback);
 
 
 
@@ -130,6 +313,22 @@ uint8 GPIO_pinControlRegister(GPIO_portNameType portName,uint8 pin,GPIO_pinContr
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/*!
+ 	 \brief
+ 	 	 This function writes the same pin control register value in several pins of a port.
+ 	 	 If the value only has bits of GPIO_GLOBAL_PCR_MASK (mux, pull, drive...), it takes
+ 	 	 one write to GPCLR (pins 0 to 15) and/or one to GPCHR (pins 16 to 31). If it also
+ 	 	 configures the interruption, the global registers can't reach those bits, so each pin
+ 	 	 is written, going through the set bits of mask only.
+ 	 \param[in] portName Port to be configured.
+ 	 \param[in] mask Pins to be configured (GPIO_MASK(pin) | ...).
+ 	 \param[in] pinControl Value of the pin control registers (GPIO_MUX1|GPIO_PE...).
+ 	 \return 1 if the portName is valid else return 0
+ */
+uint8 GPIO_pinControlMask(GPIO_portNameType portName, uint32 mask, uint32 pinControl);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
 /*!
  	 \brief
  	 	 This function configure all the GPIO port as input when 1 logic is written or output when 0 logic is written.
@@ -153,6 +352,18 @@ void GPIO_dataDirectionPIN(GPIO_portNameType portName, uint8 state, uint8 pin);
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/*!
+ 	 \brief  This function configures several pins of a GPIO port as inputs or outputs, the
+ 	 other pins keep their direction.
+ 	 \param[in] portName Port to configure.
+ 	 \param[in] mask Pins to configure (GPIO_MASK(pin) | ...).
+ 	 \param[in] state GPIO_INPUT or GPIO_OUTPUT.
+ 	 \return void
+ */
+void GPIO_dataDirectionMask(GPIO_portNameType portName, uint32 mask, uint8 state);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
 /*!
  	 \brief	 This function reads all the GPIO port.
  	 \param[in] portName Port to be read.
@@ -0,0 +1,301 @@
+/**
+	\file
+	\brief
+		This is the source file for the trend graph. Every column is a function of its
+		sample, the one before it, the scale, the alarm threshold and the ages of the marked
+		samples, so after a scroll the old columns are still right, except the ones that
+		lost or got a mark. The largest and the smallest samples shown come from a monotonic
+		queue each, as in HIST.c, so a new sample finds them in O(1) (amortized).
+	\date	19/10/2026
+ */
+
+#include "GRAPH.h"
+#include "HIST.h"
+#include "SYSUPD.h"
+
+/*Scale of the graph, values of the top and the bottom row*/
+static float GRAPH_top = GRAPH_MIN_SPAN;
+static float GRAPH_bottom = 0;
+/*Alarm threshold drawn, in Celsius degrees*/
+static uint8 GRAPH_alarm = 0;
+/*Ages of the largest and the smallest samples shown, they have the marks*/
+static uint16 GRAPH_maxAge = 0;
+static uint16 GRAPH_minAge = 0;
+/*The graph was drawn, and the timestamp of its newest sample*/
+static uint8 GRAPH_drawn = FALSE;
+static uint32 GRAPH_lastTime = 0;
+
+/**
+ * Struct GRAPH_QueueType is a monotonic queue of the samples shown. Its entries are serial
+ * numbers of samples, kept in a circular buffer of GRAPH_COLUMNS.
+ * **/
+typedef struct{
+	/*first entry, that is the oldest one, in the circular buffer*/
+	uint16 first;
+	/*number of entries*/
+	uint16 count;
+	uint32 entry[GRAPH_COLUMNS];
+}GRAPH_QueueType;
+
+/*Queues of the smallest and the largest samples shown, their first entries are them*/
+static GRAPH_QueueType GRAPH_minQueue;
+static GRAPH_QueueType GRAPH_maxQueue;
+/*Serial number of the next sample, the newest one shown is GRAPH_serial - 1*/
+static uint32 GRAPH_serial = 0;
+/*Values of the last GRAPH_COLUMNS samples, by serial number*/
+static float GRAPH_queued[GRAPH_COLUMNS];
+
+/*Row of a value, 0 is the top row*/
+static uint8 GRAPH_row(float value){
+	float row = (GRAPH_top - value) * (GRAPH_HEIGHT - 1) / (GRAPH_top - GRAPH_bottom);
+
+	if(row < 0){
+		return 0;
+	}
+	if(row > GRAPH_HEIGHT - 1){
+		return GRAPH_HEIGHT - 1;
+	}
+	return (uint8)(row + 0.5f);
+}
+
+/*Temperature of a sample that exists*/
+static float GRAPH_value(uint16 age){
+	return HIST_sample(age)->value[HIST_TEMPERATURE];
+}
+
+/*Entry of a queue, index 0 is the first one*/
+static uint32* GRAPH_queueEntry(GRAPH_QueueType* queue, uint16 index){
+	index += queue->first;
+	return &queue->entry[(index >= GRAPH_COLUMNS) ? index - GRAPH_COLUMNS : index];
+}
+
+/*Put a sample at the end of a queue, after taking out the entries that it makes useless:
+ * the ones that are not below it (maximum FALSE) or not above it (maximum TRUE). On ties
+ * the newest sample stays, so the marks move as little as possible*/
+static void GRAPH_queuePush(GRAPH_QueueType* queue, uint32 serial, float value, uint8 maximum){
+	float last;
+
+	while(queue->count){
+		last = GRAPH_queued[*GRAPH_queueEntry(queue, queue->count - 1) % GRAPH_COLUMNS];
+		if(maximum ? (last > value) : (last < value)){
+			break;
+		}
+		queue->count--;
+	}
+	*GRAPH_queueEntry(queue, queue->count) = serial;
+	queue->count++;
+}
+
+/*Take out the first entry of a queue, if its sample is no longer shown*/
+static void GRAPH_queueExpire(GRAPH_QueueType* queue){
+	if(queue->count && (GRAPH_serial - *GRAPH_queueEntry(queue, 0) > GRAPH_COLUMNS)){
+		queue->first = (queue->first + 1 == GRAPH_COLUMNS) ? 0 : queue->first + 1;
+		queue->count--;
+	}
+}
+
+/*Add the sample of age to the queues, it is the newest one shown*/
+static void GRAPH_push(uint16 age){
+	uint32 serial = GRAPH_serial++;
+	float value = GRAPH_value(age);
+
+	/*First the sample that is no longer shown, its value is overwritten next*/
+	GRAPH_queueExpire(&GRAPH_minQueue);
+	GRAPH_queueExpire(&GRAPH_maxQueue);
+	GRAPH_queued[serial % GRAPH_COLUMNS] = value;
+	GRAPH_queuePush(&GRAPH_minQueue, serial, value, FALSE);
+	GRAPH_queuePush(&GRAPH_maxQueue, serial, value, TRUE);
+}
+
+/*Fill the queues again with the samples shown*/
+static void GRAPH_refill(){
+	uint16 age = (HIST_count() < GRAPH_COLUMNS) ? HIST_count() : GRAPH_COLUMNS;
+
+	GRAPH_minQueue.first = 0;
+	GRAPH_minQueue.count = 0;
+	GRAPH_maxQueue.first = 0;
+	GRAPH_maxQueue.count = 0;
+	while(age){
+		age--;
+		GRAPH_push(age);
+	}
+}
+
+/*The largest and the smallest samples shown, and their ages for the marks. Returns FALSE
+ * if there are no samples*/
+static uint8 GRAPH_extremes(float* min, float* max){
+	uint32 minSerial;
+	uint32 maxSerial;
+
+	if(!GRAPH_maxQueue.count){
+		return FALSE;
+	}
+	minSerial = *GRAPH_queueEntry(&GRAPH_minQueue, 0);
+	maxSerial = *GRAPH_queueEntry(&GRAPH_maxQueue, 0);
+	GRAPH_minAge = GRAPH_serial - 1 - minSerial;
+	GRAPH_maxAge = GRAPH_serial - 1 - maxSerial;
+	*min = GRAPH_queued[minSerial % GRAPH_COLUMNS];
+	*max = GRAPH_queued[maxSerial % GRAPH_COLUMNS];
+	return TRUE;
+}
+
+/*Tells if the scale holds the values from min to max*/
+static uint8 GRAPH_fits(float min, float max){
+	return ((min >= GRAPH_bottom) && (max <= GRAPH_top)) ? TRUE : FALSE;
+}
+
+/*Choose the scale for the values from min to max*/
+static void GRAPH_scale(float min, float max){
+	sint32 bottom = (sint32)(min / GRAPH_SCALE_STEP);
+	sint32 top = (sint32)(max / GRAPH_SCALE_STEP);
+
+	/*Round down the bottom and up the top to the step*/
+	if(bottom * GRAPH_SCALE_STEP > min){
+		bottom--;
+	}
+	if(top * GRAPH_SCALE_STEP < max){
+		top++;
+	}
+	bottom *= GRAPH_SCALE_STEP;
+	top *= GRAPH_SCALE_STEP;
+	if(top - bottom < GRAPH_MIN_SPAN){
+		top = bottom + GRAPH_MIN_SPAN;
+	}
+	GRAPH_bottom = (float)bottom;
+	GRAPH_top = (float)top;
+}
+
+/*Set a pixel of a column, if the row is in the plot*/
+static void GRAPH_set(uint64* pixels, sint16 row){
+	if((row >= 0) && (row < GRAPH_HEIGHT)){
+		*pixels |= (uint64)1 << row;
+	}
+}
+
+/*Pixels of the column of a sample, bit 0 is the top row. A column without sample is blank*/
+static uint64 GRAPH_pixels(uint16 age){
+	const HIST_SampleType* sample = HIST_sample(age);
+	const HIST_SampleType* previous = HIST_sample(age + 1);
+	uint64 pixels = 0;
+	sint16 row;
+	sint16 from;
+	sint16 to;
+
+	if(!sample){
+		return 0;
+	}
+	row = GRAPH_row(sample->value[HIST_TEMPERATURE]);
+
+	/*A line from the previous sample, so steep changes are not loose dots*/
+	from = row;
+	to = previous ? GRAPH_row(previous->value[HIST_TEMPERATURE]) : row;
+	if(from > to){
+		from = to;
+		to = row;
+	}
+	for(; from <= to; from++){
+		GRAPH_set(&pixels, from);
+	}
+
+	/*The dashes follow the sample count, so they scroll with the plot*/
+	if(((sample->timeStamp / HIST_PERIOD_MS) % (2 * GRAPH_DASH)) < GRAPH_DASH){
+		GRAPH_set(&pixels, GRAPH_row(GRAPH_alarm));
+	}
+
+	if(age == GRAPH_maxAge){
+		GRAPH_set(&pixels, row - 2);
+		GRAPH_set(&pixels, row - 3);
+	}
+	if(age == GRAPH_minAge){
+		GRAPH_set(&pixels, row + 2);
+		GRAPH_set(&pixels, row + 3);
+	}
+	return pixels;
+}
+
+/*Draw the column of a sample, if it is shown*/
+static void GRAPH_column(uint16 age){
+	if(age < GRAPH_COLUMNS){
+		LCDNokia_column(GRAPH_COLUMNS - 1 - age, GRAPH_pixels(age));
+	}
+}
+
+/*Alarm threshold of the system*/
+static uint8 GRAPH_alarmThreshold(){
+	SystemUpdateFlags flags;
+
+	SYSUPD_SUFsnapshot(&flags);
+	return flags.currentAlarm;
+}
+
+void GRAPH_draw(){
+	const HIST_SampleType* newest = HIST_sample(0);
+	float min;
+	float max;
+	uint16 age;
+
+	GRAPH_alarm = GRAPH_alarmThreshold();
+	GRAPH_refill();
+	if(GRAPH_extremes(&min, &max)){
+		GRAPH_scale((min < GRAPH_alarm) ? min : GRAPH_alarm, (max > GRAPH_alarm) ? max : GRAPH_alarm);
+	} else {
+		GRAPH_scale(GRAPH_alarm, GRAPH_alarm);
+	}
+	for(age = 0; age < GRAPH_COLUMNS; age++){
+		GRAPH_column(age);
+	}
+	GRAPH_lastTime = newest ? newest->timeStamp : 0;
+	GRAPH_drawn = TRUE;
+}
+
+uint8 GRAPH_update(){
+	const HIST_SampleType* newest = HIST_sample(0);
+	const HIST_SampleType* sample;
+	uint16 added = 0;
+	uint16 age;
+	uint16 maxAge;
+	uint16 minAge;
+	float min;
+	float max;
+
+	if(!newest || (GRAPH_drawn && (newest->timeStamp == GRAPH_lastTime))){
+		return FALSE;
+	}
+	/*Samples recorded since the graph was drawn*/
+	while((added < GRAPH_COLUMNS) && (sample = HIST_sample(added)) && (sample->timeStamp != GRAPH_lastTime)){
+		added++;
+	}
+	if(!GRAPH_drawn || (added >= GRAPH_COLUMNS)){
+		GRAPH_draw();
+		return TRUE;
+	}
+	/*Where the marked samples are after the scroll*/
+	maxAge = GRAPH_maxAge + added;
+	minAge = GRAPH_minAge + added;
+	for(age = added; age; age--){
+		GRAPH_push(age - 1);
+	}
+	GRAPH_extremes(&min, &max);
+
+	if(!GRAPH_fits(min, max) || (GRAPH_alarmThreshold() != GRAPH_alarm)){
+		GRAPH_draw();
+		return TRUE;
+	}
+
+	LCDNokia_scroll(added);
+	while(added){
+		added--;
+		GRAPH_column(added);
+	}
+	/*The columns that lost or got a mark*/
+	if(maxAge != GRAPH_maxAge){
+		GRAPH_column(maxAge);
+		GRAPH_column(GRAPH_maxAge);
+	}
+	if(minAge != GRAPH_minAge){
+		GRAPH_column(minAge);
+		GRAPH_column(GRAPH_minAge);
+	}
+	GRAPH_lastTime = newest->timeStamp;
+	return TRUE;
+}
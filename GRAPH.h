@@ -0,0 +1,55 @@
+/**
+	\file
+	\brief
+		This is the header file for the trend graph. It plots the last GRAPH_COLUMNS
+		temperature samples of the history (see HIST.h), one per column of the LCD, scaled
+		into its 48 rows. The alarm threshold is a dashed line, and the largest and smallest
+		samples have a mark above and below them. The graph is drawn in the frame of the LCD:
+		when new samples come the frame is scrolled and only the new columns are computed,
+		instead of the 84 of a whole draw. The LCD has no scroll of its own, so the flush
+		after a scroll still sends almost every byte of the rows that the plot and the
+		dashes cross: one sample costs about the SPI traffic of a whole draw (314 data bytes
+		against 318 in the trend graph of tools/lcdhost.c).
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_GRAPH_H_
+#define SOURCES_GRAPH_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+#include "LCDNokia5110.h"
+
+/** Samples plotted, one per column, the newest one in the last column */
+#define GRAPH_COLUMNS LCD_X
+/** Rows of the plot, in pixels */
+#define GRAPH_HEIGHT LCD_Y
+/** The scale starts and ends at multiples of this, in Celsius degrees */
+#define GRAPH_SCALE_STEP 5
+/** Smallest span of the scale, in Celsius degrees */
+#define GRAPH_MIN_SPAN 10
+/** Length of the dashes of the alarm threshold, in samples */
+#define GRAPH_DASH 2
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function draws the whole graph in the LCD frame. The scale is chosen to
+ 	 hold the samples shown and the alarm threshold. LCDNokia_flush() sends it to the LCD
+ 	 \return void
+ */
+void GRAPH_draw();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function adds to the graph the samples recorded since it was drawn: the
+ 	 frame is scrolled and the new columns are drawn, with the columns whose mark moved. The
+ 	 whole graph is drawn again only if a sample or the alarm threshold leave the scale
+ 	 \return uint8 - TRUE if the frame changed, FALSE if there were no new samples
+ */
+uint8 GRAPH_update();
+
+#endif /* SOURCES_GRAPH_H_ */
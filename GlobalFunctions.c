@@ -6,14 +6,9 @@
  */
 
 #include "GlobalFunctions.h"
+#include "DELAY.h"
 
 void delay(uint16 delay)
 {
-	volatile int counter, counter2;
-	
-	for(counter2=16; counter2 > 0; counter2--)
-	{
-		for(counter=delay; counter > 0; counter--); 
-
-	}
+	DELAY_us((uint32)delay * DELAY_LEGACY_UNIT_US);
 }
@@ -11,6 +11,18 @@
 #include "GPIO.h"
 #include "DataTypeDefinitions.h"
 
+/**
+ * Define SYSTEM_CLOCK as the constant that represents the system clock frequency
+ * for calculation purposes in the algorithm. The PIT and the FTMs are clocked
+ * from the bus clock, which runs at this same frequency.
+ * */
+#define SYSTEM_CLOCK 21000000
+
+/** Length of one unit of delay(), in microseconds, it is about what the old counting
+ * loop took */
+#define DELAY_LEGACY_UNIT_US 8
+
+/*It waits delay*DELAY_LEGACY_UNIT_US microseconds, new code should use DELAY_us()*/
 void delay(uint16);
 
 
@@ -0,0 +1,229 @@
+/**
+	\file
+	\brief
+		This is the source file for the history. The mean and the variance of each window
+		use Welford's update: the sample that enters is added and the one that leaves the
+		window is removed. The minimum and the maximum use a monotonic queue per window: it
+		has the positions in the ring of the samples that may still become the minimum
+		(maximum), so its first entry is always the minimum (maximum) of the window.
+	\date	19/10/2026
+ */
+
+#include "HIST.h"
+#include "SYSUPD.h"
+#include "LOG.h"
+
+/*Length of each window, indexed by HIST_WindowType*/
+static const uint16 HIST_windowLength[HIST_WINDOWS] = {
+		HIST_WINDOW_1_MIN, HIST_WINDOW_10_MIN, HIST_WINDOW_1_HOUR
+};
+
+/*Where the queues of each window start in HIST_queueStorage, indexed by HIST_WindowType*/
+static const uint16 HIST_windowOffset[HIST_WINDOWS] = {
+		0, HIST_WINDOW_1_MIN, HIST_WINDOW_1_MIN + HIST_WINDOW_10_MIN
+};
+
+/**
+ * Struct HIST_QueueType is a monotonic queue. Its entries are positions in the ring, kept
+ * in a circular buffer of the length of the window.
+ * **/
+typedef struct{
+	/*first entry, that is the oldest one, in the circular buffer*/
+	uint16 first;
+	/*number of entries*/
+	uint16 count;
+}HIST_QueueType;
+
+/**
+ * Struct HIST_WindowStateType has the running statistics of a channel over a window
+ * **/
+typedef struct{
+	/*samples in the window*/
+	uint16 count;
+	/*running mean and sum of squared differences from the mean (Welford)*/
+	double mean;
+	double m2;
+	/*queues of the minimum and the maximum*/
+	HIST_QueueType minQueue;
+	HIST_QueueType maxQueue;
+}HIST_WindowStateType;
+
+/*Samples, HIST_head is where the next one is written*/
+static HIST_SampleType HIST_ring[HIST_SAMPLES];
+static uint16 HIST_head = 0;
+static uint16 HIST_size = 0;
+
+/*Statistics of each channel over each window*/
+static HIST_WindowStateType HIST_window[HIST_CHANNELS][HIST_WINDOWS];
+
+/*Circular buffers of the queues, [channel][0 for minimum, 1 for maximum]*/
+static uint16 HIST_queueStorage[HIST_CHANNELS][2][HIST_WINDOWS_LENGTH];
+
+/*Timer of the sampling*/
+static SCHED_TimerType HIST_timer;
+
+/*Position in the ring that is count samples older than position*/
+static uint16 HIST_older(uint16 position, uint16 count){
+	return (position >= count) ? position - count : position + HIST_SAMPLES - count;
+}
+
+/*Entry of a queue, index 0 is the first one*/
+static uint16* HIST_queueEntry(uint16* storage, const HIST_QueueType* queue, uint16 length, uint16 index){
+	index += queue->first;
+	return &storage[(index >= length) ? index - length : index];
+}
+
+/*Take out the first entry of a queue, if it is the sample that leaves the window*/
+static void HIST_queueExpire(uint16* storage, HIST_QueueType* queue, uint16 length, uint16 leaving){
+	if(queue->count && (*HIST_queueEntry(storage, queue, length, 0) == leaving)){
+		queue->first = (queue->first + 1 == length) ? 0 : queue->first + 1;
+		queue->count--;
+	}
+}
+
+/*Put a sample at the end of a queue, after taking out the entries that it makes useless:
+ * the ones that are not below it (maximum FALSE) or not above it (maximum TRUE)*/
+static void HIST_queuePush(uint16* storage, HIST_QueueType* queue, uint16 length, uint16 position,
+		HIST_ChannelType channel, uint8 maximum){
+	float value = HIST_ring[position].value[channel];
+	float last;
+
+	while(queue->count){
+		last = HIST_ring[*HIST_queueEntry(storage, queue, length, queue->count - 1)].value[channel];
+		if(maximum ? (last > value) : (last < value)){
+			break;
+		}
+		queue->count--;
+	}
+	*HIST_queueEntry(storage, queue, length, queue->count) = position;
+	queue->count++;
+}
+
+/*Remove from a window the sample at position, that leaves it*/
+static void HIST_windowRemove(HIST_ChannelType channel, HIST_WindowType window, uint16 position){
+	HIST_WindowStateType* state = &HIST_window[channel][window];
+	uint16 length = HIST_windowLength[window];
+	double value = HIST_ring[position].value[channel];
+	double delta;
+
+	HIST_queueExpire(&HIST_queueStorage[channel][0][HIST_windowOffset[window]], &state->minQueue, length, position);
+	HIST_queueExpire(&HIST_queueStorage[channel][1][HIST_windowOffset[window]], &state->maxQueue, length, position);
+
+	state->count--;
+	if(0 == state->count){
+		state->mean = 0;
+		state->m2 = 0;
+		return;
+	}
+	delta = value - state->mean;
+	state->mean -= delta / state->count;
+	state->m2 -= delta * (value - state->mean);
+	/*Rounding can't make it negative*/
+	if(state->m2 < 0){
+		state->m2 = 0;
+	}
+}
+
+/*Add to a window the sample at position, that enters it*/
+static void HIST_windowAdd(HIST_ChannelType channel, HIST_WindowType window, uint16 position){
+	HIST_WindowStateType* state = &HIST_window[channel][window];
+	uint16 length = HIST_windowLength[window];
+	double value = HIST_ring[position].value[channel];
+	double delta;
+
+	HIST_queuePush(&HIST_queueStorage[channel][0][HIST_windowOffset[window]], &state->minQueue, length, position, channel, FALSE);
+	HIST_queuePush(&HIST_queueStorage[channel][1][HIST_windowOffset[window]], &state->maxQueue, length, position, channel, TRUE);
+
+	state->count++;
+	delta = value - state->mean;
+	state->mean += delta / state->count;
+	state->m2 += delta * (value - state->mean);
+}
+
+/*Scheduler callback, take a sample of the system flags, for the history and the log*/
+static void HIST_tick(){
+	SystemUpdateFlags flags;
+	uint32 timeStamp = SCHED_ticks();
+
+	SYSUPD_SUFsnapshot(&flags);
+	HIST_record(timeStamp, flags.currentTemperature, flags.currentFrec);
+	LOG_append(timeStamp, flags.currentTemperature, flags.currentFrec);
+}
+
+void HIST_init(){
+	uint8 channel;
+	uint8 window;
+
+	HIST_head = 0;
+	HIST_size = 0;
+	for(channel = 0; channel < HIST_CHANNELS; channel++){
+		for(window = 0; window < HIST_WINDOWS; window++){
+			HIST_window[channel][window].count = 0;
+			HIST_window[channel][window].mean = 0;
+			HIST_window[channel][window].m2 = 0;
+			HIST_window[channel][window].minQueue.first = 0;
+			HIST_window[channel][window].minQueue.count = 0;
+			HIST_window[channel][window].maxQueue.first = 0;
+			HIST_window[channel][window].maxQueue.count = 0;
+		}
+	}
+	SCHED_timerStart(&HIST_timer, HIST_PERIOD_MS, HIST_PERIOD_MS, HIST_tick);
+}
+
+void HIST_record(uint32 timeStamp, float temperature, float frec){
+	uint8 channel;
+	uint8 window;
+
+	/*First the samples that leave the windows, the oldest one may be overwritten next*/
+	for(channel = 0; channel < HIST_CHANNELS; channel++){
+		for(window = 0; window < HIST_WINDOWS; window++){
+			if(HIST_window[channel][window].count == HIST_windowLength[window]){
+				HIST_windowRemove(channel, window, HIST_older(HIST_head, HIST_windowLength[window]));
+			}
+		}
+	}
+
+	HIST_ring[HIST_head].timeStamp = timeStamp;
+	HIST_ring[HIST_head].value[HIST_TEMPERATURE] = temperature;
+	HIST_ring[HIST_head].value[HIST_FREC] = frec;
+
+	for(channel = 0; channel < HIST_CHANNELS; channel++){
+		for(window = 0; window < HIST_WINDOWS; window++){
+			HIST_windowAdd(channel, window, HIST_head);
+		}
+	}
+
+	HIST_head = (HIST_head + 1 == HIST_SAMPLES) ? 0 : HIST_head + 1;
+	if(HIST_size < HIST_SAMPLES){
+		HIST_size++;
+	}
+}
+
+void HIST_stats(HIST_ChannelType channel, HIST_WindowType window, HIST_StatsType* stats){
+	const HIST_WindowStateType* state = &HIST_window[channel][window];
+	uint16 length = HIST_windowLength[window];
+
+	stats->count = state->count;
+	if(0 == state->count){
+		stats->min = 0;
+		stats->max = 0;
+		stats->mean = 0;
+		stats->variance = 0;
+		return;
+	}
+	stats->min = HIST_ring[*HIST_queueEntry(&HIST_queueStorage[channel][0][HIST_windowOffset[window]], &state->minQueue, length, 0)].value[channel];
+	stats->max = HIST_ring[*HIST_queueEntry(&HIST_queueStorage[channel][1][HIST_windowOffset[window]], &state->maxQueue, length, 0)].value[channel];
+	stats->mean = (float)state->mean;
+	stats->variance = (float)(state->m2 / state->count);
+}
+
+uint16 HIST_count(){
+	return HIST_size;
+}
+
+const HIST_SampleType* HIST_sample(uint16 age){
+	if(age >= HIST_size){
+		return 0;
+	}
+	return &HIST_ring[HIST_older(HIST_head, age + 1)];
+}
@@ -0,0 +1,121 @@
+/**
+	\file
+	\brief
+		This is the header file for the history. Every HIST_PERIOD_MS it takes the
+		temperature and the frequency of SystemUpdateFlags, with a timestamp, into a ring of
+		HIST_SAMPLES samples in RAM. For each of them it keeps the minimum, maximum, mean and
+		variance of the last minute, ten minutes and hour. The statistics are updated with
+		each sample in O(1) (amortized for the minimum and maximum), the ring is never
+		scanned, and nothing is allocated.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_HIST_H_
+#define SOURCES_HIST_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+#include "SCHED.h"
+
+/** Time between two samples, in scheduler ticks (ms) */
+#define HIST_PERIOD_MS 1000
+/** Number of samples kept in the ring (one hour, at one sample per second) */
+#define HIST_SAMPLES 3600
+
+/**
+ * Length of each window of statistics, in samples. They can't be longer than
+ * HIST_SAMPLES.
+ * **/
+#define HIST_WINDOW_1_MIN 60
+#define HIST_WINDOW_10_MIN 600
+#define HIST_WINDOW_1_HOUR 3600
+/** Sum of the lengths of the windows, for the minimum and maximum queues */
+#define HIST_WINDOWS_LENGTH (HIST_WINDOW_1_MIN + HIST_WINDOW_10_MIN + HIST_WINDOW_1_HOUR)
+
+/*! This enumerated constant is the value that a sample records*/
+typedef enum {HIST_TEMPERATURE, HIST_FREC, HIST_CHANNELS} HIST_ChannelType;
+
+/*! This enumerated constant selects a window of statistics*/
+typedef enum {HIST_1_MIN, HIST_10_MIN, HIST_1_HOUR, HIST_WINDOWS} HIST_WindowType;
+
+/**
+ * Struct HIST_SampleType is one sample of the ring
+ * **/
+typedef struct{
+	/*scheduler tick (SCHED_ticks()) when the sample was taken*/
+	uint32 timeStamp;
+	/*temperature in Celsius degrees and frequency in Hz, indexed by HIST_ChannelType*/
+	float value[HIST_CHANNELS];
+}HIST_SampleType;
+
+/**
+ * Struct HIST_StatsType has the statistics of a channel over a window
+ * **/
+typedef struct{
+	/*number of samples in the window, less than its length only during the first minutes*/
+	uint16 count;
+	/*smallest and largest value*/
+	float min;
+	float max;
+	/*mean and (population) variance*/
+	float mean;
+	float variance;
+}HIST_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function empties the history and starts the sampling timer. SCHED_init()
+ 	 must be called before
+ 	 \return void
+ */
+void HIST_init();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function records a sample, and updates the statistics of every window.
+ 	 It is called by the sampling timer, and it may be called directly to record a sample
+ 	 out of period
+ 	 \param[in] timeStamp - scheduler tick of the sample
+ 	 \param[in] temperature - temperature in Celsius degrees
+ 	 \param[in] frec - frequency in Hz
+ 	 \return void
+ */
+void HIST_record(uint32 timeStamp, float temperature, float frec);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the statistics of a channel over a window. If no sample
+ 	 was recorded yet, count is 0 and the rest of the members are 0
+ 	 \param[in] channel - value of the samples
+ 	 \param[in] window - window of the statistics
+ 	 \param[out] stats - statistics
+ 	 \return void
+ */
+void HIST_stats(HIST_ChannelType channel, HIST_WindowType window, HIST_StatsType* stats);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the number of samples in the ring
+ 	 \return uint16 - samples that can be read, up to HIST_SAMPLES
+ */
+uint16 HIST_count();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns a sample of the ring
+ 	 \param[in] age - 0 for the newest sample, up to HIST_count() - 1 for the oldest one
+ 	 \return const HIST_SampleType* - the sample, 0 if age is not below HIST_count()
+ */
+const HIST_SampleType* HIST_sample(uint16 age);
+
+#endif /* SOURCES_HIST_H_ */
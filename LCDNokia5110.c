@@ -8,8 +8,31 @@
 #include "GPIO.h"
 #include "SPI.h"
 #include "LCDNokia5110.h"
+#include "DELAY.h"
+#ifdef LCD_BENCHMARK
+#include "PIT.h"
+#endif
 
+/*Handles of the control pins, so writing them is a single store*/
+static const GPIO_PinType LCD_dataOrCmdPin = GPIO_PIN(PTD, DATA_OR_CMD_PIN);
+static const GPIO_PinType LCD_resetPin = GPIO_PIN(PTD, RESET_PIN);
 
+/*Copy of the LCD memory, the text functions draw here*/
+static uint8 LCD_frame[LCD_ROWS][LCD_X];
+/*Position in the frame where the next byte is written*/
+static uint8 LCD_column = 0;
+static uint8 LCD_row = 0;
+/*Columns of each row that changed since the last flush, none if first > last*/
+static uint8 LCD_dirtyFirst[LCD_ROWS];
+static uint8 LCD_dirtyLast[LCD_ROWS];
+/*Columns of each row sent by the flushes since the last LCDNokia_mirrorTake, same rule*/
+static uint8 LCD_mirrorFirst[LCD_ROWS];
+static uint8 LCD_mirrorLast[LCD_ROWS];
+
+/*Powers of ten, to take the digits of a number from the most significant one*/
+static const uint32 LCD_power10[LCD_NUMBER_DIGITS] = {
+		1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
 
 static const uint8 ASCII[][5] =
 {
@@ -112,22 +135,65 @@ static const uint8 ASCII[][5] =
 };
 
 
+/*Mark the whole frame to be sent, when the LCD memory isn't known*/
+static void LCDNokia_frameInvalidate(void) {
+	uint8 row;
+
+	for(row = 0; row < LCD_ROWS; row++){
+		LCD_dirtyFirst[row] = 0;
+		LCD_dirtyLast[row] = LCD_X - 1;
+		LCD_mirrorFirst[row] = LCD_X;
+		LCD_mirrorLast[row] = 0;
+	}
+}
+
+/*Write a byte in the frame, it is marked to be sent only if it changed*/
+static void LCDNokia_frameSet(uint8 row, uint8 column, uint8 data) {
+	uint8* frameByte = &LCD_frame[row][column];
+
+	if(*frameByte != data){
+		*frameByte = data;
+		if(column < LCD_dirtyFirst[row]){
+			LCD_dirtyFirst[row] = column;
+		}
+		if(column > LCD_dirtyLast[row]){
+			LCD_dirtyLast[row] = column;
+		}
+	}
+}
+
+/*Write a byte in the frame at the cursor. Like the LCD, the cursor goes to the next row
+ * after the last column*/
+static void LCDNokia_frameWrite(uint8 data) {
+	LCDNokia_frameSet(LCD_row, LCD_column, data);
+	if(++LCD_column >= LCD_X){
+		LCD_column = 0;
+		if(++LCD_row >= LCD_ROWS){
+			LCD_row = 0;
+		}
+	}
+}
+
+/*Write a glyph of the font in the frame, with its blank padding*/
+static void LCDNokia_frameGlyph(const uint8* glyph) {
+	uint8 index;
+
+	LCDNokia_frameWrite(0x00); //Blank vertical line padding
+	for(index = 0; index < 5; index++){
+		LCDNokia_frameWrite(glyph[index]);
+	}
+	LCDNokia_frameWrite(0x00); //Blank vertical line padding
+}
+
 void LCDNokia_init(void) {
-	GPIO_pinControlRegisterType pinControlRegister = GPIO_MUX1;
+  //The control pins are configured by BOARD_init()
 
-	GPIO_clockGating(GPIOD);
-	GPIO_dataDirectionPIN(GPIOD,GPIO_OUTPUT,DATA_OR_CMD_PIN);
-	GPIO_pinControlRegister(GPIOD,BIT3,&pinControlRegister);
-	
-	GPIO_clockGating(GPIOD);
-	GPIO_dataDirectionPIN(GPIOD,GPIO_OUTPUT,RESET_PIN);
-	GPIO_pinControlRegister(GPIOD,RESET_PIN,&pinControlRegister);
-  //Configure control pins
-	
+	//The LCD memory is unknown after the reset, the first flush sends the whole frame
+	LCDNokia_frameInvalidate();
 
-	GPIO_clearPIN(GPIOD, RESET_PIN);
+	GPIO_pinClear(&LCD_resetPin);
 	LCD_delay();
-	GPIO_setPIN(GPIOD, RESET_PIN);
+	GPIO_pinSet(&LCD_resetPin);
 	LCDNokia_writeByte(LCD_CMD, 0x21); //Tell LCD that extended commands follow
 	LCDNokia_writeByte(LCD_CMD, 0xBF); //Set LCD Vop (Contrast): Try 0xB1(good @ 3.3V) or 0xBF if your display is too dark
 	LCDNokia_writeByte(LCD_CMD, 0x04); //Set Temp coefficent
@@ -140,33 +206,26 @@ void LCDNokia_init(void) {
 void LCDNokia_bitmap(const uint8* my_array){
 	uint16 index=0;
   for (index = 0 ; index < (LCD_X * LCD_Y / 8) ; index++)
-	  LCDNokia_writeByte(LCD_DATA, *(my_array+index));
+	  LCDNokia_frameWrite(*(my_array+index));
 }
 
 
 
 void LCDNokia_writeByte(uint8 DataOrCmd, uint8 data)
 {
-	if(DataOrCmd)
-		GPIO_setPIN(GPIOD, DATA_OR_CMD_PIN);
-	else
-		GPIO_clearPIN(GPIOD, DATA_OR_CMD_PIN);
+	GPIO_pinWrite(&LCD_dataOrCmdPin, DataOrCmd);
 	
 	SPI_startTranference(SPI_0);
-	SPI_sendOneByte(SPI_0,data);
+	SPI_sendByte(SPI0,data);
 	SPI_stopTranference(SPI_0);
+#ifdef LCD_CAPTURE
+	LCDNokia_capture(DataOrCmd, data);
+#endif
 }
 
 void LCDNokia_sendChar(uint8 character) {
-  uint16 index = 0; 
-	
-  LCDNokia_writeByte(LCD_DATA, 0x00); //Blank vertical line padding
-
-  for (index = 0 ; index < 5 ; index++)
-	  LCDNokia_writeByte(LCD_DATA, ASCII[character - 0x20][index]);
-    //0x20 is the ASCII character for Space (' '). The font table starts with this character
-
-  LCDNokia_writeByte(LCD_DATA, 0x00); //Blank vertical line padding
+  //0x20 is the ASCII character for Space (' '). The font table starts with this character
+  LCDNokia_frameGlyph(ASCII[character - 0x20]);
 }
 
 void LCDNokia_sendString(uint8 *characters) {
@@ -174,25 +233,209 @@ void LCDNokia_sendString(uint8 *characters) {
 	  LCDNokia_sendChar(*characters++);
 }
 
+uint8 LCDNokia_sendNumber(sint32 value, const LCD_NumberFormatType* format) {
+	uint32 magnitude = (value < 0) ? (uint32)0 - (uint32)value : (uint32)value;
+	uint8 index = format->width;
+	uint8 count = 0;
+	uint8 digit;
+
+	if(value < 0){
+		LCDNokia_sendChar('-');
+		count++;
+	}
+	//The digits that don't fit are dropped
+	if(index < LCD_NUMBER_DIGITS){
+		magnitude %= LCD_power10[index];
+	}
+	//From the most significant digit, the point goes before the first decimal
+	while(index-- > 0){
+		if(format->decimals && (index + 1 == format->decimals)){
+			LCDNokia_sendChar('.');
+			count++;
+		}
+		digit = magnitude / LCD_power10[index];
+		magnitude -= digit * LCD_power10[index];
+		LCDNokia_frameGlyph(ASCII['0' - 0x20 + digit]);
+		count++;
+	}
+	if(format->unit){
+		for(index = 0; format->unit[index]; index++){
+			LCDNokia_sendChar(format->unit[index]);
+			count++;
+		}
+	}
+	return count;
+}
+
 void LCDNokia_clear(void) {
 	uint16 index = 0;
+  LCDNokia_gotoXY(0, 0);
   for (index = 0 ; index < (LCD_X * LCD_Y / 8) ; index++)
-	  LCDNokia_writeByte(LCD_DATA, 0x00);
+	  LCDNokia_frameWrite(0x00);
   LCDNokia_gotoXY(0, 0); //After we clear the display, return to the home position
 }
 
 void LCDNokia_gotoXY(uint8 x, uint8 y) {
-	LCDNokia_writeByte(LCD_CMD, 0x80 | x);  // Column.
-	LCDNokia_writeByte(LCD_CMD, 0x40 | y);  // Row.  ?
+	LCD_column = (x < LCD_X) ? x : LCD_X - 1;
+	LCD_row = (y < LCD_ROWS) ? y : LCD_ROWS - 1;
+}
+
+void LCDNokia_column(uint8 x, uint64 pixels) {
+	uint8 row;
+
+	if(x >= LCD_X){
+		return;
+	}
+	for(row = 0; row < LCD_ROWS; row++){
+		LCDNokia_frameSet(row, x, (uint8)(pixels >> (8 * row)));
+	}
+}
+
+void LCDNokia_scroll(uint8 columns) {
+	uint8 row;
+	uint8 column;
+
+	for(row = 0; row < LCD_ROWS; row++){
+		for(column = 0; column + columns < LCD_X; column++){
+			LCDNokia_frameSet(row, column, LCD_frame[row][column + columns]);
+		}
+	}
+}
+
+void LCDNokia_flush(void) {
+	uint8 row;
+	uint8 column;
+
+	for(row = 0; row < LCD_ROWS; row++){
+		if(LCD_dirtyFirst[row] > LCD_dirtyLast[row]){
+			continue;
+		}
+		LCDNokia_writeByte(LCD_CMD, 0x80 | LCD_dirtyFirst[row]);  // Column.
+		LCDNokia_writeByte(LCD_CMD, 0x40 | row);  // Row.
+		for(column = LCD_dirtyFirst[row]; column <= LCD_dirtyLast[row]; column++){
+			LCDNokia_writeByte(LCD_DATA, LCD_frame[row][column]);
+		}
+		//The mirror gets the same columns, when it takes them
+		if(LCD_dirtyFirst[row] < LCD_mirrorFirst[row]){
+			LCD_mirrorFirst[row] = LCD_dirtyFirst[row];
+		}
+		if(LCD_dirtyLast[row] > LCD_mirrorLast[row]){
+			LCD_mirrorLast[row] = LCD_dirtyLast[row];
+		}
+		LCD_dirtyFirst[row] = LCD_X;
+		LCD_dirtyLast[row] = 0;
+	}
+}
+
+const uint8* LCDNokia_frame(void) {
+	return &LCD_frame[0][0];
+}
+
+uint8 LCDNokia_mirrorTake(uint8* first, uint8* last) {
+	uint8 taken = FALSE;
+	uint8 row;
+
+	for(row = 0; row < LCD_ROWS; row++){
+		first[row] = LCD_mirrorFirst[row];
+		last[row] = LCD_mirrorLast[row];
+		if(LCD_mirrorFirst[row] <= LCD_mirrorLast[row]){
+			taken = TRUE;
+		}
+		LCD_mirrorFirst[row] = LCD_X;
+		LCD_mirrorLast[row] = 0;
+	}
+	return taken;
 }
 
 void LCD_delay(void)
 {
-	int counter;
-	
-	for(counter=0; counter<1500; counter++) 
-	{	   
-		
+	DELAY_us(LCD_RESET_PULSE_US);
+}
+
+#ifdef LCD_BENCHMARK
+/*Same as LCDNokia_writeByte, with the D/C pin written through the out-of-line GPIO functions*/
+static void LCDNokia_writeByteLegacy(uint8 DataOrCmd, uint8 data)
+{
+	if(DataOrCmd)
+		GPIO_setPIN(GPIOD, DATA_OR_CMD_PIN);
+	else
+		GPIO_clearPIN(GPIOD, DATA_OR_CMD_PIN);
+
+	SPI_startTranference(SPI_0);
+	SPI_sendOneByte(SPI_0,data);
+	SPI_stopTranference(SPI_0);
+}
+
+/*The string path: the number is formatted to characters as SDF had them, and each character
+ * is sent to the LCD, 7 bytes per glyph*/
+static void LCDNokia_sendNumberLegacy(uint32 value, const LCD_NumberFormatType* format)
+{
+	char characters[LCD_NUMBER_DIGITS + 2];
+	uint8 length = 0;
+	uint8 index = format->width;
+	uint8 column;
+
+	while(index-- > 0){
+		if(format->decimals && (index + 1 == format->decimals)){
+			characters[length++] = '.';
+		}
+		characters[length++] = (char)((value / LCD_power10[index]) % 10) + 48;
 	}
+	characters[length] = 0;
+
+	for(index = 0; characters[index]; index++){
+		LCDNokia_writeByteLegacy(LCD_DATA, 0x00);
+		for(column = 0; column < 5; column++){
+			LCDNokia_writeByteLegacy(LCD_DATA, ASCII[characters[index] - 0x20][column]);
+		}
+		LCDNokia_writeByteLegacy(LCD_DATA, 0x00);
+	}
+}
+
+/*Bytes per second, from the lifetime ticks that LCD_BENCHMARK_BYTES bytes took*/
+static uint32 LCDNokia_bytesPerSecond(uint32 ticks){
+	return (uint32)(((uint64)LCD_BENCHMARK_BYTES * SYSTEM_CLOCK) / (ticks ? ticks : 1));
+}
+
+void LCDNokia_benchmark(LCD_BenchmarkType* result){
+	static const LCD_NumberFormatType format = {5, 2, 0};
+	uint32 start;
+	uint16 index;
+
+	/*The commands only set the column to 0, so the screen configuration isn't changed*/
+	start = PIT_lifetimeRead32();
+	for(index = 0; index < LCD_BENCHMARK_BYTES; index++){
+		LCDNokia_writeByte(index & 1, (index & 1) ? 0x00 : 0x80);
+	}
+	result->fastBytesPerSecond = LCDNokia_bytesPerSecond(PIT_lifetimeRead32() - start);
+
+	start = PIT_lifetimeRead32();
+	for(index = 0; index < LCD_BENCHMARK_BYTES; index++){
+		LCDNokia_writeByteLegacy(index & 1, (index & 1) ? 0x00 : 0x80);
+	}
+	result->legacyBytesPerSecond = LCDNokia_bytesPerSecond(PIT_lifetimeRead32() - start);
+
+	/*A temperature field, with a different value each time so every pass draws something*/
+	start = PIT_lifetimeRead32();
+	for(index = 0; index < LCD_BENCHMARK_FIELDS; index++){
+		LCDNokia_writeByteLegacy(LCD_CMD, 0x80);
+		LCDNokia_writeByteLegacy(LCD_CMD, 0x40);
+		LCDNokia_sendNumberLegacy(2000 + 37*index, &format);
+	}
+	result->stringFieldCycles = (PIT_lifetimeRead32() - start) / LCD_BENCHMARK_FIELDS;
+
+	start = PIT_lifetimeRead32();
+	for(index = 0; index < LCD_BENCHMARK_FIELDS; index++){
+		LCDNokia_gotoXY(0, 0);
+		LCDNokia_sendNumber(2000 + 37*index, &format);
+		LCDNokia_flush();
+	}
+	result->blitFieldCycles = (PIT_lifetimeRead32() - start) / LCD_BENCHMARK_FIELDS;
+
+	/*The LCD memory no longer matches the frame*/
+	LCDNokia_frameInvalidate();
+	LCDNokia_clear();
+	LCDNokia_flush();
 }
+#endif
 
@@ -18,25 +18,92 @@
 #define LCD_CMD 0
 #define DATA_OR_CMD_PIN 3
 #define RESET_PIN 0
-/*It configures the LCD*/
+/*Length of the reset pulse, in microseconds*/
+#define LCD_RESET_PULSE_US 1000
+/*Bytes written by each pass of LCDNokia_benchmark*/
+#define LCD_BENCHMARK_BYTES 504
+/*Fields written by each pass of the field benchmark of LCDNokia_benchmark*/
+#define LCD_BENCHMARK_FIELDS 32
+/*Rows of the LCD memory, each byte of a row is a column of 8 pixels*/
+#define LCD_ROWS (LCD_Y / 8)
+/*Largest number of digits of LCDNokia_sendNumber*/
+#define LCD_NUMBER_DIGITS 10
+
+/*Format of a number written by LCDNokia_sendNumber*/
+typedef struct{
+	/*number of digits, including the decimals, the leading ones are written as 0. Digits
+	 * beyond width are dropped*/
+	uint8 width;
+	/*number of digits after the decimal point, 0 for no point*/
+	uint8 decimals;
+	/*text written right after the number, 0 for none*/
+	const char* unit;
+}LCD_NumberFormatType;
+
+/*It configures the LCD. The text functions below draw in a copy of the LCD memory (the frame),
+ * and LCDNokia_flush sends to the LCD only the bytes of the frame that changed*/
 void LCDNokia_init(void);
 /*It writes a byte in the LCD memory. The place of writting is the last place that was indicated by LCDNokia_gotoXY. In the reset state
  * the initial place is x=0 y=0*/
 void LCDNokia_writeByte(uint8, uint8);
-/*it clears all the figures in the LCD*/
+/*it clears all the figures in the frame*/
 void LCDNokia_clear(void);
-/*It is used to indicate the place for writing a new character in the LCD. The values that x can take are 0 to 84 and y can take values
+/*It is used to indicate the place for writing a new character in the frame. The values that x can take are 0 to 84 and y can take values
  * from 0 to 5*/
 void LCDNokia_gotoXY(uint8 x, uint8 y);
-/*It allows to write a figure represented by constant array*/
+/*It allows to write a figure represented by constant array in the frame*/
 void LCDNokia_bitmap(const uint8*);
-/*It write a character in the LCD*/
+/*It write a character in the frame*/
 void LCDNokia_sendChar(uint8);
-/*It write a string into the LCD*/
+/*It write a string into the frame*/
 void LCDNokia_sendString(uint8*);
-/*It used in the initialisation routine*/
+/*It writes a number into the frame with the format given; the glyph of each digit is copied
+ * from the font to the frame, with no string in between. It returns the number of characters
+ * written, the unit included*/
+uint8 LCDNokia_sendNumber(sint32 value, const LCD_NumberFormatType* format);
+/*It writes the column x of the frame, all its rows. Bit 0 of pixels is the top pixel and bit
+ * LCD_Y - 1 the bottom one*/
+void LCDNokia_column(uint8 x, uint64 pixels);
+/*It moves the frame to the left by the number of columns given, the last columns keep what they
+ * had and are meant to be written next. The flush sends, in each row, the span from the first to
+ * the last byte that changed, which after a scroll is most of the row*/
+void LCDNokia_scroll(uint8 columns);
+/*It sends to the LCD the bytes of the frame that changed since the last flush*/
+void LCDNokia_flush(void);
+/*It returns the frame, LCD_ROWS rows of LCD_X bytes one after the other*/
+const uint8* LCDNokia_frame(void);
+/*It takes the columns of each row that the flushes sent since the last call, first[row] to
+ * last[row] (none if first > last), so a copy of the LCD elsewhere (the screen mirror) is kept
+ * with the same dirty tracking. It returns FALSE if no column was sent*/
+uint8 LCDNokia_mirrorTake(uint8* first, uint8* last);
+/*It used in the initialisation routine, it waits LCD_RESET_PULSE_US*/
 void LCD_delay(void);
 
+#ifdef LCD_CAPTURE
+/*Host builds only (tools/lcdhost.c): it is called by LCDNokia_writeByte with each byte sent
+ * to the LCD and the level of the D/C pin, and defined by the program that captures them*/
+void LCDNokia_capture(uint8 DataOrCmd, uint8 data);
+#endif
+
+#ifdef LCD_BENCHMARK
+/*Result of LCDNokia_benchmark, in bytes per second*/
+typedef struct{
+	/*with the D/C pin on the inline fast path*/
+	uint32 fastBytesPerSecond;
+	/*with the D/C pin through GPIO_setPIN/GPIO_clearPIN*/
+	uint32 legacyBytesPerSecond;
+	/*bus clock cycles to draw a 5 digit field with 2 decimals, formatting it to a string and
+	 * sending each character to the LCD*/
+	uint32 stringFieldCycles;
+	/*bus clock cycles to draw the same field with LCDNokia_sendNumber and LCDNokia_flush*/
+	uint32 blitFieldCycles;
+}LCD_BenchmarkType;
+/*It measures the byte throughput of the LCD, writing LCD_BENCHMARK_BYTES bytes that toggle
+ * the D/C pin every time (worst case), and the cycles per field of both ways to draw a number,
+ * averaged over LCD_BENCHMARK_FIELDS different values. The screen is cleared at the end*/
+void LCDNokia_benchmark(LCD_BenchmarkType* result);
+#endif
+
 
 
 #endif /* LCDNOKIA5110_H_ */
@@ -0,0 +1,249 @@
+/**
+	\file
+	\brief
+		This is the source file for the sample log. The blocks are used as a ring: LOG_oldest
+		is the oldest block and the last block in use is the one being written. Besides the
+		header in each block, the index keeps the first timestamp and the length of every
+		block, so a block is found by time without decoding anything.
+	\date	19/10/2026
+ */
+
+#include "LOG.h"
+
+/*Offsets of the members of the header of a block*/
+#define LOG_TIME_OFFSET 0
+#define LOG_TEMPERATURE_OFFSET 4
+#define LOG_FREC_OFFSET 8
+#define LOG_COUNT_OFFSET 12
+
+/*Blocks of the log*/
+static uint8 LOG_block[LOG_BLOCKS][LOG_BLOCK_SIZE];
+
+/*Index of the blocks: first timestamp and bytes used of each one*/
+static uint32 LOG_firstTime[LOG_BLOCKS];
+static uint16 LOG_length[LOG_BLOCKS];
+
+/*Oldest block, and number of blocks in use*/
+static uint16 LOG_oldest = 0;
+static uint16 LOG_used = 0;
+
+/*Last sample written, and the interval before it, the next sample is stored as the
+ * difference from them*/
+static LOG_SampleType LOG_last;
+static uint32 LOG_interval = 0;
+
+/*Size of the log*/
+static LOG_StatsType LOG_size = {0, 0, 0};
+
+/*Write value in little endian*/
+static void LOG_put(uint8* data, uint32 value, uint8 bytes){
+	while(bytes--){
+		*data++ = (uint8)value;
+		value >>= 8;
+	}
+}
+
+/*Read a value in little endian*/
+static uint32 LOG_get(const uint8* data, uint8 bytes){
+	uint32 value = 0;
+
+	while(bytes--){
+		value = (value << 8) | data[bytes];
+	}
+	return value;
+}
+
+/*Small values, positive or negative, have small zig-zag codes*/
+static uint32 LOG_zigzag(sint32 value){
+	return ((uint32)value << 1) ^ (uint32)(value >> 31);
+}
+
+static sint32 LOG_unzigzag(uint32 code){
+	return (sint32)((code >> 1) ^ ((uint32)0 - (code & 1)));
+}
+
+/*Write a varint, 7 bits per byte, returns the offset after it*/
+static uint16 LOG_putVarint(uint8* data, uint16 offset, uint32 code){
+	while(code >= 0x80){
+		data[offset++] = (uint8)(code | 0x80);
+		code >>= 7;
+	}
+	data[offset++] = (uint8)code;
+	return offset;
+}
+
+/*Read a varint, returns the offset after it*/
+static uint16 LOG_getVarint(const uint8* data, uint16 offset, uint32* value){
+	uint32 code = 0;
+	uint8 shift = 0;
+	uint8 byte;
+
+	do{
+		byte = data[offset++];
+		code |= (uint32)(byte & 0x7F) << shift;
+		shift += 7;
+	}while((byte & 0x80) && (shift < 35));
+	*value = code;
+	return offset;
+}
+
+/*Physical block of a position in the log, 0 is the oldest block*/
+static uint16 LOG_physical(uint16 block){
+	block += LOG_oldest;
+	return (block >= LOG_BLOCKS) ? block - LOG_BLOCKS : block;
+}
+
+/*Value in hundredths, rounded*/
+static sint32 LOG_fixed(float value){
+	value *= 100;
+	return (sint32)((value >= 0) ? value + 0.5f : value - 0.5f);
+}
+
+/*Start a new block with sample as its first sample, reusing the oldest block if needed*/
+static void LOG_blockStart(const LOG_SampleType* sample){
+	uint16 block;
+
+	if(LOG_BLOCKS == LOG_used){
+		block = LOG_oldest;
+		LOG_size.samples -= LOG_get(&LOG_block[block][LOG_COUNT_OFFSET], 2);
+		LOG_size.dropped += LOG_get(&LOG_block[block][LOG_COUNT_OFFSET], 2);
+		LOG_size.bytes -= LOG_length[block];
+		LOG_oldest = LOG_physical(1);
+		LOG_used--;
+	}
+	block = LOG_physical(LOG_used);
+	LOG_used++;
+
+	LOG_put(&LOG_block[block][LOG_TIME_OFFSET], sample->timeStamp, 4);
+	LOG_put(&LOG_block[block][LOG_TEMPERATURE_OFFSET], (uint32)sample->temperature, 4);
+	LOG_put(&LOG_block[block][LOG_FREC_OFFSET], (uint32)sample->frec, 4);
+	LOG_put(&LOG_block[block][LOG_COUNT_OFFSET], 1, 2);
+	LOG_firstTime[block] = sample->timeStamp;
+	LOG_length[block] = LOG_HEADER_SIZE;
+	LOG_interval = 0;
+
+	LOG_size.samples++;
+	LOG_size.bytes += LOG_HEADER_SIZE;
+}
+
+void LOG_init(){
+	uint16 block;
+
+	for(block = 0; block < LOG_BLOCKS; block++){
+		LOG_put(&LOG_block[block][LOG_COUNT_OFFSET], 0, 2);
+	}
+	LOG_oldest = 0;
+	LOG_used = 0;
+	LOG_interval = 0;
+	LOG_size.samples = 0;
+	LOG_size.bytes = 0;
+	LOG_size.dropped = 0;
+}
+
+void LOG_append(uint32 timeStamp, float temperature, float frec){
+	LOG_SampleType sample = {timeStamp, LOG_fixed(temperature), LOG_fixed(frec)};
+	uint16 block;
+	uint16 length;
+	uint16 count;
+	uint32 interval;
+	sint32 change;
+	uint32 code;
+
+	/*A new block if there is none, or the sample may not fit in the current one*/
+	block = LOG_physical(LOG_used ? LOG_used - 1 : 0);
+	length = LOG_length[block];
+	if((0 == LOG_used) || (length + LOG_MAX_SAMPLE_SIZE > LOG_BLOCK_SIZE)){
+		LOG_blockStart(&sample);
+		LOG_last = sample;
+		return;
+	}
+
+	/*The samples are periodic, so the interval usually doesn't change and it only takes
+	 * the lowest bit of the temperature code*/
+	interval = timeStamp - LOG_last.timeStamp;
+	change = (sint32)(interval - LOG_interval);
+	code = LOG_zigzag(sample.temperature - LOG_last.temperature) << 1;
+	length = LOG_putVarint(LOG_block[block], length, change ? code | 1 : code);
+	if(change){
+		length = LOG_putVarint(LOG_block[block], length, LOG_zigzag(change));
+	}
+	length = LOG_putVarint(LOG_block[block], length, LOG_zigzag(sample.frec - LOG_last.frec));
+	count = LOG_get(&LOG_block[block][LOG_COUNT_OFFSET], 2) + 1;
+	LOG_put(&LOG_block[block][LOG_COUNT_OFFSET], count, 2);
+
+	LOG_size.samples++;
+	LOG_size.bytes += length - LOG_length[block];
+	LOG_length[block] = length;
+	LOG_interval = interval;
+	LOG_last = sample;
+}
+
+uint8 LOG_seek(uint32 timeStamp, LOG_CursorType* cursor){
+	uint16 low = 0;
+	uint16 high = LOG_used;
+	uint16 middle;
+
+	if(0 == LOG_used){
+		return FALSE;
+	}
+	/*Last block that starts at timeStamp or before it (the first one if none does)*/
+	while(high - low > 1){
+		middle = (low + high) / 2;
+		if((sint32)(LOG_firstTime[LOG_physical(middle)] - timeStamp) <= 0){
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	cursor->block = low;
+	cursor->sample = 0;
+	cursor->offset = 0;
+	return TRUE;
+}
+
+uint8 LOG_next(LOG_CursorType* cursor, LOG_SampleType* sample){
+	const uint8* data;
+	uint32 code;
+	uint32 change;
+
+	/*Go to the next block when this one is done*/
+	while((cursor->block < LOG_used) &&
+			(cursor->sample >= LOG_get(&LOG_block[LOG_physical(cursor->block)][LOG_COUNT_OFFSET], 2))){
+		cursor->block++;
+		cursor->sample = 0;
+	}
+	if(cursor->block >= LOG_used){
+		return FALSE;
+	}
+	data = LOG_block[LOG_physical(cursor->block)];
+
+	if(0 == cursor->sample){
+		/*The first sample is in the header*/
+		cursor->last.timeStamp = LOG_get(&data[LOG_TIME_OFFSET], 4);
+		cursor->last.temperature = (sint32)LOG_get(&data[LOG_TEMPERATURE_OFFSET], 4);
+		cursor->last.frec = (sint32)LOG_get(&data[LOG_FREC_OFFSET], 4);
+		cursor->interval = 0;
+		cursor->offset = LOG_HEADER_SIZE;
+	} else {
+		cursor->offset = LOG_getVarint(data, cursor->offset, &code);
+		if(code & 1){
+			cursor->offset = LOG_getVarint(data, cursor->offset, &change);
+			cursor->interval += LOG_unzigzag(change);
+		}
+		cursor->last.timeStamp += cursor->interval;
+		cursor->last.temperature += LOG_unzigzag(code >> 1);
+		cursor->offset = LOG_getVarint(data, cursor->offset, &code);
+		cursor->last.frec += LOG_unzigzag(code);
+	}
+	cursor->sample++;
+	*sample = cursor->last;
+	return TRUE;
+}
+
+void LOG_stats(LOG_StatsType* stats){
+	*stats = LOG_size;
+}
+
+const uint8* LOG_blocks(){
+	return &LOG_block[0][0];
+}
@@ -0,0 +1,149 @@
+/**
+	\file
+	\brief
+		This is the header file for the sample log. It keeps a long record of the
+		temperature and the frequency in RAM, compressed in blocks of LOG_BLOCK_SIZE bytes.
+		Each block starts with a header that has its first sample in full; the next samples
+		are stored as differences from the previous one, in fixed point, with zig-zag
+		varints: the temperature in hundredths of degree, the frequency in hundredths of Hz
+		and, only when the sampling interval changed, the change of the interval. A
+		slow-moving sample takes 2 bytes, instead of the 12 of a raw one. When every block
+		is used, the oldest one is reused.
+
+		Block layout (little endian), that tools/logdecode.c also follows:
+		 - uint32 timestamp of the first sample, in scheduler ticks (ms)
+		 - sint32 temperature of the first sample, hundredths of Celsius degree
+		 - sint32 frequency of the first sample, hundredths of Hz
+		 - uint16 number of samples in the block, the first one included (0 if unused)
+		 - for each of the next samples, the varints:
+		 	 1. (zig-zag change of the temperature << 1) | 1 if the interval changed
+		 	 2. zig-zag change of the interval between samples, only if the bit above is 1
+		 	 3. zig-zag change of the frequency
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_LOG_H_
+#define SOURCES_LOG_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+
+/** Size of a block, in bytes */
+#define LOG_BLOCK_SIZE 256
+/** Number of blocks (16 KB in total) */
+#define LOG_BLOCKS 64
+/** Size of the header of a block, in bytes */
+#define LOG_HEADER_SIZE 14
+/** Largest size of a sample after the first one: three varints of up to 5 bytes */
+#define LOG_MAX_SAMPLE_SIZE 15
+/** Size of a sample without compression (HIST_SampleType), to compute the ratio */
+#define LOG_RAW_SAMPLE_SIZE 12
+
+/**
+ * Struct LOG_SampleType is a sample, as it is kept by the log
+ * **/
+typedef struct{
+	/*scheduler tick (SCHED_ticks()) when the sample was taken*/
+	uint32 timeStamp;
+	/*temperature, in hundredths of Celsius degree*/
+	sint32 temperature;
+	/*frequency, in hundredths of Hz*/
+	sint32 frec;
+}LOG_SampleType;
+
+/**
+ * Struct LOG_CursorType is a position in the log, to read the samples in order. The
+ * members are private to the log.
+ * **/
+typedef struct{
+	/*position of the block in the log, 0 is the oldest block*/
+	uint16 block;
+	/*samples of the block already read*/
+	uint16 sample;
+	/*next byte to decode in the block*/
+	uint16 offset;
+	/*last sample read, and the interval before it*/
+	LOG_SampleType last;
+	sint32 interval;
+}LOG_CursorType;
+
+/**
+ * Struct LOG_StatsType tells how well the log compresses
+ * **/
+typedef struct{
+	/*samples that the log has*/
+	uint32 samples;
+	/*bytes that they take, headers included*/
+	uint32 bytes;
+	/*samples that were dropped when the oldest block was reused*/
+	uint32 dropped;
+}LOG_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function empties the log
+ 	 \return void
+ */
+void LOG_init();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function adds a sample at the end of the log, in O(1). It is called from
+ 	 the sampling of HIST, the timestamps must not go back
+ 	 \param[in] timeStamp - scheduler tick of the sample
+ 	 \param[in] temperature - temperature in Celsius degrees
+ 	 \param[in] frec - frequency in Hz
+ 	 \return void
+ */
+void LOG_append(uint32 timeStamp, float temperature, float frec);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function places a cursor at the start of the block that has the sample
+ 	 taken at timeStamp, or the closest one before it. The block is found with a binary
+ 	 search in the index of the blocks
+ 	 \param[in] timeStamp - scheduler tick to look for
+ 	 \param[out] cursor - cursor for LOG_next()
+ 	 \return uint8 - FALSE if the log is empty
+ */
+uint8 LOG_seek(uint32 timeStamp, LOG_CursorType* cursor);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function reads the sample at the cursor, and moves the cursor to the next
+ 	 one
+ 	 \param[in,out] cursor - cursor placed by LOG_seek()
+ 	 \param[out] sample - sample read
+ 	 \return uint8 - FALSE if there are no more samples
+ */
+uint8 LOG_next(LOG_CursorType* cursor, LOG_SampleType* sample);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the size of the log and its samples
+ 	 \param[out] stats - samples and bytes
+ 	 \return void
+ */
+void LOG_stats(LOG_StatsType* stats);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the memory of the blocks, to dump it (for example, with
+ 	 the debugger) and decode it with tools/logdecode.c
+ 	 \return const uint8* - LOG_BLOCKS blocks of LOG_BLOCK_SIZE bytes
+ */
+const uint8* LOG_blocks();
+
+#endif /* SOURCES_LOG_H_ */
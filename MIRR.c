@@ -0,0 +1,118 @@
+/**
+	\file
+	\brief
+		This is the source file for the screen mirror. The frame is built only when the
+		DMA is done with the previous one, so a single buffer is enough, as in the
+		telemetry. If the transmitter is busy, the columns are not taken from the LCD
+		driver, they keep adding up for the next period.
+	\date	19/10/2026
+ */
+
+#include "MIRR.h"
+#include "UART.h"
+#include "SCHED.h"
+#include "CRC.h"
+
+/*Timer of the frames*/
+static SCHED_TimerType MIRR_timer;
+/*Frame being built, and encoded as the DMA sends it*/
+static uint8 MIRR_frame[MIRR_FRAME_SIZE];
+static uint8 MIRR_encoded[MIRR_ENCODED_SIZE];
+/*Sequence number of the next frame, and periods until the next frame with the whole screen*/
+static uint8 MIRR_sequence = 0;
+static uint8 MIRR_keyCountdown = 0;
+static MIRR_StatsType MIRR_statistics = {0, 0, 0, 0};
+
+/*Compress bytes with RLE, returns the size of the result*/
+static uint16 MIRR_rle(const uint8* data, uint8 length, uint8* out){
+	uint16 size = 0;
+	uint8 index = 0;
+	uint8 start;
+	uint8 run;
+
+	while(index < length){
+		for(run = 1; (index + run < length) && (data[index + run] == data[index]) && (run < MIRR_RUN_MAX); run++);
+		if(run >= MIRR_RUN_MIN){
+			out[size++] = 0x80 + run - MIRR_RUN_MIN;
+			out[size++] = data[index];
+			index += run;
+			continue;
+		}
+		/*The bytes as they are, until a run starts*/
+		start = index;
+		while((index < length) && (index - start < MIRR_LITERAL_MAX)){
+			if((index + 2 < length) && (data[index] == data[index + 1]) && (data[index] == data[index + 2])){
+				break;
+			}
+			index++;
+		}
+		out[size++] = index - start - 1;
+		while(start < index){
+			out[size++] = data[start++];
+		}
+	}
+	return size;
+}
+
+/*Period of the frames, send the columns that changed if the DMA is done with the
+ * previous frame*/
+static void MIRR_send(){
+	uint8 first[LCD_ROWS];
+	uint8 last[LCD_ROWS];
+	const uint8* screen;
+	uint16 size = MIRR_HEADER;
+	uint16 crc;
+	uint8 key = FALSE;
+	uint8 row;
+
+	if(UART_sendBusy()){
+		MIRR_statistics.busy++;
+		return;
+	}
+	if(0 == MIRR_keyCountdown){
+		MIRR_keyCountdown = MIRR_KEY_PERIODS;
+		key = TRUE;
+	}
+	MIRR_keyCountdown--;
+	/*The columns are taken also for a key frame, they are in it*/
+	if(!LCDNokia_mirrorTake(first, last) && !key){
+		return;
+	}
+
+	MIRR_frame[0] = MIRR_KIND_FRAME;
+	MIRR_frame[1] = MIRR_sequence++;
+	MIRR_frame[2] = key ? MIRR_FLAG_KEY : 0;
+	screen = LCDNokia_frame();
+	for(row = 0; row < LCD_ROWS; row++){
+		if(key){
+			first[row] = 0;
+			last[row] = LCD_X - 1;
+		} else if(first[row] > last[row]){
+			continue;
+		}
+		MIRR_frame[size++] = row;
+		MIRR_frame[size++] = first[row];
+		MIRR_frame[size++] = last[row] - first[row] + 1;
+		size += MIRR_rle(&screen[row * LCD_X + first[row]], last[row] - first[row] + 1, &MIRR_frame[size]);
+		MIRR_statistics.screenBytes += last[row] - first[row] + 1;
+	}
+	crc = CRC_ccitt(CRC_INIT, MIRR_frame, size);
+	MIRR_frame[size++] = (uint8)crc;
+	MIRR_frame[size++] = (uint8)(crc >> 8);
+	size = COBS_encode(MIRR_frame, size, MIRR_encoded);
+	UART_send(MIRR_encoded, size);
+	MIRR_statistics.frames++;
+	MIRR_statistics.frameBytes += size;
+}
+
+void MIRR_init(uint16 period){
+	SCHED_timerStop(&MIRR_timer);
+	MIRR_keyCountdown = 0;
+	if(period){
+		SCHED_timerStart(&MIRR_timer, period, period, MIRR_send);
+	}
+}
+
+void MIRR_stats(MIRR_StatsType* stats){
+	*stats = MIRR_statistics;
+}
@@ -0,0 +1,86 @@
+/**
+	\file
+	\brief
+		This is the header file for the screen mirror, that sends what the LCD shows through
+		the serial port. Every period, if the transmitter is free, it takes from the LCD
+		driver the columns that its flushes sent since the previous mirror frame (the same
+		dirty tracking of the LCD), and sends only them, each row span compressed with RLE.
+		Every MIRR_KEY_PERIODS periods the whole screen is sent, so a viewer that started
+		late or lost a frame is right again. The frames are COBS frames with a CRC, like the
+		telemetry frames (TLM.h), that share the serial port with them.
+
+		Frame layout, before COBS:
+		 - uint8 MIRR_KIND_FRAME
+		 - uint8 sequence number, one more every frame sent
+		 - uint8 flags, MIRR_FLAG_KEY if the frame has the whole screen
+		 - the spans, one after the other: uint8 row, uint8 first column, uint8 number of
+		   columns, and the bytes of the columns (as in the LCD memory, bit 0 is the top
+		   pixel) compressed with RLE
+		 - uint16 CRC_ccitt() of the bytes above
+
+		RLE: a control byte c below 0x80 is followed by c + 1 bytes as they are; a control
+		byte c from 0x80 is followed by a byte that repeats c - 0x80 + MIRR_RUN_MIN times.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_MIRR_H_
+#define SOURCES_MIRR_H_
+
+#include "DataTypeDefinitions.h"
+#include "COBS.h"
+#include "LCDNokia5110.h"
+
+/** Kind of the mirror frame */
+#define MIRR_KIND_FRAME 0x20
+/** Flag of the frame with the whole screen */
+#define MIRR_FLAG_KEY 0x01
+/** Periods between two frames with the whole screen */
+#define MIRR_KEY_PERIODS 50
+/** Shortest run of RLE, and the longest one and the longest literal */
+#define MIRR_RUN_MIN 3
+#define MIRR_RUN_MAX (0x7F + MIRR_RUN_MIN)
+#define MIRR_LITERAL_MAX 0x80
+/** Size of the header of a frame and of a span, and of the CRC */
+#define MIRR_HEADER 3
+#define MIRR_SPAN_HEADER 3
+#define MIRR_CRC_SIZE 2
+/** Largest frame, the whole screen with no run, and encoded */
+#define MIRR_FRAME_SIZE (MIRR_HEADER + LCD_ROWS * (MIRR_SPAN_HEADER + LCD_X + \
+		(LCD_X + MIRR_LITERAL_MAX - 1) / MIRR_LITERAL_MAX) + MIRR_CRC_SIZE)
+#define MIRR_ENCODED_SIZE COBS_MAX_SIZE(MIRR_FRAME_SIZE)
+
+/**
+ * Struct MIRR_StatsType tells how the mirror is doing
+ * **/
+typedef struct{
+	/*frames sent*/
+	uint32 frames;
+	/*bytes of the screen sent, and bytes of the frames*/
+	uint32 screenBytes;
+	uint32 frameBytes;
+	/*periods skipped because the transmitter was busy*/
+	uint32 busy;
+}MIRR_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts the mirror, the first frame has the whole screen.
+ 	 UART_init() must be called before
+ 	 \param[in] period - ms between frames, 0 stops the mirror
+ 	 \return void
+ */
+void MIRR_init(uint16 period);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the statistics of the mirror
+ 	 \param[out] stats - frames and bytes sent
+ 	 \return void
+ */
+void MIRR_stats(MIRR_StatsType* stats);
+
+#endif /* SOURCES_MIRR_H_ */
@@ -0,0 +1,275 @@
+/**
+	\file
+	\brief
+		This is the source file for the settings store. A record is written a phrase at a
+		time; NVS_poll() starts the next phrase (or the erase of the next sector) when the
+		flash is done with the previous command. The sequence number of a new record is the
+		newest one plus one, so the newest record is the one with the largest number,
+		whatever the sector it is in.
+	\date	19/10/2026
+ */
+
+#include "NVS.h"
+#include "CRC.h"
+
+/*Offsets of the members of a record*/
+#define NVS_SEQUENCE_OFFSET 0
+#define NVS_SETTINGS_OFFSET 4
+#define NVS_VERSION_OFFSET 9
+#define NVS_CRC_OFFSET 14
+
+/*Phrases in a record*/
+#define NVS_PHRASES (NVS_RECORD_SIZE / FLASH_PHRASE)
+
+/*! This enumerated constant is the flash command that is running*/
+typedef enum {NVS_IDLE, NVS_ERASE, NVS_PROGRAM} NVS_StateType;
+
+/*Flash of the log*/
+static const FLASH_DriverType* NVS_flash = 0;
+/*Sector being written, and the slot for the next record in it*/
+static uint8 NVS_sector = 0;
+static uint16 NVS_slot = 0;
+/*Settings of the newest valid record found at boot*/
+static NVS_SettingsType NVS_restored;
+static uint8 NVS_restoredValid = FALSE;
+/*Settings waiting to be written*/
+static NVS_SettingsType NVS_pending;
+static uint8 NVS_pendingValid = FALSE;
+/*Record being written, the phrase being programmed and the failed tries*/
+static uint8 NVS_record[NVS_RECORD_SIZE];
+static uint8 NVS_phrase = 0;
+static uint8 NVS_retries = 0;
+static NVS_StateType NVS_state = NVS_IDLE;
+/*Statistics, sequence is the newest record*/
+static NVS_StatsType NVS_statistics = {0, 0, 0, 0};
+
+/*Address of a slot*/
+static uint32 NVS_address(uint8 sector, uint16 slot){
+	return NVS_BASE + (uint32)sector * FLASH_SECTOR_SIZE + (uint32)slot * NVS_RECORD_SIZE;
+}
+
+/*Bytes of a slot*/
+static const uint8* NVS_read(uint8 sector, uint16 slot){
+	return NVS_flash->read(NVS_address(sector, slot));
+}
+
+/*Sector after a sector, in the ring*/
+static uint8 NVS_next(uint8 sector){
+	return (sector + 1 == NVS_SECTORS) ? 0 : sector + 1;
+}
+
+/*Sequence number of a record*/
+static uint32 NVS_sequenceOf(const uint8* record){
+	return (uint32)record[NVS_SEQUENCE_OFFSET] | ((uint32)record[NVS_SEQUENCE_OFFSET + 1] << 8) |
+			((uint32)record[NVS_SEQUENCE_OFFSET + 2] << 16) | ((uint32)record[NVS_SEQUENCE_OFFSET + 3] << 24);
+}
+
+/*Tells if a slot was never written*/
+static uint8 NVS_blank(const uint8* record){
+	uint8 index;
+
+	for(index = 0; index < NVS_RECORD_SIZE; index++){
+		if(FLASH_ERASED != record[index]){
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*Tells if a record was written whole, with this layout*/
+static uint8 NVS_valid(const uint8* record){
+	uint16 crc = CRC_ccitt(CRC_INIT, record, NVS_CRC_OFFSET);
+
+	return ((NVS_VERSION == record[NVS_VERSION_OFFSET]) &&
+			((uint8)crc == record[NVS_CRC_OFFSET]) && ((uint8)(crc >> 8) == record[NVS_CRC_OFFSET + 1])) ? TRUE : FALSE;
+}
+
+/*Slot after the last one written in a sector, NVS_RECORDS if it is full. The slots are
+ * written in order, so the blank ones are at the end*/
+static uint16 NVS_end(uint8 sector){
+	uint16 low = 0;
+	uint16 high = NVS_RECORDS;
+	uint16 middle;
+
+	/*The slots before low are written, the ones from high are blank*/
+	while(low < high){
+		middle = (low + high) / 2;
+		if(NVS_blank(NVS_read(sector, middle))){
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+	return low;
+}
+
+/*Newest valid record of a sector, going back from its end over the torn ones, NVS_RECORDS if
+ * there is none*/
+static uint16 NVS_newest(uint8 sector, uint16 end){
+	while(end--){
+		if(NVS_valid(NVS_read(sector, end))){
+			return end;
+		}
+	}
+	return NVS_RECORDS;
+}
+
+/*Fill NVS_record with the settings*/
+static void NVS_build(const NVS_SettingsType* settings, uint32 sequence){
+	uint16 crc;
+	uint8 index;
+
+	for(index = 0; index < 4; index++){
+		NVS_record[NVS_SEQUENCE_OFFSET + index] = (uint8)(sequence >> (8 * index));
+	}
+	NVS_record[NVS_SETTINGS_OFFSET] = settings->alarm;
+	NVS_record[NVS_SETTINGS_OFFSET + 1] = settings->format;
+	NVS_record[NVS_SETTINGS_OFFSET + 2] = settings->perInc;
+	NVS_record[NVS_SETTINGS_OFFSET + 3] = settings->manual;
+	NVS_record[NVS_SETTINGS_OFFSET + 4] = settings->speed;
+	NVS_record[NVS_VERSION_OFFSET] = NVS_VERSION;
+	for(index = NVS_VERSION_OFFSET + 1; index < NVS_CRC_OFFSET; index++){
+		NVS_record[index] = FLASH_ERASED;
+	}
+	crc = CRC_ccitt(CRC_INIT, NVS_record, NVS_CRC_OFFSET);
+	NVS_record[NVS_CRC_OFFSET] = (uint8)crc;
+	NVS_record[NVS_CRC_OFFSET + 1] = (uint8)(crc >> 8);
+}
+
+/*Start writing NVS_record in the next blank slot. If the sector is full, the next sector is
+ * erased first*/
+static void NVS_begin(){
+	while((NVS_slot < NVS_RECORDS) && !NVS_blank(NVS_read(NVS_sector, NVS_slot))){
+		NVS_slot++;
+	}
+	NVS_phrase = 0;
+	if(NVS_RECORDS == NVS_slot){
+		NVS_state = NVS_ERASE;
+		NVS_flash->erase(NVS_address(NVS_next(NVS_sector), 0));
+	} else {
+		NVS_state = NVS_PROGRAM;
+		NVS_flash->program(NVS_address(NVS_sector, NVS_slot), NVS_record);
+	}
+}
+
+/*A command failed: the record or the erase is tried again, up to NVS_RETRIES times. The
+ * record goes in the same slot if it still reads blank, NVS_begin() skips it only if it holds
+ * part of the record, so the written slots never have a blank one between them (NVS_end)*/
+static void NVS_fail(){
+	NVS_statistics.failures++;
+	if(++NVS_retries > NVS_RETRIES){
+		NVS_state = NVS_IDLE;
+		return;
+	}
+	NVS_begin();
+}
+
+void NVS_init(const FLASH_DriverType* flash){
+	const uint8* record;
+	uint8 sector;
+	uint16 end;
+	uint16 newest;
+	uint32 sequence;
+
+	NVS_flash = flash;
+	NVS_state = NVS_IDLE;
+	NVS_pendingValid = FALSE;
+	NVS_restoredValid = FALSE;
+	NVS_statistics.commits = 0;
+	NVS_statistics.erases = 0;
+	NVS_statistics.failures = 0;
+	NVS_statistics.sequence = 0;
+	NVS_sector = 0;
+	NVS_slot = NVS_end(0);
+
+	/*The newest valid record of each sector, the newest of them is the one restored, and
+	 * the next records go after it*/
+	for(sector = 0; sector < NVS_SECTORS; sector++){
+		end = NVS_end(sector);
+		newest = NVS_newest(sector, end);
+		if(NVS_RECORDS == newest){
+			continue;
+		}
+		record = NVS_read(sector, newest);
+		sequence = NVS_sequenceOf(record);
+		if(NVS_restoredValid && ((sint32)(sequence - NVS_statistics.sequence) <= 0)){
+			continue;
+		}
+		NVS_restoredValid = TRUE;
+		NVS_statistics.sequence = sequence;
+		NVS_restored.alarm = record[NVS_SETTINGS_OFFSET];
+		NVS_restored.format = record[NVS_SETTINGS_OFFSET + 1];
+		NVS_restored.perInc = record[NVS_SETTINGS_OFFSET + 2];
+		NVS_restored.manual = record[NVS_SETTINGS_OFFSET + 3];
+		NVS_restored.speed = record[NVS_SETTINGS_OFFSET + 4];
+		NVS_sector = sector;
+		NVS_slot = end;
+	}
+}
+
+uint8 NVS_restore(NVS_SettingsType* settings){
+	if(!NVS_restoredValid){
+		return FALSE;
+	}
+	*settings = NVS_restored;
+	return TRUE;
+}
+
+void NVS_save(const NVS_SettingsType* settings){
+	NVS_pending = *settings;
+	NVS_pendingValid = TRUE;
+}
+
+void NVS_poll(){
+	if(!NVS_flash || NVS_flash->busy()){
+		return;
+	}
+
+	switch(NVS_state){
+	/*The next sector is erased, the record goes at its start*/
+	case NVS_ERASE:
+		if(NVS_flash->failed()){
+			NVS_fail();
+			return;
+		}
+		NVS_statistics.erases++;
+		NVS_sector = NVS_next(NVS_sector);
+		NVS_slot = 0;
+		NVS_begin();
+		return;
+	/*A phrase is programmed, the next one or the record is complete*/
+	case NVS_PROGRAM:
+		if(NVS_flash->failed()){
+			NVS_fail();
+			return;
+		}
+		if(++NVS_phrase < NVS_PHRASES){
+			NVS_flash->program(NVS_address(NVS_sector, NVS_slot) + NVS_phrase * FLASH_PHRASE,
+					&NVS_record[NVS_phrase * FLASH_PHRASE]);
+			return;
+		}
+		NVS_slot++;
+		NVS_statistics.commits++;
+		NVS_statistics.sequence = NVS_sequenceOf(NVS_record);
+		NVS_state = NVS_IDLE;
+		break;
+	default:
+		break;
+	}
+
+	/*The last settings saved go in a new record*/
+	if(NVS_pendingValid){
+		NVS_pendingValid = FALSE;
+		NVS_build(&NVS_pending, NVS_statistics.sequence + 1);
+		NVS_retries = 0;
+		NVS_begin();
+	}
+}
+
+uint8 NVS_busy(){
+	return (NVS_pendingValid || (NVS_IDLE != NVS_state)) ? TRUE : FALSE;
+}
+
+void NVS_stats(NVS_StatsType* stats){
+	*stats = NVS_statistics;
+}
@@ -0,0 +1,138 @@
+/**
+	\file
+	\brief
+		This is the header file for the settings store. The settings that the operator
+		sets (alarm, temperature format, percentage, motor control and speed) are kept in
+		flash, as a log of records that is only appended: each commit writes a new record,
+		with a sequence number and a CRC, after the previous one. The log spans NVS_SECTORS
+		sectors used as a ring; when a sector is full the next one, that has the oldest
+		records, is erased, so the erases are spread over all of them. A record that was
+		being written when the power failed has a bad CRC and is skipped.
+
+		At boot, NVS_init() finds the newest valid record without reading the whole log: the
+		records of a sector are written in order, so its end is found with a binary search,
+		and the newest valid record is the last one before the end, or one of the few
+		before it if the last ones were torn.
+
+		The writes don't wait for the flash: NVS_save() keeps the settings and NVS_poll()
+		(called periodically) starts each flash command when the previous one is done.
+
+		Record layout (little endian), NVS_RECORD_SIZE bytes:
+		 - uint32 sequence number, the newest record has the largest
+		 - uint8 alarm, format, percentage, motor control and speed (NVS_SettingsType)
+		 - uint8 NVS_VERSION, the layout of the record
+		 - 4 bytes reserved, FLASH_ERASED
+		 - uint16 CRC_ccitt() of the bytes above
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_NVS_H_
+#define SOURCES_NVS_H_
+
+#include "DataTypeDefinitions.h"
+#include "FLASH.h"
+
+/** Address of the first sector, the last two sectors of the 1 MB program flash */
+#define NVS_BASE 0x000FE000
+/** Number of sectors of the log */
+#define NVS_SECTORS 2
+/** Size of a record, in bytes, a multiple of FLASH_PHRASE */
+#define NVS_RECORD_SIZE 16
+/** Records in a sector */
+#define NVS_RECORDS (FLASH_SECTOR_SIZE / NVS_RECORD_SIZE)
+/** Layout of the records */
+#define NVS_VERSION 1
+/** Times that a failed flash command is tried again before the record is given up */
+#define NVS_RETRIES 3
+
+/**
+ * Struct NVS_SettingsType has the settings that are kept, as they are in SystemUpdateFlags
+ * **/
+typedef struct{
+	uint8 alarm;
+	uint8 format;
+	uint8 perInc;
+	uint8 manual;
+	uint8 speed;
+}NVS_SettingsType;
+
+/**
+ * Struct NVS_StatsType tells how the store is doing
+ * **/
+typedef struct{
+	/*records written*/
+	uint32 commits;
+	/*sectors erased*/
+	uint32 erases;
+	/*flash commands that failed*/
+	uint32 failures;
+	/*sequence number of the newest record*/
+	uint32 sequence;
+}NVS_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function finds the newest valid record of the log, and where the next one
+ 	 goes. It does a binary search in each sector, and reads back over the records that were
+ 	 torn at its end
+ 	 \param[in] flash - flash of the log
+ 	 \return void
+ */
+void NVS_init(const FLASH_DriverType* flash);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the settings of the newest valid record found by
+ 	 NVS_init()
+ 	 \param[out] settings - settings of the record
+ 	 \return uint8 - FALSE if the log has no valid record, settings is left as it is
+ */
+uint8 NVS_restore(NVS_SettingsType* settings);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function asks to write the settings in a new record, it returns right
+ 	 away. If a record is already being written, the settings wait for it, and only the
+ 	 last settings saved meanwhile are written
+ 	 \param[in] settings - settings to keep
+ 	 \return void
+ */
+void NVS_save(const NVS_SettingsType* settings);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function moves the writes forward: when the flash is done with a command
+ 	 it starts the next one. It must be called periodically, from the main loop (for
+ 	 example, a scheduler timer)
+ 	 \return void
+ */
+void NVS_poll();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function tells if there are settings that are not in the flash yet
+ 	 \return uint8 - TRUE while writing
+ */
+uint8 NVS_busy();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the statistics of the store
+ 	 \param[out] stats - commits, erases and failures
+ 	 \return void
+ */
+void NVS_stats(NVS_StatsType* stats);
+
+#endif /* SOURCES_NVS_H_ */
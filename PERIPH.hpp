@@ -0,0 +1,318 @@
+/**
+	\file
+	\brief
+		This is an optional C++17 header for the FTM, ADC and SPI. The peripheral instance
+		and the channel are template parameters, and the configurations are constexpr
+		objects, so the value of each register is computed by the compiler and the
+		initialization is a list of single stores, with no branches and no
+		read-modify-write. The register values are the same ones the C drivers
+		(FTM_init, ADC_init, SPI_init) leave, starting from the reset state; for the
+		configurations of main.c, tools/periphtest.cpp checks it on the host.
+
+		Example:
+			static constexpr PERIPH::FtmConfig pwmConfig = {FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, TRUE, 167, FALSE};
+			static constexpr PERIPH::FtmChannelConfig pwmChannel = {TRUE, FALSE, TRUE, FALSE, FALSE, 0};
+			PERIPH::Ftm<0>::init<pwmConfig>();
+			PERIPH::Ftm<0>::Channel<1>::init<pwmChannel>();
+			PERIPH::Ftm<0>::Channel<1>::write(duty);
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_PERIPH_HPP_
+#define SOURCES_PERIPH_HPP_
+
+extern "C" {
+#include "MK64F12.h"
+#include "DataTypeDefinitions.h"
+#include "NVIC.h"
+#include "FlexTimer.h"
+#include "ADC.h"
+#include "SPI.h"
+}
+
+namespace PERIPH {
+
+/**
+ * The next structs have what changes from one instance to another: the registers, the
+ * clock gating and the interruption. Only the instances that exist are specialized, so
+ * using any other one doesn't compile.
+ * **/
+template<unsigned N> struct FtmInstance;
+template<> struct FtmInstance<0>{
+	static FTM_Type* regs(){ return FTM0; }
+	static void clockGating(){ SIM->SCGC6 |= FTM0_CLOCK_GATING; }
+	static constexpr InterruptType irq = FTM0_IRQ;
+	static constexpr unsigned channels = 8;
+};
+template<> struct FtmInstance<1>{
+	static FTM_Type* regs(){ return FTM1; }
+	static void clockGating(){ SIM->SCGC6 |= FTM1_CLOCK_GATING; }
+	static constexpr InterruptType irq = FTM1_IRQ;
+	static constexpr unsigned channels = 2;
+};
+template<> struct FtmInstance<2>{
+	static FTM_Type* regs(){ return FTM2; }
+	static void clockGating(){ SIM->SCGC6 |= FTM2_CLOCK_GATING; }
+	static constexpr InterruptType irq = FTM2_IRQ;
+	static constexpr unsigned channels = 2;
+};
+template<> struct FtmInstance<3>{
+	static FTM_Type* regs(){ return FTM3; }
+	static void clockGating(){ SIM->SCGC3 |= FTM3_CLOCK_GATING; }
+	static constexpr InterruptType irq = FTM3_IRQ;
+	static constexpr unsigned channels = 8;
+};
+
+template<unsigned N> struct AdcInstance;
+template<> struct AdcInstance<0>{
+	static ADC_Type* regs(){ return ADC0; }
+	static void clockGating(){ SIM->SCGC6 |= SIM_SCGC6_ADC0_MASK; }
+	static constexpr InterruptType irq = ADC0_IRQ;
+};
+template<> struct AdcInstance<1>{
+	static ADC_Type* regs(){ return ADC1; }
+	static void clockGating(){ SIM->SCGC3 |= SIM_SCGC3_ADC1_MASK; }
+	static constexpr InterruptType irq = ADC1_IRQ;
+};
+
+template<unsigned N> struct SpiInstance;
+template<> struct SpiInstance<0>{
+	static SPI_Type* regs(){ return SPI0; }
+	static void clockGating(){ SIM->SCGC6 |= SPI0_CLOCK_GATING; }
+};
+template<> struct SpiInstance<1>{
+	static SPI_Type* regs(){ return SPI1; }
+	static void clockGating(){ SIM->SCGC6 |= SPI1_CLOCK_GATING; }
+};
+template<> struct SpiInstance<2>{
+	static SPI_Type* regs(){ return SPI2; }
+	static void clockGating(){ SIM->SCGC3 |= SPI2_CLOCK_GATING; }
+};
+
+/**
+ * Struct FtmConfig has the configuration of a Flex timer that is shared by its channels
+ * **/
+struct FtmConfig{
+	/*clock source (FLEX_TIMER_CLKS_x)*/
+	uint8 clockSource;
+	/*clock prescaler (FLEX_TIMER_PS_x)*/
+	uint8 clockPrescaler;
+	/*center aligned PWM*/
+	uint8 CPWMS;
+	/*limit for the counter*/
+	uint16 MOD;
+	/*overflow interruption*/
+	uint8 interrupt;
+
+	/*value of FTMx_SC*/
+	constexpr uint32 SC() const {
+		return FTM_SC_CPWMS(CPWMS) | clockSource | clockPrescaler | (interrupt ? FTM_SC_TOIE_MASK : 0);
+	}
+};
+
+/**
+ * Struct FtmChannelConfig has the configuration of a channel of a Flex timer
+ * **/
+struct FtmChannelConfig{
+	/*mode selection, see FTM_ConfigType*/
+	uint8 MSnB;
+	uint8 MSnA;
+	uint8 ELSB;
+	uint8 ELSA;
+	/*channel interruption*/
+	uint8 interrupt;
+	/*initial CnV*/
+	uint16 CNV;
+	/*combine and dual edge capture of the pair the channel belongs to*/
+	uint8 COMBINE;
+	uint8 DECAPEN;
+
+	/*value of FTMx_CnSC*/
+	constexpr uint32 CnSC() const {
+		return FTM_CnSC_MSB(MSnB) | FTM_CnSC_MSA(MSnA) | FTM_CnSC_ELSB(ELSB) | FTM_CnSC_ELSA(ELSA) |
+				(interrupt ? FLEX_TIMER_CHIE : 0);
+	}
+	/*bits of FTMx_COMBINE for the pair of channel n*/
+	constexpr uint32 combine(unsigned n) const {
+		return (FTM_COMBINE_COMBINE0(COMBINE) | FTM_COMBINE_DECAPEN0(DECAPEN)) << ((n / 2) * 8);
+	}
+};
+
+/**
+ * Class Ftm gives access to Flex timer N
+ * **/
+template<unsigned N>
+struct Ftm{
+	typedef FtmInstance<N> Instance;
+
+	static FTM_Type* regs(){ return Instance::regs(); }
+
+	/*Initialize the Flex timer with a constexpr configuration. The clock is selected at
+	 * the end, so the counter starts with MOD already loaded*/
+	template<const FtmConfig& C>
+	static void init(){
+		constexpr uint32 SC = C.SC();
+		Instance::clockGating();
+		regs()->MODE = FTM_MODE_WPDIS_MASK;
+		regs()->MOD = C.MOD;
+		regs()->SC = SC;
+		if(C.interrupt){
+			NVIC_enableInterruptAndPriority(Instance::irq, PRIORITY_9);
+		}
+	}
+
+	static uint32 count(){ return regs()->CNT; }
+
+	/**
+	 * Class Channel gives access to channel C of the Flex timer
+	 * **/
+	template<unsigned C>
+	struct Channel{
+		static_assert(C < Instance::channels, "The Flex timer doesn't have this channel");
+
+		/*Configure the channel, with a constexpr configuration*/
+		template<const FtmChannelConfig& K>
+		static void init(){
+			constexpr uint32 CnSC = K.CnSC();
+			constexpr uint32 combine = K.combine(C);
+			/*COMBINE is shared by the four pairs, it is only touched if needed*/
+			if(combine){
+				regs()->COMBINE |= combine;
+			}
+			regs()->CONTROLS[C].CnSC = CnSC;
+			regs()->CONTROLS[C].CnV = K.CNV;
+		}
+
+		static void write(uint16 value){ regs()->CONTROLS[C].CnV = value; }
+		static uint16 read(){ return regs()->CONTROLS[C].CnV; }
+		static void clearFlag(){ regs()->CONTROLS[C].CnSC &= ~FLEX_TIMER_CHF; }
+	};
+};
+
+/**
+ * Struct AdcConfig has the configuration of an ADC, the fields are the ones of
+ * ADC_ConfigType without the instance
+ * **/
+struct AdcConfig{
+	AB_ChannelType nchannel;
+	singleOrDifferential singleOrDifferentialMode;
+	normalOrLowPower powerMode;
+	clockDivider clockDiv;
+	sampleTimeSize sampleSize;
+	conversionMode conversionSize;
+	inputClockSelect clockSource;
+	conversionTrigger converTrigger;
+	hardwareAverage averageEnabled;
+	hardwareAverageSamples averageSamples;
+
+	/*value of ADCx_CFG1*/
+	constexpr uint32 CFG1() const {
+		return ADC_CFG1_ADLPC(powerMode) | ADC_CFG1_ADIV(clockDiv) | ADC_CFG1_ADLSMP(sampleSize) |
+				ADC_CFG1_MODE(conversionSize) | ADC_CFG1_ADICLK(clockSource);
+	}
+	/*value of ADCx_SC2*/
+	constexpr uint32 SC2() const { return ADC_SC2_ADTRG(converTrigger); }
+	/*value of ADCx_SC3*/
+	constexpr uint32 SC3() const { return ADC_SC3_AVGE(averageEnabled) | ADC_SC3_AVGS(averageSamples); }
+	/*value of ADCx_SC1n, the input is left disabled until a convertion is started*/
+	constexpr uint32 SC1() const {
+		return ADC_SC1_AIEN_MASK | ADC_SC1_DIFF(singleOrDifferentialMode) | ADC_SC1_ADCH_MASK;
+	}
+};
+
+/**
+ * Class Adc gives access to ADC N
+ * **/
+template<unsigned N>
+struct Adc{
+	typedef AdcInstance<N> Instance;
+
+	static ADC_Type* regs(){ return Instance::regs(); }
+
+	/*Calibrate and initialize the ADC with a constexpr configuration, returns FALSE if the
+	 * calibration failed*/
+	template<const AdcConfig& C>
+	static uint8 init(){
+		constexpr uint32 CFG1 = C.CFG1();
+		constexpr uint32 SC2 = C.SC2();
+		constexpr uint32 SC3 = C.SC3();
+		constexpr uint32 SC1 = C.SC1();
+		Instance::clockGating();
+		regs()->SC3 = ADC_SC3_CAL_MASK;
+		while(regs()->SC3 & ADC_SC3_CAL_MASK);
+		if(regs()->SC3 & ADC_SC3_CALF_MASK){
+			return FALSE;
+		}
+		regs()->CFG1 = CFG1;
+		regs()->SC2 = SC2;
+		regs()->SC3 = SC3;
+		regs()->SC1[C.nchannel] = SC1;
+		NVIC_enableInterruptAndPriority(Instance::irq, PRIORITY_10);
+		return TRUE;
+	}
+
+	/**
+	 * Class Channel gives access to channel A or B of the ADC
+	 * **/
+	template<AB_ChannelType C>
+	struct Channel{
+		/*Start a convertion, with the interruption enabled*/
+		static void start(inputChannelSelect inputChannel){
+			regs()->SC1[C] = ADC_SC1_AIEN_MASK | ADC_SC1_ADCH(inputChannel);
+		}
+		static uint32 result(){ return regs()->R[C]; }
+	};
+};
+
+/**
+ * Struct SpiConfig has the configuration of a SPI, the fields are the ones of
+ * SPI_ConfigType without the instance
+ * **/
+struct SpiConfig{
+	SPI_EnableFIFOType SPI_EnableFIFO;
+	SPI_PolarityType SPI_Polarity;
+	SPI_PhaseType SPI_Phase;
+	SPI_LSMorMSBType SPI_LSMorMSB;
+	SPI_MasterType SPI_Master;
+	uint8 baudrate;
+	uint32 frameSize;
+
+	/*value of SPIx_MCR, HALT keeps its reset value, as SPI_init() does*/
+	constexpr uint32 MCR() const {
+		return SPI_MCR_MSTR(SPI_Master) | SPI_MCR_DIS_RXF(SPI_EnableFIFO) | SPI_MCR_DIS_TXF(SPI_EnableFIFO) |
+				SPI_MCR_HALT_MASK;
+	}
+	/*value of SPIx_CTAR0*/
+	constexpr uint32 CTAR0() const {
+		return SPI_CTAR_CPOL(SPI_Polarity) | frameSize | SPI_CTAR_CPHA(SPI_Phase) | SPI_CTAR_BR(baudrate) |
+				SPI_CTAR_LSBFE(SPI_LSMorMSB);
+	}
+};
+
+/**
+ * Class Spi gives access to SPI N
+ * **/
+template<unsigned N>
+struct Spi{
+	typedef SpiInstance<N> Instance;
+
+	static SPI_Type* regs(){ return Instance::regs(); }
+
+	/*Initialize the SPI with a constexpr configuration*/
+	template<const SpiConfig& C>
+	static void init(){
+		constexpr uint32 MCR = C.MCR();
+		constexpr uint32 CTAR0 = C.CTAR0();
+		Instance::clockGating();
+		regs()->MCR = MCR;
+		regs()->CTAR[0] = CTAR0;
+	}
+
+	static void start(){ regs()->MCR &= ~SPI_MCR_HALT_MASK; }
+	static void stop(){ regs()->MCR |= SPI_MCR_HALT_MASK; }
+	static void sendByte(uint8 data){ SPI_sendByte(regs(), data); }
+};
+
+} /* namespace PERIPH */
+
+#endif /* SOURCES_PERIPH_HPP_ */
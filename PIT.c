@@ -10,6 +10,9 @@
 #include "DataTypeDefinitions.h"
 #include "PIT.h"
 
+/*Functions called from the channel interruptions, indexed by PIT_TimerType*/
+static PIT_CallbackType PIT_callback[4] = {0, 0, 0, 0};
+
 void PIT_clockGating(){
 	SIM->SCGC6 |= SIM_SCGC6_PIT_MASK;
 }
@@ -25,92 +28,31 @@ void PIT_disable(){
 }
 
 void PIT_timerInterruptEnable(PIT_TimerType pitTimer){
-		switch(pitTimer){
-		case PIT_0:
-			PIT_TCTRL0 |= (PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_1:
-			PIT_TCTRL1 |= (PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_2:
-			PIT_TCTRL2 |= (PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_3:
-			PIT_TCTRL3 |= (PIT_TCTRL_TIE_MASK);
-			break;
-	}
+	PIT->CHANNEL[pitTimer].TCTRL |= (PIT_TCTRL_TIE_MASK);
 }
 
 void PIT_timerInterruptDisable(PIT_TimerType pitTimer){
-		switch(pitTimer){
-		case PIT_0:
-			PIT_TCTRL0 &= ~(PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_1:
-			PIT_TCTRL1 &= ~(PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_2:
-			PIT_TCTRL2 &= ~(PIT_TCTRL_TIE_MASK);
-			break;
-		case PIT_3:
-			PIT_TCTRL3 &= ~(PIT_TCTRL_TIE_MASK);
-			break;
-	}
+	PIT->CHANNEL[pitTimer].TCTRL &= ~(PIT_TCTRL_TIE_MASK);
 }
 
 void PIT_timerEnable(PIT_TimerType pitTimer){
-		switch(pitTimer){
-		case PIT_0:
-			PIT_TCTRL0 |= (PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_1:
-			PIT_TCTRL1 |= (PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_2:
-			PIT_TCTRL2 |= (PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_3:
-			PIT_TCTRL3 |= (PIT_TCTRL_TEN_MASK);
-			break;
-	}
+	PIT->CHANNEL[pitTimer].TCTRL |= (PIT_TCTRL_TEN_MASK);
 }
 
 void PIT_timerDisable(PIT_TimerType pitTimer){
-		switch(pitTimer){
-		case PIT_0:
-			PIT_TCTRL0 &= ~(PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_1:
-			PIT_TCTRL1 &= ~(PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_2:
-			PIT_TCTRL2 &= ~(PIT_TCTRL_TEN_MASK);
-			break;
-		case PIT_3:
-			PIT_TCTRL3 &= ~(PIT_TCTRL_TEN_MASK);
-			break;
-	}
+	PIT->CHANNEL[pitTimer].TCTRL &= ~(PIT_TCTRL_TEN_MASK);
 }
 
 void PIT_delay(PIT_TimerType pitTimer,float systemClock ,float period){
 
 	/*specified formula to obtain the delay*/
 	float delay = (((period*(systemClock))/2)-1);
-	switch(pitTimer){
-		case PIT_0:
-			PIT_LDVAL0 = (uint32)delay;
-			break;
-		case PIT_1:
-			PIT_LDVAL1 = (uint32)delay;
-			break;
-		case PIT_2:
-			PIT_LDVAL2 = (uint32)delay;
-			break;
-		case PIT_3:
-			PIT_LDVAL3 = (uint32)delay;
-			break;
-	}
+	PIT->CHANNEL[pitTimer].LDVAL = (uint32)delay;
+}
 
+void PIT_loadCycles(PIT_TimerType pitTimer, uint32 cycles){
+	/*The channel counts from LDVAL down to 0, so it lasts LDVAL + 1 cycles*/
+	PIT->CHANNEL[pitTimer].LDVAL = cycles - 1;
 }
 
 void PIT0_clearInterrupt(){
@@ -151,35 +93,81 @@ void PIT3_clearInterrupt(){
 
 void PIT0_IRQHandler(){
 	PIT0_clearInterrupt();
- }
+	/*Let the owner of the channel attend the interruption*/
+	if(PIT_callback[PIT_0]){
+		PIT_callback[PIT_0]();
+	}
+}
 
 void PIT1_IRQHandler(){
 	PIT1_clearInterrupt();
-
- }
+	/*Let the owner of the channel attend the interruption*/
+	if(PIT_callback[PIT_1]){
+		PIT_callback[PIT_1]();
+	}
+}
 
 void PIT2_IRQHandler(){
 	PIT2_clearInterrupt();
-
+	/*Let the owner of the channel attend the interruption*/
+	if(PIT_callback[PIT_2]){
+		PIT_callback[PIT_2]();
+	}
 }
 
 void PIT3_IRQHandler(){
 	PIT3_clearInterrupt();
-
+	/*Let the owner of the channel attend the interruption*/
+	if(PIT_callback[PIT_3]){
+		PIT_callback[PIT_3]();
+	}
 }
 
 uint32 PIT_readTimerValue(PIT_TimerType pitTimer){
 	/*According to the pit Timer, we return the value of the counter in the requested
 	 * channel*/
-	switch(pitTimer){
-	case PIT_0:
-		return PIT_CVAL0;
-	case PIT_1:
-		return PIT_CVAL1;
-	case PIT_2:
-		return PIT_CVAL2;
-	case PIT_3:
-		return PIT_CVAL3;
-	}
-	return FALSE;
+	return PIT->CHANNEL[pitTimer].CVAL;
+}
+
+void PIT_callbackInstall(PIT_TimerType pitTimer, PIT_CallbackType callback){
+	PIT_callback[pitTimer] = callback;
+}
+
+void PIT_lifetimeInit(){
+	PIT_clockGating();
+	PIT_enable();
+
+	/*Both channels count the whole 32-bit range*/
+	PIT_LDVAL1 = 0xFFFFFFFF;
+	PIT_LDVAL0 = 0xFFFFFFFF;
+	/*PIT_1 decrements each time PIT_0 expires, it has to be enabled first*/
+	PIT_TCTRL1 = PIT_TCTRL_CHN_MASK | PIT_TCTRL_TEN_MASK;
+	PIT_TCTRL0 = PIT_TCTRL_TEN_MASK;
+}
+
+uint64 PIT_lifetimeRead(){
+	uint32 primask = __get_PRIMASK();
+	uint32 high;
+	uint32 low;
+
+	__disable_irq();
+	/*Reading the upper half latches the lower half*/
+	high = PIT_LTMR64H;
+	low = PIT_LTMR64L;
+	__set_PRIMASK(primask);
+
+	/*The channels count down, the complement gives the elapsed ticks*/
+	return ~(((uint64)high << 32) | low);
+}
+
+uint32 PIT_lifetimeRead32(){
+	return ~PIT_CVAL0;
+}
+
+uint64 PIT_lifetimeElapsed(uint64 timeStamp){
+	return PIT_lifetimeRead() - timeStamp;
+}
+
+uint64 PIT_ticksToMicros(uint64 ticks){
+	return ticks / PIT_TICKS_PER_US;
 }
@@ -12,11 +12,18 @@
 
 
 #include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
 #include "MK64F12.h"
 
+/** Number of lifetime timer ticks (bus clock cycles) in one microsecond */
+#define PIT_TICKS_PER_US (SYSTEM_CLOCK/1000000)
+
 /*! This enumerated constant are used to select the PIT to be used*/
 typedef enum {PIT_0,PIT_1,PIT_2,PIT_3} PIT_TimerType;
 
+/*! Function called from the PIT channel interruption, after the flag is cleared*/
+typedef void (*PIT_CallbackType)(void);
+
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
@@ -101,6 +108,19 @@ void PIT_timerDisable(PIT_TimerType pitTimer);
  */
 void PIT_delay(PIT_TimerType pitTimer,float systemClock ,float perior);
 
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function receives a PIT channel number and a number of bus clock cycles, and
+ 	 	 loads the channel so it expires every cycles clock cycles. Unlike PIT_delay, no float
+ 	 	 math is involved
+ 	 \param[in] pitTimer PIT channel
+ 	 \param[in] cycles period of the channel, in bus clock cycles (greater than 0)
+ 	 \return void
+ */
+void PIT_loadCycles(PIT_TimerType pitTimer, uint32 cycles);
+
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
@@ -154,4 +174,76 @@ void PIT3_clearInterrupt();
 
 
 uint32 PIT_readTimerValue(PIT_TimerType pitTimer);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function receives a PIT channel number and a function, that will be called
+ 	 	 from the channel interruption every time the channel expires. Passing 0 as callback
+ 	 	 uninstalls the previous one.
+ 	 \param[in] pitTimer PIT channel
+ 	 \param[in] callback function to be called from the interruption
+ 	 \return void
+ */
+void PIT_callbackInstall(PIT_TimerType pitTimer, PIT_CallbackType callback);
+
+/**
+ * The next set of functions use PIT_0 and PIT_1 chained as a 64-bit lifetime timer,
+ * that counts bus clock cycles since PIT_lifetimeInit() was called. These two channels
+ * can't be used for anything else.
+ */
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function chains PIT_1 to PIT_0, loads both with the maximum value and starts
+ 	 	 them, so PIT_LTMR64H/PIT_LTMR64L give a free-running 64-bit count
+ 	 \return void
+ */
+void PIT_lifetimeInit();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function reads the 64-bit lifetime timer. Reading PIT_LTMR64H latches the
+ 	 	 lower half, and the pair is read with interruptions masked, so an interruption
+ 	 	 that also reads the timer can't break the latch. It may be called from interruptions.
+ 	 \return ticks (bus clock cycles) since PIT_lifetimeInit(), this value never wraps
+ */
+uint64 PIT_lifetimeRead();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function reads only the lower 32 bits of the lifetime timer. It is cheaper,
+ 	 	 and enough to measure intervals shorter than 204 seconds, as long as they are
+ 	 	 computed as (end - start) with uint32 math, that is wrap-safe
+ 	 \return lower 32 bits of the lifetime ticks
+ */
+uint32 PIT_lifetimeRead32();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function returns the ticks elapsed since a previous lifetime timestamp
+ 	 \param[in] timeStamp value previously returned by PIT_lifetimeRead()
+ 	 \return ticks elapsed since timeStamp
+ */
+uint64 PIT_lifetimeElapsed(uint64 timeStamp);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief This function converts lifetime timer ticks to microseconds, with integer math
+ 	 \param[in] ticks lifetime ticks, usually a difference of two timestamps
+ 	 \return microseconds
+ */
+uint64 PIT_ticksToMicros(uint64 ticks);
+
 #endif /* PIT_H_ */
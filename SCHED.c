@@ -0,0 +1,175 @@
+/**
+	\file
+	\brief
+		This is the source file for the scheduler. The wheel has a root level of 256 slots
+		of 1 ms each, and three upper levels of 64 slots. Every time the root level wraps,
+		the next slot of the upper level is cascaded, meaning that its timers are inserted
+		again, now closer to their expiration. tools/schedtest.c tests it on the host.
+	\date	19/10/2026
+ */
+
+#include "MK64F12.h"
+#include "SCHED.h"
+#include "NVIC.h"
+
+/*Index of the slot that the timers of an upper level are cascaded from*/
+#define SCHED_INDEX(time, level) (((time) >> (SCHED_ROOT_BITS + (level)*SCHED_LEVEL_BITS)) & SCHED_LEVEL_MASK)
+
+/*Tick counter, incremented by the PIT interruption*/
+static volatile uint32 SCHED_tickCount = 0;
+
+/*Tick up to which the wheel has been processed*/
+static uint32 SCHED_wheelTime = 0;
+
+/*Root level of the wheel, one slot per tick*/
+static SCHED_TimerType* SCHED_root[SCHED_ROOT_SIZE];
+
+/*Upper levels of the wheel*/
+static SCHED_TimerType* SCHED_level[SCHED_LEVELS][SCHED_LEVEL_SIZE];
+
+/*PIT callback, it only counts the tick, the timers are processed in the main loop*/
+static void SCHED_tick(){
+	SCHED_tickCount++;
+}
+
+/*Put a timer in the slot that corresponds to its expiration*/
+static void SCHED_insert(SCHED_TimerType* timer){
+	uint32 expires = timer->expires;
+	uint32 index = expires - SCHED_wheelTime;
+	SCHED_TimerType** slot;
+
+	if((sint32)index < 0){
+		/*Already expired, it will be called in the next tick processed*/
+		slot = &SCHED_root[SCHED_wheelTime & SCHED_ROOT_MASK];
+	} else if(index < SCHED_ROOT_SIZE){
+		slot = &SCHED_root[expires & SCHED_ROOT_MASK];
+	} else if(index < (1UL << (SCHED_ROOT_BITS + SCHED_LEVEL_BITS))){
+		slot = &SCHED_level[0][SCHED_INDEX(expires, 0)];
+	} else if(index < (1UL << (SCHED_ROOT_BITS + 2*SCHED_LEVEL_BITS))){
+		slot = &SCHED_level[1][SCHED_INDEX(expires, 1)];
+	} else {
+		/*Truncate delays that don't fit in the wheel*/
+		if(index > SCHED_MAX_DELAY){
+			expires = SCHED_wheelTime + SCHED_MAX_DELAY;
+			timer->expires = expires;
+		}
+		slot = &SCHED_level[2][SCHED_INDEX(expires, 2)];
+	}
+
+	/*Link the timer at the head of the slot*/
+	timer->next = *slot;
+	if(timer->next){
+		timer->next->pprev = &timer->next;
+	}
+	*slot = timer;
+	timer->pprev = slot;
+}
+
+/*Unlink a timer from its slot*/
+static void SCHED_remove(SCHED_TimerType* timer){
+	*timer->pprev = timer->next;
+	if(timer->next){
+		timer->next->pprev = timer->pprev;
+	}
+	timer->next = 0;
+	timer->pprev = 0;
+}
+
+/*Insert again all the timers of a slot in an upper level, returns the index of the slot*/
+static uint32 SCHED_cascade(uint8 level, uint32 index){
+	SCHED_TimerType* timer = SCHED_level[level][index];
+
+	SCHED_level[level][index] = 0;
+	while(timer){
+		SCHED_TimerType* next = timer->next;
+		SCHED_insert(timer);
+		timer = next;
+	}
+	return index;
+}
+
+void SCHED_init(){
+	uint16 index;
+
+	/*Empty the wheel*/
+	for(index = 0; index < SCHED_ROOT_SIZE; index++){
+		SCHED_root[index] = 0;
+	}
+	for(index = 0; index < SCHED_LEVELS*SCHED_LEVEL_SIZE; index++){
+		SCHED_level[index / SCHED_LEVEL_SIZE][index % SCHED_LEVEL_SIZE] = 0;
+	}
+	SCHED_tickCount = 0;
+	SCHED_wheelTime = 0;
+
+	/*Configure the PIT channel for a 1 ms period*/
+	PIT_clockGating();
+	PIT_enable();
+	PIT_loadCycles(SCHED_PIT, SYSTEM_CLOCK / SCHED_TICK_HZ);
+	PIT_callbackInstall(SCHED_PIT, SCHED_tick);
+	PIT_timerInterruptEnable(SCHED_PIT);
+	PIT_timerEnable(SCHED_PIT);
+	NVIC_enableInterruptAndPriority(PIT_CH2_IRQ, PRIORITY_6);
+}
+
+void SCHED_timerStart(SCHED_TimerType* timer, uint32 delay, uint32 period, SCHED_CallbackType callback){
+	/*Restarting a running timer, first take it out of the wheel*/
+	if(timer->pprev){
+		SCHED_remove(timer);
+	}
+	timer->expires = SCHED_tickCount + delay;
+	timer->period = period;
+	timer->callback = callback;
+	SCHED_insert(timer);
+}
+
+void SCHED_timerStop(SCHED_TimerType* timer){
+	if(timer->pprev){
+		SCHED_remove(timer);
+	}
+}
+
+uint8 SCHED_timerActive(const SCHED_TimerType* timer){
+	return (timer->pprev) ? TRUE : FALSE;
+}
+
+uint32 SCHED_ticks(){
+	return SCHED_tickCount;
+}
+
+void SCHED_dispatch(){
+	/*Process every tick that has elapsed since the last call*/
+	while((sint32)(SCHED_tickCount - SCHED_wheelTime) >= 0){
+		uint32 index = SCHED_wheelTime & SCHED_ROOT_MASK;
+		SCHED_TimerType* expired;
+
+		/*When the root level wraps, cascade the next slot of each level, as long as the
+		 * level below has wrapped too*/
+		if(!index &&
+				!SCHED_cascade(0, SCHED_INDEX(SCHED_wheelTime, 0)) &&
+				!SCHED_cascade(1, SCHED_INDEX(SCHED_wheelTime, 1))){
+			SCHED_cascade(2, SCHED_INDEX(SCHED_wheelTime, 2));
+		}
+		SCHED_wheelTime++;
+
+		/*Take the list out of the slot before calling any timer, so a timer that is started
+		 * again in this same slot (a period of 256 ticks) waits for the next lap instead of
+		 * being called twice in this tick*/
+		expired = SCHED_root[index];
+		SCHED_root[index] = 0;
+		if(expired){
+			expired->pprev = &expired;
+		}
+
+		/*Call every timer of the list. They are taken one by one, because a callback
+		 * may stop or start other timers*/
+		while(expired){
+			SCHED_TimerType* timer = expired;
+			SCHED_remove(timer);
+			if(timer->period){
+				timer->expires += timer->period;
+				SCHED_insert(timer);
+			}
+			timer->callback();
+		}
+	}
+}
@@ -0,0 +1,120 @@
+/**
+	\file
+	\brief
+		This is the header file for the scheduler. It uses PIT channel 2 to produce a
+		1 ms tick, and keeps the software timers in a hierarchical timer wheel, so starting,
+		stopping and expiring a timer costs the same no matter how many timers are running.
+		The expired timers are not called from the interruption; their callbacks are posted
+		to the main loop, which runs them from SCHED_dispatch().
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_SCHED_H_
+#define SOURCES_SCHED_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+#include "PIT.h"
+
+/** PIT channel that generates the scheduler tick. PIT_0 and PIT_1 are taken by the
+ * lifetime timer */
+#define SCHED_PIT PIT_2
+/** Frequency of the scheduler tick, one tick per millisecond */
+#define SCHED_TICK_HZ 1000
+
+/**
+ * Number of bits used by the first level of the wheel (1 ms slots) and by the
+ * upper levels. With 8 + 3*6 bits, a timer may expire up to 2^26 ms (about 18 hours)
+ * in the future; longer delays are truncated to that value.
+ * **/
+#define SCHED_ROOT_BITS 8
+#define SCHED_LEVEL_BITS 6
+#define SCHED_ROOT_SIZE (1 << SCHED_ROOT_BITS)
+#define SCHED_LEVEL_SIZE (1 << SCHED_LEVEL_BITS)
+#define SCHED_ROOT_MASK (SCHED_ROOT_SIZE - 1)
+#define SCHED_LEVEL_MASK (SCHED_LEVEL_SIZE - 1)
+/** Number of upper levels of the wheel */
+#define SCHED_LEVELS 3
+/** Longest delay that a timer can have, in ticks */
+#define SCHED_MAX_DELAY ((1UL << (SCHED_ROOT_BITS + SCHED_LEVELS*SCHED_LEVEL_BITS)) - 1)
+
+/*! Function that is called when a timer expires*/
+typedef void (*SCHED_CallbackType)(void);
+
+/**
+ * Struct SCHED_TimerType is a software timer. The memory is owned by the caller
+ * (usually a static variable in the module that uses the timer), so the scheduler
+ * never allocates. The members are private to the scheduler.
+ * **/
+typedef struct SCHED_Timer{
+	/*next timer in the same slot of the wheel*/
+	struct SCHED_Timer* next;
+	/*pointer to the link that points to this timer, so it is removed in O(1)*/
+	struct SCHED_Timer** pprev;
+	/*tick at which the timer expires*/
+	uint32 expires;
+	/*reload value in ticks, 0 for one-shot timers*/
+	uint32 period;
+	/*function called from the main loop when the timer expires*/
+	SCHED_CallbackType callback;
+}SCHED_TimerType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function configures SCHED_PIT to interrupt every millisecond and empties
+ 	 the timer wheel
+ 	 \return void
+ */
+void SCHED_init();
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts (or restarts) a timer. Must be called from the main loop
+ 	 (including the timer callbacks), never from an interruption.
+ 	 \param[in] timer - timer to be started
+ 	 \param[in] delay - ticks until the first expiration
+ 	 \param[in] period - ticks between expirations after the first one, 0 for a one-shot timer
+ 	 \param[in] callback - function to be called when the timer expires
+ 	 \return void
+ */
+void SCHED_timerStart(SCHED_TimerType* timer, uint32 delay, uint32 period, SCHED_CallbackType callback);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function stops a timer, if it is running. Its callback won't be called.
+ 	 \param[in] timer - timer to be stopped
+ 	 \return void
+ */
+void SCHED_timerStop(SCHED_TimerType* timer);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function tells if a timer is waiting to expire
+ 	 \param[in] timer - timer to be checked
+ 	 \return TRUE if the timer is running, FALSE otherwise
+ */
+uint8 SCHED_timerActive(const SCHED_TimerType* timer);
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the number of ticks since SCHED_init() was called
+ 	 \return uint32 - tick counter, it wraps after 49 days
+ */
+uint32 SCHED_ticks();
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function advances the wheel up to the current tick, and calls the callbacks
+ 	 of the timers that have expired. It has to be called from the main loop.
+ 	 \return void
+ */
+void SCHED_dispatch();
+
+#endif /* SOURCES_SCHED_H_ */
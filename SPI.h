@@ -84,13 +84,8 @@ typedef enum {SPI_0,
 			  } SPI_ChannelType;
 /*Type for master or slave configuration*/			  
 typedef enum{SPI_SLAVE,SPI_MASTER} SPI_MasterType;			  
-/*Type for GPIO configuration that activates the GPIO for SPI*/
-typedef struct{
-	GPIO_portNameType GPIO_portName;
-	uint32 SPI_clk;
-	uint32 SPI_Sout;
-}GPIOForSPIType;
-/*Type that is used for SPI configuration, It contains all the information needed for a SPI module*/
+/*Type that is used for SPI configuration, It contains all the information needed for a SPI module.
+ * The pins are configured by BOARD_init()*/
 typedef struct
 {
 	SPI_EnableFIFOType SPI_EnableFIFO;
@@ -99,16 +94,37 @@ typedef struct
 	SPI_LSMorMSBType SPI_LSMorMSB;
 	SPI_ChannelType SPI_Channel;
 	SPI_MasterType SPI_Master;		
-	GPIO_pinControlRegisterType pinConttrolRegisterPORTD;
 	uint8 baudrate;
 	uint32 frameSize;
-	GPIOForSPIType GPIOForSPI;
 } SPI_ConfigType;
 
 
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
+/**
+ * Registers of each SPI, indexed by SPI_ChannelType, so the driver doesn't need a switch
+ * for each instance
+ * **/
+extern SPI_Type* const SPI_handle[3];
+
+/*!
+ 	 \brief This sends a byte through a SPI and waits for the transference to complete. It
+ 	 receives the registers of the SPI (SPI0..SPI2 or SPI_handle[]), so it compiles with no
+ 	 branches other than the wait
+ 	 \param[in] spi registers of the SPI
+ 	 \param[in] Data to send
+ 	 \return void
+ */
+static inline void SPI_sendByte(SPI_Type* spi, uint8 Data){
+	/*Pushes the data in the TX FIFO*/
+	spi->PUSHR = (Data);
+	/*While transference is completed, wait*/
+	while(0 == (spi->SR & SPI_SR_TCF_MASK));
+	/*Clear the Transference complete flag*/
+	spi->SR |= SPI_SR_TCF_MASK;
+}
+
 /*!
  	 \brief This enables the SPI channel selected
  	 \param[in] channel SPI channel to be enabled
@@ -8,6 +8,10 @@
 #include "SYSUPD.h"
 #include "BTTN.h"
 #include "GPIO.h"
+#include "MK64F12.h"
+#include "ALRM.h"
+#include "BUZZ.h"
+#include "NVS.h"
 
 /**
  * MACRO that defines the conversion of a ADC conversion result, to an actual
@@ -31,6 +35,47 @@
  * **/
 #define FREQUENCY_OF(time1, time2) ((float)(SYSTEM_CLOCK/(time2+(0xFFFF-time1))))
 
+/**
+ * Sequence lock of SUF, SUFedit and SDF. sequence is odd while they are being updated,
+ * writeDepth counts the updates in progress, so an update from an interruption that
+ * interrupts another one doesn't make the sequence even before the first one ends
+ * **/
+static volatile uint32 SYSUPD_sequence = 0;
+static volatile uint8 SYSUPD_writeDepth = 0;
+
+/*Start an update of the flags*/
+static void SYSUPD_writeBegin(){
+	if(0 == SYSUPD_writeDepth++){
+		SYSUPD_sequence++;
+		__DMB();
+	}
+}
+
+/*End an update of the flags*/
+static void SYSUPD_writeEnd(){
+	if(0 == --SYSUPD_writeDepth){
+		__DMB();
+		SYSUPD_sequence++;
+	}
+}
+
+/**
+ * Dirty tracking of SDF. SYSUPD_formatted has the SUFedit values that SDF shows, so only
+ * the fields that changed are formatted again. Every time a field is formatted, its version
+ * grows; SYSUPD_SDFsnapshot() compares the versions with the ones of the previous copy
+ * (SYSUPD_snapshotVersion) to tell which fields are dirty. The versions are only written
+ * by the updates and the copy versions only by the reader, so nothing is ever cleared
+ * by two contexts
+ * **/
+static SystemUpdateFlags SYSUPD_formatted;
+static uint8 SYSUPD_formatValid = FALSE;
+static volatile uint8 SYSUPD_fieldVersion[SDF_FIELDS];
+static uint8 SYSUPD_snapshotVersion[SDF_FIELDS];
+static uint8 SYSUPD_snapshotValid = FALSE;
+
+/*Bring SDF up to date with SUFedit*/
+static void SYSUPD_format(uint8 force);
+
 /**
  * SystemUpdateFlags SUF, has the values that the system will take on account when checking
  * the motor, or the alarm. This values remain unaffected until setUpdate() function is called
@@ -73,8 +118,8 @@ static SystemUpdateFlags SUFedit = {
 };
 
 /**
- * SystemDisplayFlags SDF, has the values that will be displayed, as they are strings.
- * This values are based in SUFedit, by converting the SUFedit values to strings and storing
+ * SystemDisplayFlags SDF, has the values that will be displayed, as they are displayed.
+ * This values are based in SUFedit, by converting the SUFedit values to display units and storing
  * them here.
  * Again, this values are the ones that will be displayed, but not necessarily the ones the
  * system takes on account when setting the alarm, for example.
@@ -82,14 +127,13 @@ static SystemUpdateFlags SUFedit = {
  * **/
 static SystemDisplayFlags SDF = {
 		DEFAULT_DISP,
-		"030",
-		"080",
+		30,
+		80,
 		CELSIUS,
-		"015",
+		15,
 		AUTOMATIC,
-		"ZZZ.ZZ",
 		0,
-		"ZZZZZZZ.ZZ"
+		0
 };
 
 //args, stores the argument that will be passed to the button functionality functions
@@ -99,29 +143,45 @@ static uint8 args = 0;
 //order to update the system
 static uint16 buttonGlobal = 0;
 
+//SYSUPD_alarmPattern, pattern of the buzzer for each state of the alarm (ALRM_LevelType)
+static const BUZZ_PatternType SYSUPD_alarmPattern[3] = {BUZZ_OFF, BUZZ_CHIRP, BUZZ_CONTINUOUS};
+//SYSUPD_alarmLevel, state of the alarm that the buzzer plays
+static ALRM_LevelType SYSUPD_alarmLevel = ALRM_NONE;
+
 //tempCompare, stores a temperature value, so it can be compared with another, and check
 //if the motor has to decrease it's speed
 static uint8 tempCompare = 0;
 
+/*Button functionality: switchMenu() with the signature of the SUSM table*/
+static void switchMenuButton(uint8 nextState);
+
 /**
  * Main State machine, or array that contains the actions to be done in the system,
  * it is an struct array, that indicates which funcionality will have a button, according
  * to the current manu state
  * **/
-const SystemUpdateStateMachine SUSM[7] = {
+const SystemUpdateStateMachine SUSM[8] = {
 
 		/**
 		 * In the Default display menu, only the BUTTON_0 has the functionality of
 		 * switching the current menu, to the Menu display state
 		 * **/
 		{DEFAULT_DISP,{
-				{BUTTON_0, switchMenu, MENU_DISP},
+				{BUTTON_0, switchMenuButton, MENU_DISP},
 				{BUTTON_1, noFunct, 0},
 				{BUTTON_2, noFunct, 0},
 				{BUTTON_3, noFunct, 0},
 				{BUTTON_4, noFunct, 0},
 				{BUTTON_5, noFunct, 0},
 				{NULL_BUTTON, noFunct, 0}
+		},{
+				{BUTTON_0, 0, 0},
+				{BUTTON_1, 0, 0},
+				{BUTTON_2, 0, 0},
+				{BUTTON_3, 0, 0},
+				{BUTTON_4, 0, 0},
+				{BUTTON_5, 0, 0},
+				{NULL_BUTTON, 0, 0}
 		}},
 
 		/**
@@ -134,16 +194,26 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 *		BUTTON_3 -> go to the percentage decrease or increase display
 		 *		BUTTON_4 -> go to the motor control display
 		 *		BUTTON_5 -> go to the frequenciometer display
+		 *
+		 * Holding BUTTON_5 goes on to the trend graph, from the frequenciometer display
 		 * **/
 		{MENU_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
-				{BUTTON_1, switchMenu, ALARM_DISP},
-				{BUTTON_2, switchMenu, FORMAT_TEMP_DISP},
-				{BUTTON_3, switchMenu, PERCEN_DEC_DISP},
-				{BUTTON_4, switchMenu, CTRL_MANUAL_DISP},
-				{BUTTON_5, switchMenu, FREC_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
+				{BUTTON_1, switchMenuButton, ALARM_DISP},
+				{BUTTON_2, switchMenuButton, FORMAT_TEMP_DISP},
+				{BUTTON_3, switchMenuButton, PERCEN_DEC_DISP},
+				{BUTTON_4, switchMenuButton, CTRL_MANUAL_DISP},
+				{BUTTON_5, switchMenuButton, FREC_DISP},
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, 0, 0},
+				{BUTTON_1, 0, 0},
+				{BUTTON_2, 0, 0},
+				{BUTTON_3, 0, 0},
+				{BUTTON_4, 0, 0},
+				{BUTTON_5, 0, 0},
+				{NULL_BUTTON, 0, 0}
 		}},
 
 		/**
@@ -155,9 +225,11 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 * 		BUTTON_2 -> increase the alarm threshold by 1 degree
 		 * 		BUTTON_3 -> set the alarm threshold
 		 *
+		 * While BUTTON_1 or BUTTON_2 are held, the threshold keeps changing
+		 *
 		 * **/
 		{ALARM_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
 				{BUTTON_1, incUpdate, -1},
 				{BUTTON_2, incUpdate, 1},
 				{BUTTON_3, setUpdate, 0},
@@ -165,6 +237,14 @@ const SystemUpdateStateMachine SUSM[7] = {
 				{BUTTON_5, noFunct, 0},
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, noFunct, 0},
+				{BUTTON_1, incUpdate, -1},
+				{BUTTON_2, incUpdate, 1},
+				{BUTTON_3, noFunct, 0},
+				{BUTTON_4, noFunct, 0},
+				{BUTTON_5, noFunct, 0},
+				{NULL_BUTTON, noFunct, 0}
 		}},
 
 		/**
@@ -178,7 +258,7 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 *
 		 * **/
 		{FORMAT_TEMP_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
 				{BUTTON_1, incUpdate, CELSIUS},
 				{BUTTON_2, incUpdate, FAHRENHEIT},
 				{BUTTON_3, setUpdate, 0},
@@ -186,6 +266,14 @@ const SystemUpdateStateMachine SUSM[7] = {
 				{BUTTON_5, noFunct, 0},
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, 0, 0},
+				{BUTTON_1, 0, 0},
+				{BUTTON_2, 0, 0},
+				{BUTTON_3, 0, 0},
+				{BUTTON_4, 0, 0},
+				{BUTTON_5, 0, 0},
+				{NULL_BUTTON, 0, 0}
 		}},
 
 		/**
@@ -197,9 +285,11 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 * 		BUTTON_2 -> increase the percentage by 5
 		 * 		BUTTON_3 -> set the percentage of the increase or decrease
 		 *
+		 * While BUTTON_1 or BUTTON_2 are held, the percentage keeps changing
+		 *
 		 * **/
 		{PERCEN_DEC_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
 				{BUTTON_1, incUpdate, -5},
 				{BUTTON_2, incUpdate, 5},
 				{BUTTON_3, setUpdate, },
@@ -207,6 +297,14 @@ const SystemUpdateStateMachine SUSM[7] = {
 				{BUTTON_5, noFunct, 0},
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, noFunct, 0},
+				{BUTTON_1, incUpdate, -5},
+				{BUTTON_2, incUpdate, 5},
+				{BUTTON_3, noFunct, 0},
+				{BUTTON_4, noFunct, 0},
+				{BUTTON_5, noFunct, 0},
+				{NULL_BUTTON, noFunct, 0}
 		}},
 
 		/**
@@ -220,9 +318,11 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 * 		BUTTON_4 -> increase the motor speed by the percentage increase(if manual)
 		 * 		BUTTON_5 -> decrease the motor speed by the percentage decrease(if manual)
 		 *
+		 * While BUTTON_4 or BUTTON_5 are held, the motor speed keeps changing
+		 *
 		 * **/
 		{CTRL_MANUAL_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
 				{BUTTON_1, turnUpdate, AUTOMATIC},
 				{BUTTON_2, turnUpdate, MANUAL},
 				{BUTTON_3, setUpdate, },
@@ -230,6 +330,14 @@ const SystemUpdateStateMachine SUSM[7] = {
 				{BUTTON_5, incUpdate, },
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, noFunct, 0},
+				{BUTTON_1, noFunct, 0},
+				{BUTTON_2, noFunct, 0},
+				{BUTTON_3, noFunct, 0},
+				{BUTTON_4, incUpdate, 0},
+				{BUTTON_5, incUpdate, 0},
+				{NULL_BUTTON, noFunct, 0}
 		}},
 
 		/**
@@ -238,9 +346,12 @@ const SystemUpdateStateMachine SUSM[7] = {
 		 *
 		 * 		BUTTON_0 -> return to the default display
 		 *
+		 * Holding BUTTON_5 (the one that opened this display from the menu) goes to the
+		 * trend graph
+		 *
 		 * **/
 		{FREC_DISP,{
-				{BUTTON_0, switchMenu, DEFAULT_DISP},
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
 				{BUTTON_1, noFunct, 0},
 				{BUTTON_2, noFunct, 0},
 				{BUTTON_3, noFunct, 0},
@@ -248,60 +359,81 @@ const SystemUpdateStateMachine SUSM[7] = {
 				{BUTTON_5, noFunct, 0},
 				{NULL_BUTTON, noFunct, 0}
 
+		},{
+				{BUTTON_0, noFunct, 0},
+				{BUTTON_1, noFunct, 0},
+				{BUTTON_2, noFunct, 0},
+				{BUTTON_3, noFunct, 0},
+				{BUTTON_4, noFunct, 0},
+				{BUTTON_5, switchMenuButton, GRAPH_DISP},
+				{NULL_BUTTON, noFunct, 0}
+		}},
+
+		/**
+		 * In the trend graph display, the last temperature samples are plotted and
+		 * scrolled as they come, we have the following functionality
+		 *
+		 * 		BUTTON_0 -> return to the default display
+		 *
+		 * **/
+		{GRAPH_DISP,{
+				{BUTTON_0, switchMenuButton, DEFAULT_DISP},
+				{BUTTON_1, noFunct, 0},
+				{BUTTON_2, noFunct, 0},
+				{BUTTON_3, noFunct, 0},
+				{BUTTON_4, noFunct, 0},
+				{BUTTON_5, noFunct, 0},
+				{NULL_BUTTON, noFunct, 0}
+
+		},{
+				{BUTTON_0, 0, 0},
+				{BUTTON_1, 0, 0},
+				{BUTTON_2, 0, 0},
+				{BUTTON_3, 0, 0},
+				{BUTTON_4, 0, 0},
+				{BUTTON_5, 0, 0},
+				{NULL_BUTTON, 0, 0}
 		}},
 };
 
 /**
- * Initialize the System Update.
- * Sets the PTC2, PTB19 PTB18 as needed for using this for the PWM, Input Capture, and
- * Alarm buzzer
+ * This function is called, everytime a button is pressed, held or released
  * **/
-void SYSUPD_init(){
-
-	/*Enable the clock gating for PORTC*/
-	GPIO_clockGating(GPIOC); //PWM
-	/*Sets the PORTC PIN2, with the functionality of MUX4, so the Flex Timer 0
-	 * Channel 1 may use this pin*/
-	GPIO_pinControlRegisterType	pinControlRegisterPORTB = GPIO_MUX4;
-	GPIO_pinControlRegister(GPIOC,BIT2,&pinControlRegisterPORTB);
-
-	/*Enable the clock gating for PORTB*/
-	GPIO_clockGating(GPIOB); //INPUT CAPTURE
-	/*Sets the PORTB PIN19, with the functionality of MUX3, so the Flex Timer 2
-	 * Channel 1 may use this pin*/
-	GPIO_pinControlRegisterType	pinControlRegisterPORTC = GPIO_MUX3;
-	GPIO_pinControlRegister(GPIOB,BIT19,&pinControlRegisterPORTC);
-
-	/*Sets the PORTb PIN18, with the functionality of MUX1, so it is used
-	 * as an output*/
-	GPIO_pinControlRegisterType	pinControlRegisterPORTB18 = GPIO_MUX1;
-	GPIO_pinControlRegister(GPIOB,BIT18,&pinControlRegisterPORTB18);
-	GPIO_clearPIN(GPIOB,BIT18); // BUZZER
-	/*Sets PORT B pin 18 as an output*/
-	GPIO_dataDirectionPIN(GPIOB,GPIO_OUTPUT,BIT18);
-}
+void SYSUPD_update(uint16 button, BTTN_EventKindType event){
+	/*Functionality of the buttons for the event, according to the current state*/
+	const ButtonFunctStruct* buttonFunct;
+
+	if(BTTN_PRESS == event){
+		buttonFunct = SUSM[SUFedit.currentState].ButtonFunct;
+	} else if((BTTN_LONG == event) || (BTTN_REPEAT == event)){
+		buttonFunct = SUSM[SUFedit.currentState].HoldFunct;
+	} else {
+		return;
+	}
+	/*The state has no functionality for the held buttons*/
+	if(!buttonFunct[button].fptr_Button_func){
+		return;
+	}
+
+	SYSUPD_writeBegin();
 
-/**
- * This function is called, everytime a button is pressed
- * **/
-void SYSUPD_update(uint16 button){
 	/*Set the button received as a global variable*/
 	buttonGlobal = button;
 	/*Store in args, the argument for the function to be call (if needed), according
 	 * to the current state and the button pressed*/
-	args = SUSM[SUFedit.currentState].ButtonFunct[buttonGlobal].args1;
+	args = buttonFunct[buttonGlobal].args1;
 	/*Call the button functionality, according to the current state and the button
 	 * pressed*/
-	SUSM[SUFedit.currentState].ButtonFunct[buttonGlobal].fptr_Button_func(args);
+	buttonFunct[buttonGlobal].fptr_Button_func(args);
 
-	/*Copy the format and manual parameters of the editable SUF, to the displayable SDF
-	 * it format or manual wasnt edited, this isnt needed*/
-	SDF.currentFormat = SUFedit.currentFormat;
-	SDF.currentManual = SUFedit.currentManual;
+	/*Convert the values in SDF that were changed in SUFedit*/
+	SYSUPD_format(0);
+
+	SYSUPD_writeEnd();
+}
 
-	/*Convert to string the values in SDF, taking in count the ones in SUFedit*/
-	floatToString();
-	uint8ToString();
+static void switchMenuButton(uint8 nextState){
+	switchMenu((MenuStateType)nextState);
 }
 
 /*Button functionality: switchMenu*/
@@ -310,8 +442,6 @@ void switchMenu(MenuStateType nextState){
 	SUF.currentState = nextState;
 	/*Set the change, also in SUFedit*/
 	SUFedit.currentState = nextState;
-	/*Set the change, also in SDF*/
-	SDF.currentState = SUF.currentState;
 	/*Copy SUF data to SUFeddit, this happens, because if we were editting a parameter,
 	 * for example: alarm, and if we didnt set the update, when we get back we get the
 	 * previous alarm, before editting. */
@@ -389,13 +519,22 @@ void turnUpdate(uint8 currentTurn){
 
 /*Button functionality: setUpdate*/
 void setUpdate(uint8 currentParam){
+	/*settings to keep in flash*/
+	NVS_SettingsType settings;
 
 	/*Set currentState as DEFAULT_DISP, meaning that we go back to the default display*/
 	SUFedit.currentState = DEFAULT_DISP;
 
 	/*The editable SUF, now is the current SUF that the system will take on account*/
 	SUF = SUFedit;
-	SDF.currentState = DEFAULT_DISP;
+
+	/*Keep the settings for the next power up, the flash is written in background*/
+	settings.alarm = SUF.currentAlarm;
+	settings.format = SUF.currentFormat;
+	settings.perInc = SUF.currentPerInc;
+	settings.manual = SUF.currentManual;
+	settings.speed = SUF.currentSpeed;
+	NVS_save(&settings);
 	return;
 }
 
@@ -415,82 +554,239 @@ SystemUpdateFlags* SYSUPD_SUF(){
 	return &SUF;
 }
 
-/**/
-void floatToString(){
+/*Copy SUF between two updates*/
+void SYSUPD_SUFsnapshot(SystemUpdateFlags* snapshot){
+	uint32 sequence;
+
+	do{
+		/*wait for the update in progress, if any*/
+		while((sequence = SYSUPD_sequence) & 1);
+		__DMB();
+		*snapshot = SUF;
+		__DMB();
+	}while(sequence != SYSUPD_sequence);
+}
 
-	float data_in = SUFedit.currentTemperature * 100;
+/*Tell if the settings are in the ranges of the buttons*/
+static uint8 SYSUPD_settingsValid(const NVS_SettingsType* settings){
+	return ((settings->alarm >= ALARM_MIN) && (settings->alarm <= ALARM_MAX) &&
+			(settings->format <= FAHRENHEIT) && (settings->manual <= MANUAL) &&
+			(settings->perInc >= PERCEN_MIN) && (settings->perInc <= PERCEN_MAX) &&
+			(settings->speed <= PERCEN_MAX)) ? TRUE : FALSE;
+}
 
-	if(SUFedit.currentFormat != CELSIUS){
-		data_in = (data_in*1.8) + 3200;
+/*Set the settings kept in flash*/
+uint8 SYSUPD_settingsRestore(){
+	NVS_SettingsType settings;
+
+	if(!NVS_restore(&settings)){
+		return FALSE;
+	}
+	/*A record of another version of the application may have other ranges*/
+	if(!SYSUPD_settingsValid(&settings)){
+		return FALSE;
 	}
 
-	int data_out = data_in;
+	SYSUPD_writeBegin();
+	SUF.currentAlarm = settings.alarm;
+	SUF.currentFormat = settings.format;
+	SUF.currentPerInc = settings.perInc;
+	SUF.currentManual = settings.manual;
+	SUF.currentSpeed = settings.speed;
+	SUFedit = SUF;
+	SYSUPD_format(0);
+	SYSUPD_writeEnd();
+	return TRUE;
+}
 
-	SDF.currentTemperature[0] = (char)(data_out / 10000) + 48;
-	SDF.currentTemperature[1] = (char)((data_out - ((SDF.currentTemperature[0] - 48) * 10000)) / 1000) + 48;
-	SDF.currentTemperature[2] = (char)((data_out - ((SDF.currentTemperature[0] - 48) * 10000 + (SDF.currentTemperature[1] - 48) * 1000)) / 100) + 48;
-	SDF.currentTemperature[4] = (char)((data_out - ((SDF.currentTemperature[0] - 48) * 10000 + (SDF.currentTemperature[1] - 48) * 1000 + (SDF.currentTemperature[2] - 48) * 100)) / 10) + 48;
-	SDF.currentTemperature[5] = (char)(data_out - ((SDF.currentTemperature[0] - 48) * 10000 + (SDF.currentTemperature[1] - 48) * 1000 + (SDF.currentTemperature[2] - 48)* 100 + (SDF.currentTemperature[4] - 48) * 10)) + 48;
+/*Set the settings at once, through setUpdate()*/
+uint8 SYSUPD_settingsWrite(const NVS_SettingsType* settings){
+	if(!SYSUPD_settingsValid(settings)){
+		return FALSE;
+	}
 
-	data_in = SUFedit.currentFrec * 100;
+	SYSUPD_writeBegin();
+	SUFedit = SUF;
+	SUFedit.currentAlarm = settings->alarm;
+	SUFedit.currentFormat = settings->format;
+	SUFedit.currentPerInc = settings->perInc;
+	SUFedit.currentManual = settings->manual;
+	SUFedit.currentSpeed = settings->speed;
+	setUpdate(0);
+	SYSUPD_format(0);
+	SYSUPD_writeEnd();
+	return TRUE;
+}
 
-	data_out = data_in;
+/*Copy SDF between two updates, and tell which fields changed since the last copy*/
+uint8 SYSUPD_SDFsnapshot(SystemDisplayFlags* snapshot){
+	uint8 version[SDF_FIELDS];
+	uint8 dirty = 0;
+	uint32 sequence;
+	uint8 field;
+
+	do{
+		/*wait for the update in progress, if any*/
+		while((sequence = SYSUPD_sequence) & 1);
+		__DMB();
+		*snapshot = SDF;
+		for(field = 0; field < SDF_FIELDS; field++){
+			version[field] = SYSUPD_fieldVersion[field];
+		}
+		__DMB();
+	}while(sequence != SYSUPD_sequence);
 
-	SDF.currentFrec[0] = (char)(data_out / 100000000) + 48;
-	SDF.currentFrec[1] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000)) / 10000000) + 48;
-	SDF.currentFrec[2] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000)) / 1000000) + 48;
-	SDF.currentFrec[3] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000)) / 100000) + 48;
-	SDF.currentFrec[4] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000 + (SDF.currentFrec[3] - 48) * 100000)) / 10000) + 48;
-	SDF.currentFrec[5] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000 + (SDF.currentFrec[3] - 48) * 100000 + (SDF.currentFrec[4] - 48) * 10000)) / 1000) + 48;
-	SDF.currentFrec[6] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000 + (SDF.currentFrec[3] - 48) * 100000 + (SDF.currentFrec[4] - 48) * 10000 + (SDF.currentFrec[5] - 48) * 1000)) / 100) + 48;
-	SDF.currentFrec[8] = (char)((data_out - ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000 + (SDF.currentFrec[3] - 48) * 100000 + (SDF.currentFrec[4] - 48) * 10000 + (SDF.currentFrec[5] - 48) * 1000 + (SDF.currentFrec[6] - 48) * 100)) / 10) + 48;
-	SDF.currentFrec[9] = (char)(data_out -  ((SDF.currentFrec[0] - 48) * 100000000 + (SDF.currentFrec[1] - 48) * 10000000 + (SDF.currentFrec[2] - 48) * 1000000 + (SDF.currentFrec[3] - 48) * 100000 + (SDF.currentFrec[4] - 48) * 10000 + (SDF.currentFrec[5] - 48) * 1000 + (SDF.currentFrec[6] - 48) * 100 + (SDF.currentFrec[8] - 48) * 10)) + 48;
+	/*The first copy has every field dirty*/
+	for(field = 0; field < SDF_FIELDS; field++){
+		if((FALSE == SYSUPD_snapshotValid) || (version[field] != SYSUPD_snapshotVersion[field])){
+			dirty |= 1 << field;
+		}
+		SYSUPD_snapshotVersion[field] = version[field];
+	}
+	SYSUPD_snapshotValid = TRUE;
+	return dirty;
 }
 
-void uint8ToString(){
+/**/
+/*Format the temperature of SUFedit in SDF, in hundredths of degree of the current format*/
+static void temperatureToDisplay(){
+	float data_in = SUFedit.currentTemperature * 100;
+
+	if(SUFedit.currentFormat != CELSIUS){
+		data_in = (data_in*1.8) + 3200;
+	}
+
+	SDF.currentTemperature = (sint32)data_in;
+}
+
+/*Format the frequency of SUFedit in SDF, in hundredths of Hz*/
+static void frecToDisplay(){
+	SDF.currentFrec = (uint32)(SUFedit.currentFrec * 100);
+}
+
+/*Format the alarm threshold of SUFedit in SDF, in the current format*/
+static void alarmToDisplay(){
 	int data_out = SUFedit.currentAlarm;
 
 	if(SUFedit.currentFormat != CELSIUS){
 		data_out = (data_out*1.8) + 32;
 	}
 
-	SDF.currentAlarm[0] = (char)(data_out / 100) + 48;
-	SDF.currentAlarm[1] = (char)((data_out - ((SDF.currentAlarm[0] - 48) * 100)) / 10) + 48;
-	SDF.currentAlarm[2] = (char)(data_out - ((SDF.currentAlarm[0] - 48) * 100 + (SDF.currentAlarm[1] - 48) * 10)) + 48;
+	SDF.currentAlarm = (sint16)data_out;
+}
+
+/*Format the percentage increase of SUFedit in SDF*/
+static void perIncToDisplay(){
+	SDF.currentPerInc = SUFedit.currentPerInc;
+}
+
+/*Format the motor speed of SUFedit in SDF*/
+static void speedToDisplay(){
+	SDF.currentSpeed = SUFedit.currentSpeed;
+}
+
+/*Bring SDF up to date with SUFedit, formatting only the fields that changed (plus the ones
+ * in force), and mark them dirty for the display*/
+static void SYSUPD_format(uint8 force){
+	uint8 changed = force;
+	uint8 field;
 
-	data_out = SUFedit.currentPerInc;
-	SDF.currentPerInc[0] = (char)(data_out / 100) + 48;
-	SDF.currentPerInc[1] = (char)((data_out - ((SDF.currentPerInc[0] - 48) * 100)) / 10) + 48;
-	SDF.currentPerInc[2] = (char)(data_out - ((SDF.currentPerInc[0] - 48) * 100 + (SDF.currentPerInc[1] - 48) * 10)) + 48;
+	/*The first time every field is formatted*/
+	if(FALSE == SYSUPD_formatValid){
+		changed = SDF_ALL_DIRTY;
+		SYSUPD_formatValid = TRUE;
+	}
+
+	/*Compare SUFedit with the values that SDF shows*/
+	if(SUFedit.currentState != SYSUPD_formatted.currentState){
+		changed |= SDF_STATE_DIRTY;
+	}
+	if(SUFedit.currentAlarm != SYSUPD_formatted.currentAlarm){
+		changed |= SDF_ALARM_DIRTY;
+	}
+	if(SUFedit.currentSpeed != SYSUPD_formatted.currentSpeed){
+		changed |= SDF_SPEED_DIRTY;
+	}
+	/*The temperature and the alarm are shown in the current format*/
+	if(SUFedit.currentFormat != SYSUPD_formatted.currentFormat){
+		changed |= SDF_FORMAT_DIRTY | SDF_TEMPERATURE_DIRTY | SDF_ALARM_DIRTY;
+	}
+	if(SUFedit.currentPerInc != SYSUPD_formatted.currentPerInc){
+		changed |= SDF_PERINC_DIRTY;
+	}
+	if(SUFedit.currentManual != SYSUPD_formatted.currentManual){
+		changed |= SDF_MANUAL_DIRTY;
+	}
+	if(SUFedit.currentTemperature != SYSUPD_formatted.currentTemperature){
+		changed |= SDF_TEMPERATURE_DIRTY;
+	}
+	if(SUFedit.currentFrec != SYSUPD_formatted.currentFrec){
+		changed |= SDF_FREC_DIRTY;
+	}
+	SYSUPD_formatted = SUFedit;
 
-	data_out = SUFedit.currentSpeed;
-	SDF.currentSpeed[0] = (char)(data_out / 100) + 48;
-	SDF.currentSpeed[1] = (char)((data_out - ((SDF.currentSpeed[0] - 48) * 100)) / 10) + 48;
-	SDF.currentSpeed[2] = (char)(data_out - ((SDF.currentSpeed[0] - 48) * 100 + (SDF.currentSpeed[1] - 48) * 10)) + 48;
+	/*Copy the state, format and manual parameters, and convert the values
+	 * that changed*/
+	SDF.currentState = SUFedit.currentState;
+	SDF.currentFormat = SUFedit.currentFormat;
+	SDF.currentManual = SUFedit.currentManual;
+	if(changed & SDF_TEMPERATURE_DIRTY){
+		temperatureToDisplay();
+	}
+	if(changed & SDF_FREC_DIRTY){
+		frecToDisplay();
+	}
+	if(changed & SDF_ALARM_DIRTY){
+		alarmToDisplay();
+	}
+	if(changed & SDF_PERINC_DIRTY){
+		perIncToDisplay();
+	}
+	if(changed & SDF_SPEED_DIRTY){
+		speedToDisplay();
+	}
 
+	/*A new version of each field that changed*/
+	for(field = 0; field < SDF_FIELDS; field++){
+		if(changed & (1 << field)){
+			SYSUPD_fieldVersion[field]++;
+		}
+	}
+}
 
+/*Format again the temperature and the frequency*/
+void floatToString(){
+	SYSUPD_format(SDF_TEMPERATURE_DIRTY | SDF_FREC_DIRTY);
+}
 
+/*Format again the alarm, the percentage increase and the speed*/
+void uint8ToString(){
+	SYSUPD_format(SDF_ALARM_DIRTY | SDF_PERINC_DIRTY | SDF_SPEED_DIRTY);
 }
 
 /*Changes the current temperature*/
 void changeTemperature(float temperature){
 	/*SUFedit and SUF get the new temperature, which is based in the ADC
 	 * convertion result and TEMPERATURE() Macro function*/
+	SYSUPD_writeBegin();
 	SUFedit.currentTemperature = TEMPERATURE(temperature);
 	SUF.currentTemperature = TEMPERATURE(temperature);
-	/*Convert the SUFedit temperature to float in the SDF*/
-	floatToString();
+	/*Convert the SUFedit temperature in the SDF, if it changed*/
+	SYSUPD_format(0);
+	SYSUPD_writeEnd();
 }
 
-/*Check that the temperature is below the threshold*/
+/*Check that the temperature is below the threshold, and that it won't reach it soon*/
 void temperatureAlarmCheck(){
-	/*If the current alarm is greater or equal to the threshold...*/
-	if(SUF.currentTemperature >= SUF.currentAlarm){
-		/*... turn on the BUZZER*/
-		GPIO_setPIN(GPIOB,BIT18); //BUZZER
-	} else {
-		/*... else, turn off the BUZZER*/
-		GPIO_clearPIN(GPIOB,BIT18); //BUZZER
+	/*The alarm works in hundredths of degree*/
+	sint32 temperature = (sint32)(SUF.currentTemperature * 100 + 0.5);
+	ALRM_LevelType level = ALRM_update(temperature, (sint32)SUF.currentAlarm * 100);
+
+	/*The BUZZER plays by itself, it is only told when the alarm changes: continuous if the
+	 * temperature reached the threshold, chirps if it is going to reach it, else off*/
+	if(level != SYSUPD_alarmLevel){
+		SYSUPD_alarmLevel = level;
+		BUZZ_set(SYSUPD_alarmPattern[level]);
 	}
 }
 
@@ -512,9 +808,11 @@ void temperatureMotorControl(){
 
 		//If we are able to decrease, we decrease the motor speed
 		if(SUF.currentSpeed - 15 > PERCEN_MIN){
+			SYSUPD_writeBegin();
 			SUF.currentSpeed = SUF.currentSpeed - 15;
 			SUFedit.currentSpeed = SUF.currentSpeed;
-			uint8ToString();
+			SYSUPD_format(0);
+			SYSUPD_writeEnd();
 		}
 		tempCompare = SUF.currentTemperature;
 
@@ -527,6 +825,7 @@ void changeFrequency(uint16 time1, uint16 time2){
 
 	/*Using the FREQUENCY and FREQUENCY_OF Macro functions, we get the
 	 * actual frequency from time1 and time2 values*/
+	SYSUPD_writeBegin();
 	if(time2>time1){
 		SUFedit.currentFrec = FREQUENCY(time1, time2);
 	} else {
@@ -534,7 +833,8 @@ void changeFrequency(uint16 time1, uint16 time2){
 	}
 	SUF.currentFrec = SUFedit.currentFrec;
 
-	/*Convert the measured frequency in SUFedit, to string in SDF*/
-	floatToString();
+	/*Convert the measured frequency in SUFedit, in SDF, if it changed*/
+	SYSUPD_format(0);
+	SYSUPD_writeEnd();
 }
 
@@ -9,12 +9,9 @@
 #define SOURCES_SYSUPD_H_
 
 #include "BTTN.h"
-
-/**
- * Define SYSTEM_CLOCK as the constant that represents the system clock frequency
- * for calculation purposes in the algorithm
- * */
-#define SYSTEM_CLOCK 21000000
+#include "GlobalFunctions.h"
+#include "BOARD.h"
+#include "NVS.h"
 
 /**
  * Define MAX_VOLT as the constant that represents the max ADC convertion result voltage
@@ -46,6 +43,22 @@
 #define ALARM_MIN 15
 #define ALARM_MAX 45
 
+/**
+ * Bits of the dirty mask of SystemDisplayFlags, one per field. A field is dirty when its
+ * value changed since the previous SYSUPD_SDFsnapshot()
+ * */
+#define SDF_STATE_DIRTY			0x01
+#define SDF_ALARM_DIRTY			0x02
+#define SDF_SPEED_DIRTY			0x04
+#define SDF_FORMAT_DIRTY		0x08
+#define SDF_PERINC_DIRTY		0x10
+#define SDF_MANUAL_DIRTY		0x20
+#define SDF_TEMPERATURE_DIRTY	0x40
+#define SDF_FREC_DIRTY			0x80
+#define SDF_ALL_DIRTY			0xFF
+/** Number of fields with a dirty bit */
+#define SDF_FIELDS 8
+
 /**
  * Define the minimum and maximum percentages decrease, for the motor control
  */
@@ -64,7 +77,8 @@ typedef enum{
 			FORMAT_TEMP_DISP,
 			PERCEN_DEC_DISP,
 			CTRL_MANUAL_DISP,
-			FREC_DISP
+			FREC_DISP,
+			GRAPH_DISP
 			}MenuStateType;
 
 /**
@@ -95,7 +109,8 @@ typedef struct{
 
 /**
  * Struct that defines the state machine for the system updater, it has the currentDisplayState
- * and an array of 7 button functionality structs.
+ * and two arrays of 7 button functionality structs, one for the presses and one for the
+ * buttons that are held.
  * **/
 typedef struct{
 			/**
@@ -108,6 +123,13 @@ typedef struct{
 			 * each button, according to the currentDisplayState
 			 * **/
 			ButtonFunctStruct ButtonFunct[7];
+			/**
+			 * ButtonFunctStruct HoldFunct[7], is the array that has functionality for
+			 * each button while it is held (BTTN_LONG and BTTN_REPEAT events), according
+			 * to the currentDisplayState. The buttons that do nothing while held have
+			 * fptr_Button_func in 0, so their events are ignored
+			 * **/
+			ButtonFunctStruct HoldFunct[7];
 			}SystemUpdateStateMachine;
 
 			/**
@@ -159,7 +181,8 @@ typedef struct{
 			 * system (alarm, temperature, speed, etc.), that will be actually displayed in the
 			 * screen. This values, could be not the ones that the system takes on account,
 			 *  (while editting, for example).
-			 *  This struct, has the values 'transformed' to strings, in order to display them
+			 *  This struct, has the values as they are displayed (format and fixed point), DISP
+			 *  draws the digits straight from them
 			 * **/
 typedef struct{
 			/**
@@ -167,71 +190,52 @@ typedef struct{
 			 * **/
 			MenuStateType currentState;
 			/**
-			 * char currentAlarm[6] is the char array that contains the "displayable" alarm
-			 * value
+			 * sint16 currentAlarm is the alarm threshold that will be displayed, in degrees
+			 * of the current format
 			 * **/
-			char currentAlarm[6];
+			sint16 currentAlarm;
 			/**
-			 * char currentSpeed[6] is the char array that contains the "displayable" speed
-			 * value
+			 * uint8 currentSpeed is the speed percentage that will be displayed
 			 * **/
-			char currentSpeed[6];
+			uint8 currentSpeed;
 			/**
 			 * uint8 currentFormat, is the temperature format that will be displayed
 			 * **/
 			uint8 currentFormat :1;
 			/**
-			 * char currentPerInc[6] is the char array that contains the "displayable"
-			 * percentage increase value
+			 * uint8 currentPerInc is the percentage increase that will be displayed
 			 * **/
-			char currentPerInc[6];
+			uint8 currentPerInc;
 			/**
 			 * uint8 currentManual, is the state of the motor, is it will be controled manually or
 			 * by temperature
 			 * **/
 			uint8 currentManual :1;
 			/**
-			 * char currentTemperature[6] is the char array that contains the "displayable"
-			 * temperature value
+			 * sint32 currentTemperature is the temperature that will be displayed, in
+			 * hundredths of degree of the current format
 			 * **/
-			char currentTemperature[6];
+			sint32 currentTemperature;
 			/**
-			 * This value, is used as a divider between the temperature string and the
-			 * frequency string
+			 * uint32 currentFrec is the frequency that will be displayed, in hundredths of Hz
 			 * **/
-			uint8 div:1;
-			/**
-			 * char currentFrec[10] is the char array that contains the "displayable"
-			 * frequency value
-			 * **/
-			char currentFrec[10];
+			uint32 currentFrec;
 			}SystemDisplayFlags;
 
-
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
 	 \brief
-		 This function is initializes everything related to the system, such as output pins,
-		 for PWM, input pins for frequencymeter, etc.
+		 This function receives a button event that will update the system, according to the
+		 current state, the kind of event and the button functionality. The presses use
+		 ButtonFunct, the long presses and repeats use HoldFunct, and the releases are ignored.
+	 \param[in] button - button of the event, that will update the system
+	 \param[in] event - what happened to the button
 	 \return void
 
  */
-void SYSUPD_init();
-
-/********************************************************************************************/
-/********************************************************************************************/
-/********************************************************************************************/
-/*!
-	 \brief
-		 This function receives a button that will update the system, according to the
-		 current state, and the button functionality.
-	 \param[in] button - button pressed, that will update the system
-	 \return void
-
- */
-void SYSUPD_update(uint16 button);
+void SYSUPD_update(uint16 button, BTTN_EventKindType event);
 
 /********************************************************************************************/
 /********************************************************************************************/
@@ -283,6 +287,7 @@ void turnUpdate(uint8 currentTurn);
 		 parameters, this is: when this function is called, is because the B3 was pressed,
 		 meaning that all the changes that the user made, will now be taken on account.
 		 Example: Set the edited alarm, as the current alarm
+		 The settings are also kept in flash (see NVS.h), the write is done in background.
 	 \param[in] currentParam - new fixed parameter
 	 \return void
 
@@ -311,6 +316,8 @@ void noFunct(uint8 none);
 		 This function returns the system flags (alarm, speed, temperature) that will be
 		 displayed in the LCD, this could be not the ones that the system takes on account
 		 (When editting, for example)
+		 The struct may change while it is read, if a writer interrupts the reader; use
+		 SYSUPD_SDFsnapshot() to get a consistent copy
 	 \return SystemDisplayFlags* - pointer of the displayable data struct
 
  */
@@ -323,19 +330,84 @@ SystemDisplayFlags* SYSUPD_SDF();
 		 This function returns the system flags (alarm, speed, temperature) that will be
 		 taken on account by the system, this could be not the ones that are displayed
 		 (when editting for example)
+		 The struct may change while it is read, if a writer interrupts the reader; use
+		 SYSUPD_SUFsnapshot() to get a consistent copy
 	 \return SystemUpdateFlags* - pointer of the data struct
 
  */
 SystemUpdateFlags* SYSUPD_SUF();
 
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+	 \brief
+		 This function copies the SystemUpdateFlags into snapshot, as they were between two
+		 updates. The flags are protected by a sequence lock: every update makes the sequence
+		 odd while it runs and even when it ends, and the copy is taken again if the sequence
+		 changed meanwhile. The writers never wait and the interruptions are never masked.
+		 It must be called from the main loop; an interruption that interrupts an update
+		 would wait for it forever.
+	 \param[out] snapshot - consistent copy of the flags
+	 \return void
+
+ */
+void SYSUPD_SUFsnapshot(SystemUpdateFlags* snapshot);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+	 \brief
+		 This function sets the alarm, format, percentage, motor control and speed that were
+		 kept in flash by setUpdate(), so they survive a power cycle. NVS_init() must be
+		 called before. The values out of range are not used, the initial ones are kept.
+	 \return uint8 - TRUE if the settings were restored
+
+ */
+uint8 SYSUPD_settingsRestore();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+	 \brief
+		 This function sets the alarm, format, percentage, motor control and speed at once,
+		 as if they were edited and set with the buttons: the edition in progress, if any,
+		 is dropped, the new values go through setUpdate(), that keeps them in flash and
+		 goes back to the default display. It is called from the main loop (the command
+		 channel).
+	 \param[in] settings - values to set
+	 \return uint8 - FALSE if a value is out of range, nothing is set
+
+ */
+uint8 SYSUPD_settingsWrite(const NVS_SettingsType* settings);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+	 \brief
+		 This function copies the SystemDisplayFlags into snapshot, as they were between two
+		 updates, with the same sequence lock of SYSUPD_SUFsnapshot(). It also tells which
+		 fields changed since the previous copy, so the display can skip the ones that
+		 didn't. The first copy has every field dirty.
+	 \param[out] snapshot - consistent copy of the displayable flags
+	 \return uint8 - dirty mask (SDF_..._DIRTY) of the fields that changed
+
+ */
+uint8 SYSUPD_SDFsnapshot(SystemDisplayFlags* snapshot);
+
 /********************************************************************************************/
 /********************************************************************************************/
 /********************************************************************************************/
 /*!
 	 \brief
 		 This function converts the 'raw' data to 'displayable' data, meaning that the data
-		 in the SystemUpdateFlags is converted in to strings, and stored in the SystemDisplay
+		 in the SystemUpdateFlags is converted to the displayed units, and stored in the SystemDisplay
 		 Flags. (Converts frequency and temperature)
+		 The updates of SYSUPD only convert the fields that changed; this function converts
+		 them even if they didn't, and marks them dirty
 	 \return void
 
  */
@@ -347,8 +419,10 @@ void floatToString();
 /*!
 	 \brief
 		 This function converts the 'raw' data to 'displayable' data, meaning that the data
-		 in the SystemUpdateFlags is converted in to strings, and stored in the SystemDisplay
+		 in the SystemUpdateFlags is converted to the displayed units, and stored in the SystemDisplay
 		 Flags. (Converts Alarm, Speed and Percentage Increase)
+		 The updates of SYSUPD only convert the fields that changed; this function converts
+		 them even if they didn't, and marks them dirty
 	 \return void
 
  */
@@ -376,7 +450,10 @@ void changeTemperature(float temperature);
 /*!
 	 \brief
 		 This function is called after receiving a temperature value. Checks that the temperature
-		 is under the alarm threshold, if not, it turns on a buzzer.
+		 is under the alarm threshold, if not, the buzzer sounds continuously. If the trend
+		 of the last samples reaches the threshold within the horizon of ALRM_init(), the
+		 buzzer chirps (see ALRM.h). The pattern of the buzzer is only set when the state of
+		 the alarm changes (see BUZZ.h).
 		 The alarm check, is done always, with the temperature format as Celsius.
 	 \return void
 
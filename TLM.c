@@ -0,0 +1,83 @@
+/**
+	\file
+	\brief
+		This is the source file for the telemetry. The frame is packed only when the DMA is
+		done with the previous one, so a single buffer is enough: the CPU writes it while
+		the DMA is stopped, and the DMA reads it while the CPU doesn't touch it.
+	\date	19/10/2026
+ */
+
+#include "TLM.h"
+#include "UART.h"
+#include "SCHED.h"
+#include "SYSUPD.h"
+#include "ALRM.h"
+#include "CRC.h"
+
+/*Timer of the frames*/
+static SCHED_TimerType TLM_timer;
+/*Frame being packed, and encoded as the DMA sends it*/
+static uint8 TLM_frame[TLM_FRAME_SIZE];
+static uint8 TLM_encoded[TLM_ENCODED_SIZE];
+/*Sequence number of the next frame*/
+static uint16 TLM_sequence = 0;
+static TLM_StatsType TLM_statistics = {0, 0};
+
+/*Write a value in little endian*/
+static void TLM_put(uint8 offset, uint32 value, uint8 bytes){
+	while(bytes--){
+		TLM_frame[offset++] = (uint8)value;
+		value >>= 8;
+	}
+}
+
+/*Pack the flags in TLM_frame*/
+static void TLM_pack(const SystemUpdateFlags* flags){
+	uint16 crc;
+
+	TLM_frame[TLM_KIND_OFFSET] = TLM_KIND_STATUS;
+	TLM_frame[TLM_FLAGS_OFFSET] = (flags->currentFormat ? TLM_FLAG_FORMAT : 0) |
+			(flags->currentManual ? TLM_FLAG_MANUAL : 0) |
+			(((uint8)ALRM_level() << TLM_LEVEL_SHIFT) & TLM_LEVEL_MASK);
+	TLM_put(TLM_SEQUENCE_OFFSET, TLM_sequence, 2);
+	TLM_put(TLM_TIME_OFFSET, SCHED_ticks(), 4);
+	TLM_put(TLM_TEMPERATURE_OFFSET, (uint32)(sint32)(flags->currentTemperature * 100 + 0.5), 4);
+	TLM_put(TLM_FREC_OFFSET, (uint32)(sint32)(flags->currentFrec * 100 + 0.5), 4);
+	TLM_frame[TLM_SPEED_OFFSET] = flags->currentSpeed;
+	TLM_frame[TLM_ALARM_OFFSET] = flags->currentAlarm;
+	TLM_frame[TLM_PERINC_OFFSET] = flags->currentPerInc;
+	TLM_frame[TLM_STATE_OFFSET] = (uint8)flags->currentState;
+	crc = CRC_ccitt(CRC_INIT, TLM_frame, TLM_CRC_OFFSET);
+	TLM_put(TLM_CRC_OFFSET, crc, 2);
+}
+
+/*Period of the frames, send the next one if the DMA is done with the previous one*/
+static void TLM_send(){
+	SystemUpdateFlags flags;
+
+	if(UART_sendBusy()){
+		TLM_statistics.dropped++;
+		TLM_sequence++;
+		return;
+	}
+	SYSUPD_SUFsnapshot(&flags);
+	TLM_pack(&flags);
+	UART_send(TLM_encoded, COBS_encode(TLM_frame, TLM_FRAME_SIZE, TLM_encoded));
+	TLM_statistics.sent++;
+	TLM_sequence++;
+}
+
+void TLM_init(uint16 period){
+	SCHED_timerStop(&TLM_timer);
+	if(!period){
+		return;
+	}
+	if(period < TLM_PERIOD_MIN){
+		period = TLM_PERIOD_MIN;
+	}
+	SCHED_timerStart(&TLM_timer, period, period, TLM_send);
+}
+
+void TLM_stats(TLM_StatsType* stats){
+	*stats = TLM_statistics;
+}
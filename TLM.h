@@ -0,0 +1,88 @@
+/**
+	\file
+	\brief
+		This is the header file for the telemetry. Every period a scheduler timer takes a
+		consistent snapshot of the SystemUpdateFlags, packs it in a frame of fixed layout,
+		adds a CRC and encodes it with COBS in the buffer that the DMA sends through UART0;
+		the bytes are never copied by the CPU. If the previous frame is still being sent,
+		the new one is dropped, the sequence number tells the receiver that it is missing.
+
+		Frame layout (little endian), TLM_FRAME_SIZE bytes before COBS:
+		 - uint8 TLM_KIND_STATUS, the kind of frame
+		 - uint8 flags: bit 0 temperature format, bit 1 manual motor control, bits 2 and 3
+		   the state of the alarm (ALRM_LevelType)
+		 - uint16 sequence number, one more every period, also for the frames dropped
+		 - uint32 scheduler ticks (ms) when the frame was packed
+		 - sint32 temperature, hundredths of Celsius degree
+		 - sint32 frequency, hundredths of Hz
+		 - uint8 speed, alarm threshold (Celsius degree), percentage and menu state
+		 - uint16 CRC_ccitt() of the bytes above
+		The encoded frame ends with COBS_DELIMITER.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_TLM_H_
+#define SOURCES_TLM_H_
+
+#include "DataTypeDefinitions.h"
+#include "COBS.h"
+
+/** Shortest period, in ms, the frames go at 1 kHz at most */
+#define TLM_PERIOD_MIN 1
+/** Kind of the status frame */
+#define TLM_KIND_STATUS 0x01
+
+/** Offsets of the members of the frame */
+#define TLM_KIND_OFFSET 0
+#define TLM_FLAGS_OFFSET 1
+#define TLM_SEQUENCE_OFFSET 2
+#define TLM_TIME_OFFSET 4
+#define TLM_TEMPERATURE_OFFSET 8
+#define TLM_FREC_OFFSET 12
+#define TLM_SPEED_OFFSET 16
+#define TLM_ALARM_OFFSET 17
+#define TLM_PERINC_OFFSET 18
+#define TLM_STATE_OFFSET 19
+#define TLM_CRC_OFFSET 20
+/** Size of the frame with its CRC, and encoded */
+#define TLM_FRAME_SIZE 22
+#define TLM_ENCODED_SIZE COBS_MAX_SIZE(TLM_FRAME_SIZE)
+
+/** Bits of the flags */
+#define TLM_FLAG_FORMAT 0x01
+#define TLM_FLAG_MANUAL 0x02
+#define TLM_LEVEL_SHIFT 2
+#define TLM_LEVEL_MASK 0x0C
+
+/**
+ * Struct TLM_StatsType tells how the telemetry is doing
+ * **/
+typedef struct{
+	/*frames sent*/
+	uint32 sent;
+	/*frames dropped because the previous one was still being sent*/
+	uint32 dropped;
+}TLM_StatsType;
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts sending a frame every period. UART_init() must be
+ 	 called before
+ 	 \param[in] period - ms between frames, TLM_PERIOD_MIN at least, 0 stops the frames
+ 	 \return void
+ */
+void TLM_init(uint16 period);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function returns the statistics of the telemetry
+ 	 \param[out] stats - frames sent and dropped
+ 	 \return void
+ */
+void TLM_stats(TLM_StatsType* stats);
+
+#endif /* SOURCES_TLM_H_ */
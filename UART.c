@@ -0,0 +1,124 @@
+/**
+	\file
+	\brief
+		This is the source file for the serial port. The DMA channel of the transmitter
+		moves one byte per request of UART0 (TDRE with TDMAS), from the bytes to the data
+		register; when its major loop ends, DREQ clears its enable, and that is the end of
+		the transfer. The DMA channel of the receiver moves one byte per request (RDRF with
+		RDMAS) from the data register to the ring; at the end of its major loop DLAST takes
+		the destination back to the start of the ring, and the loop starts again, so the
+		bytes received so far are the laps of the ring, counted by the interruption of the
+		end of the major loop, and the ones its current iteration counter has moved.
+	\date	19/10/2026
+ */
+
+#include "MK64F12.h"
+#include "UART.h"
+#include "NVIC.h"
+
+/*Ring of the receiver, written by the DMA, the laps that the DMA has ended, and the bytes
+ * taken from it*/
+static volatile uint8 UART_rxRing[UART_RX_RING_SIZE];
+static volatile uint32 UART_rxLaps = 0;
+static uint32 UART_rxRead = 0;
+
+void DMA1_IRQHandler(){
+	DMA0->CINT = UART_RX_DMA_CHANNEL;
+	UART_rxLaps++;
+}
+
+void UART_init(uint32 baudRate){
+	/*Baud rate = SYSTEM_CLOCK/(16*(SBR + BRFA/32)), in 32ths of the divider*/
+	uint32 divider = (2 * SYSTEM_CLOCK + baudRate / 2) / baudRate;
+	uint16 sbr = (uint16)(divider / 32);
+
+	SIM_SCGC4 |= UART0_CLOCK_GATING;
+	SIM_SCGC6 |= DMAMUX_CLOCK_GATING;
+	SIM_SCGC7 |= DMA_CLOCK_GATING;
+
+	/*The baud rate is written with the transmitter and the receiver disabled*/
+	UART0->C2 = 0;
+	UART0->BDH = (uint8)((sbr >> 8) & UART_SBR_HIGH_MASK);
+	UART0->BDL = (uint8)sbr;
+	UART0->C4 = (UART0->C4 & ~UART_BRFA_MASK) | (uint8)(divider % 32);
+	UART0->C1 = 0;
+	/*TDRE and RDRF ask the DMA for the next byte, instead of interrupting*/
+	UART0->C5 = UART_TDMAS | UART_RDMAS;
+
+	/*A byte per request, from the bytes to the data register, that doesn't move*/
+	DMAMUX->CHCFG[UART_TX_DMA_CHANNEL] = 0;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].DADDR = (uint32)&UART0->D;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].DOFF = 0;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].DLAST_SGA = 0;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].SOFF = 1;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].SLAST = 0;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].ATTR = 0;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].NBYTES_MLNO = 1;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].CSR = UART_DMA_DREQ;
+	DMAMUX->CHCFG[UART_TX_DMA_CHANNEL] = UART_DMAMUX_ENBL | UART_TX_DMA_SOURCE;
+
+	/*A byte per request, from the data register to the ring, forever*/
+	DMAMUX->CHCFG[UART_RX_DMA_CHANNEL] = 0;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].SADDR = (uint32)&UART0->D;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].SOFF = 0;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].SLAST = 0;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].DADDR = (uint32)UART_rxRing;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].DOFF = 1;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].DLAST_SGA = -(sint32)UART_RX_RING_SIZE;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].ATTR = 0;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].NBYTES_MLNO = 1;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].CITER_ELINKNO = UART_RX_RING_SIZE;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].BITER_ELINKNO = UART_RX_RING_SIZE;
+	DMA0->TCD[UART_RX_DMA_CHANNEL].CSR = UART_DMA_INTMAJOR;
+	DMAMUX->CHCFG[UART_RX_DMA_CHANNEL] = UART_DMAMUX_ENBL | UART_RX_DMA_SOURCE;
+	UART_rxLaps = 0;
+	UART_rxRead = 0;
+	NVIC_enableInterruptAndPriority(DMA_CH1_IRQ, PRIORITY_11);
+	DMA0->SERQ = UART_RX_DMA_CHANNEL;
+
+	UART0->C2 = UART_TIE | UART_TE | UART_RIE | UART_RE;
+}
+
+uint8 UART_send(const uint8* data, uint16 length){
+	if(UART_sendBusy()){
+		return FALSE;
+	}
+	DMA0->TCD[UART_TX_DMA_CHANNEL].SADDR = (uint32)data;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].CITER_ELINKNO = length;
+	DMA0->TCD[UART_TX_DMA_CHANNEL].BITER_ELINKNO = length;
+	DMA0->CDNE = UART_TX_DMA_CHANNEL;
+	/*The transmitter is already asking, the first byte goes right away*/
+	DMA0->SERQ = UART_TX_DMA_CHANNEL;
+	return TRUE;
+}
+
+uint8 UART_sendBusy(){
+	return (DMA0->ERQ & (1 << UART_TX_DMA_CHANNEL)) ? TRUE : FALSE;
+}
+
+uint8 UART_receive(uint8* byte){
+	uint32 laps;
+	uint16 iteration;
+	uint32 written;
+
+	/*The iteration counter goes down from UART_RX_RING_SIZE, once per byte; it is read
+	 * again if a lap ends meanwhile*/
+	do{
+		laps = UART_rxLaps;
+		iteration = DMA0->TCD[UART_RX_DMA_CHANNEL].CITER_ELINKNO;
+	}while(laps != UART_rxLaps);
+	written = laps * UART_RX_RING_SIZE + (UART_RX_RING_SIZE - iteration);
+
+	/*Behind the bytes taken only when a lap has just ended and is not counted yet*/
+	if((sint32)(written - UART_rxRead) <= 0){
+		return FALSE;
+	}
+	/*The DMA has written over bytes that were not taken, the rest is skipped too*/
+	if(written - UART_rxRead > UART_RX_RING_SIZE){
+		UART_rxRead = written;
+		return UART_LOST;
+	}
+	*byte = UART_rxRing[UART_rxRead & (UART_RX_RING_SIZE - 1)];
+	UART_rxRead++;
+	return TRUE;
+}
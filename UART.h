@@ -0,0 +1,99 @@
+/**
+	\file
+	\brief
+		This is the header file for the serial port, UART0 (PTB16 and PTB17, the virtual
+		COM port of the debugger). The transmitter is fed by the eDMA: UART_send() points a
+		DMA channel to the bytes and returns, the DMA writes one byte in the data register
+		each time the transmitter asks for it, and stops by itself after the last one, so
+		the CPU doesn't touch the bytes nor takes an interruption per byte.
+		The receiver is also read by the eDMA, into a ring of UART_RX_RING_SIZE bytes that
+		it fills forever; UART_receive() takes the bytes from the ring without waiting, and
+		tells if the DMA wrote over bytes that were not taken yet.
+	\date	19/10/2026
+ */
+
+#ifndef SOURCES_UART_H_
+#define SOURCES_UART_H_
+
+#include "DataTypeDefinitions.h"
+#include "GlobalFunctions.h"
+
+/** Baud rate of the port, a telemetry frame at 1 kHz takes half of it */
+#define UART_BAUD_RATE 460800
+
+/** Size of the ring of the receiver, a power of 2. UART_receive() must take the bytes
+ * faster than they arrive, at UART_BAUD_RATE 1024 bytes take 22 ms, more than a key
+ * frame of the mirror (about 540 bytes, 12 ms) while a request waits for the transmitter */
+#define UART_RX_RING_SIZE 1024
+/** Returned by UART_receive() when bytes were lost, the same as CMD_LOST */
+#define UART_LOST 2
+
+/*defines for the clock gating of UART0, the DMA and its multiplexer*/
+#define UART0_CLOCK_GATING 0x00000400
+#define DMAMUX_CLOCK_GATING 0x00000002
+#define DMA_CLOCK_GATING 0x00000002
+
+/*defines for the UART registers*/
+#define UART_SBR_HIGH_MASK 0x1F
+#define UART_TIE 0x80
+#define UART_RIE 0x20
+#define UART_TE 0x08
+#define UART_RE 0x04
+#define UART_BRFA_MASK 0x1F
+#define UART_TDMAS 0x80
+#define UART_RDMAS 0x20
+
+/*defines for the DMA channel of the transmitter*/
+#define UART_TX_DMA_CHANNEL 0
+#define UART_TX_DMA_SOURCE 3
+#define UART_RX_DMA_CHANNEL 1
+#define UART_RX_DMA_SOURCE 2
+#define UART_DMAMUX_ENBL 0x80
+#define UART_DMA_DREQ 0x0008
+#define UART_DMA_INTMAJOR 0x0002
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function enables UART0 at a baud rate, with 8 bits, no parity and one stop
+ 	 bit, sets the DMA channel of the transmitter and starts the one of the receiver. The
+ 	 pins are set by BOARD_init()
+ 	 \param[in] baudRate - bits per second, the error is under 1% up to UART_BAUD_RATE
+ 	 \return void
+ */
+void UART_init(uint32 baudRate);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function starts sending bytes by DMA. The bytes are read while they are
+ 	 sent, so they must not change until UART_sendBusy() is FALSE
+ 	 \param[in] data - bytes to send
+ 	 \param[in] length - number of bytes, 1 to 32767
+ 	 \return uint8 - FALSE if the previous bytes are still being sent, nothing is started
+ */
+uint8 UART_send(const uint8* data, uint16 length);
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function tells if the DMA is still sending bytes
+ 	 \return uint8 - TRUE while sending
+ */
+uint8 UART_sendBusy();
+
+/********************************************************************************************/
+/********************************************************************************************/
+/********************************************************************************************/
+/*!
+ 	 \brief	 This function takes the next byte received, it doesn't wait for it
+ 	 \param[out] byte - byte received
+ 	 \return uint8 - FALSE if no byte was received since the last one taken, UART_LOST if
+ 	 the ring overran: no byte is taken, and the bytes received so far are skipped
+ */
+uint8 UART_receive(uint8* byte);
+
+#endif /* SOURCES_UART_H_ */
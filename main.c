@@ -37,9 +37,58 @@
 #include "LCDNokia5110.h"
 #include "SYSUPD.h"
 #include "DISP.h"
+#include "SCHED.h"
+#include "PIT.h"
+#include "DELAY.h"
+#include "BOARD.h"
+#include "HIST.h"
+#include "LOG.h"
+#include "ALRM.h"
+#include "BUZZ.h"
+#include "NVS.h"
+#include "UART.h"
+#include "TLM.h"
+#include "CMD.h"
+#include "MIRR.h"
+
+/**
+ * Period of the temperature sampling, in scheduler ticks (ms)
+ * **/
+#define ADC_SAMPLE_PERIOD 400
+
+/**
+ * Period of the settings store polling, in scheduler ticks (ms). A flash phrase is
+ * programmed in less than it
+ * **/
+#define NVS_POLL_PERIOD 1
+
+/**
+ * Period of the telemetry frames, in scheduler ticks (ms), TLM_PERIOD_MIN (1 kHz) at least
+ * **/
+#define TLM_PERIOD 10
+
+/**
+ * Period of the command channel polling, in scheduler ticks (ms). The ring of the receiver
+ * takes longer than it to fill
+ * **/
+#define CMD_POLL_PERIOD 1
+
+/**
+ * Period of the screen mirror frames, in scheduler ticks (ms)
+ * **/
+#define MIRR_PERIOD 100
 
 static int i = 0;
 
+/*Scheduler timer that starts the ADC convertions*/
+static SCHED_TimerType ADC_sampleTimer;
+
+/*Scheduler timer that moves the flash writes of the settings forward*/
+static SCHED_TimerType NVS_pollTimer;
+
+/*Scheduler timer that takes the commands received by the serial port*/
+static SCHED_TimerType CMD_pollTimer;
+
 /**
  * Constant structure for initiazing the SPI
  * **/
@@ -54,13 +103,9 @@ const SPI_ConfigType SPI_Config={
 							SPI_0,
 							/*Set this SPI as MASTER*/
 							SPI_MASTER,
-							/*Sets the used pin as MUX2*/
-							GPIO_MUX2,
 							/*Set baudrate and framesize*/
 							SPI_BAUD_RATE_2,
-							SPI_FSIZE_8,
-							/*Sets this pins as the ones that will be used*/
-							{GPIOD,BIT1,BIT2}};
+							SPI_FSIZE_8};
 
 /**
  * Constant structure for initiazing the ADC
@@ -90,32 +135,6 @@ const ADC_ConfigType ADC_Config = {
 							HW_AVRG_ENABLED,
 							SAMPLES_32};
 
-/**
- * Constant structure for initiazing the FTM for ADC convertions counter
- * **/
-const FTM_ConfigType ADC_FTM_Config = {
-							/*We will be using FTM1, Channel 0*/
-							FTM_1,
-							CHANNEL_N_0,
-							/*Set the configuration for counter mode*/
-							FALSE, //DECAPEN
-							FALSE, //COMBINE
-							FALSE, //CPWMS
-							FALSE, //MSnB
-							FALSE, //MSnA
-							FALSE, //ELSB
-							FALSE, //ELSA
-							/*Set the MOD value*/
-							0xFFFF,
-							/*Set the Cnv value*/
-							0,
-							/*Set clock source and pre scaler*/
-							FLEX_TIMER_CLKS_1,
-							FLEX_TIMER_PS_128,
-							/*Enable overflow interruptions, disable channel interruptions*/
-							TRUE,
-							FALSE};
-
 /**
  * Constant structure for initiazing the FTM for Input Capture
  * **/
@@ -168,34 +187,88 @@ const FTM_ConfigType PWM_FTM_Config = {
 							FALSE,
 							FALSE};
 
+/*Scheduler callback that starts a new convertion in the ADC*/
+static void ADC_sample(){
+	ADC_startConvertion(ADC_Config.xchannel, ADC_Config.nchannel, ADC_Config.inputChannel);
+}
+
+/*Copy of the system flags for the command channel*/
+static void CMD_flagsRead(CMD_FlagsType* flags){
+	SystemUpdateFlags snapshot;
+
+	SYSUPD_SUFsnapshot(&snapshot);
+	flags->state = (uint8)snapshot.currentState;
+	flags->alarm = snapshot.currentAlarm;
+	flags->speed = snapshot.currentSpeed;
+	flags->format = snapshot.currentFormat;
+	flags->perInc = snapshot.currentPerInc;
+	flags->manual = snapshot.currentManual;
+	flags->temperature = (sint32)(snapshot.currentTemperature * 100 + 0.5);
+	flags->frec = (sint32)(snapshot.currentFrec * 100 + 0.5);
+}
+
+/**
+ * Functions of the command channel: UART0 and the system flags
+ * **/
+static const CMD_SystemType CMD_uart = {UART_receive, UART_send, UART_sendBusy,
+		CMD_flagsRead, SYSUPD_settingsWrite};
+
 int main(void)
 {
 
     /* Write your code here */
 
-	/*Initialize SYSUPD, the main state machine*/
-	SYSUPD_init();
+	/*Configure every pin of the board*/
+	BOARD_init();
+	/*Start the 64-bit lifetime timer, used to timestamp the events*/
+	PIT_lifetimeInit();
+	/*Initialize the delay service, used by the LCD reset and the button debouncer*/
+	DELAY_init();
+	/*Initialize the scheduler, that gives the time base for the periodic tasks*/
+	SCHED_init();
+	/*Initialize the history and the log of the temperature and the frequency*/
+	LOG_init();
+	HIST_init();
+	/*Restore the settings kept in flash before anything uses them, and keep writing them
+	 * in background*/
+	NVS_init(&FLASH_ftfe);
+	SYSUPD_settingsRestore();
+	SCHED_timerStart(&NVS_pollTimer, NVS_POLL_PERIOD, NVS_POLL_PERIOD, NVS_poll);
+	/*Initialize the alarm, that takes a temperature sample every ADC_SAMPLE_PERIOD*/
+	ALRM_init(ADC_SAMPLE_PERIOD, ALRM_HORIZON_S);
 	/*Initialize BTTN, the receptor of buttons*/
 	BTTN_init();
 	/*Initialize SPI*/
 	SPI_init(&SPI_Config); /*! Configuration function for the LCD port*/
 	/*Initialize LCDNokia*/
 	LCDNokia_init(); /*! Configuration function for the LCD */
+#ifdef LCD_BENCHMARK
+	/*Measure the LCD throughput, the result is read with the debugger*/
+	static LCD_BenchmarkType lcdBenchmark;
+	LCDNokia_benchmark(&lcdBenchmark);
+#endif
 
 	/*Initialize ADC*/
 	ADC_init(&ADC_Config);
-	/*Initialize FTM for ADC counter*/
-	FTM_init(&ADC_FTM_Config);
 	/*Initialize FTM for Input capture*/
 	FTM_init(&Input_FTM_Config);
+	/*Initialize the buzzer, its tone is a PWM of the FTM of the input capture*/
+	BUZZ_init();
 	/*Initialize FTM for PWM counter*/
 	FTM_init(&PWM_FTM_Config);
+	/*Initialize the serial port, send the telemetry and the screen mirror through it, and
+	 * take the commands that it receives*/
+	UART_init(UART_BAUD_RATE);
+	TLM_init(TLM_PERIOD);
+	MIRR_init(MIRR_PERIOD);
+	CMD_init(&CMD_uart);
+	SCHED_timerStart(&CMD_pollTimer, CMD_POLL_PERIOD, CMD_POLL_PERIOD, CMD_poll);
 
 
 
-	/*function pointers to get BTTN mailBox flag and Data*/
+	/*function pointers to know if there are button events, and to take them*/
 	uint8 (*button_ready)() = BTTN_mailBoxFlag;
-	uint16 (*button_read)() = BTTN_mailBoxData;
+	uint8 (*button_read)(BTTN_EventType*) = BTTN_eventRead;
 
 	/*function pointers to start convertion of ADC, knowm if the convertion is
 	 * completed, and get the conversion result*/
@@ -203,9 +276,10 @@ int main(void)
 	uint8 (*adc_mailBoxFlag)(ADC_ChannelType) = ADC_mailBoxFlag;
 	float (*adc_mailBoxData)(ADC_ChannelType) = ADC_mailBoxData;
 
-	/*function pointers to get the system flags for display and system*/
-	SystemDisplayFlags* (*SystemDisplayingFlags)() = SYSUPD_SDF;
-	SystemUpdateFlags* (*SystemWorkingFlags)() = SYSUPD_SUF;
+	/*function pointer to get a consistent copy of the system flags*/
+	void (*SystemWorkingFlags)(SystemUpdateFlags*) = SYSUPD_SUFsnapshot;
+	/*copy of the system flags, it doesn't change while it is used*/
+	SystemUpdateFlags workingFlags;
 
 	/*function pointers to get FTM mailBox flag and Data*/
 	uint8 (*ftm_mailBoxFlag)(FTM_ChannelType) = FTM_mailBoxFlag;
@@ -216,8 +290,8 @@ int main(void)
 
 	/*function pointer to update the display in the LCD, and to update the main
 	 * state machine in SYSUPD*/
-	void (*update_display)(SystemDisplayFlags*) = update_Display;
-	void (*system_update)(uint16) = SYSUPD_update;
+	void (*update_display)(uint64, uint8) = DISP_request;
+	void (*system_update)(uint16, BTTN_EventKindType) = SYSUPD_update;
 
 	/*functions pointers to set the temperature and frequency in the system flags struct,
 	 * also to verify that the temperature is under the alarm threshold, and to modify
@@ -233,52 +307,67 @@ int main(void)
 	/////////////////////////////////////////////////////////////////////////////////////
 
 
-	/*Update the display for first time*/
-	(*update_display)((*SystemDisplayingFlags)());
+	/*Update the display for first time, and then periodically*/
+	(*update_display)(PIT_lifetimeRead(), TRUE);
+	DISP_init();
 
-	/*First start convertion in the ADC*/
+	/*First start convertion in the ADC, the next ones are started periodically by the
+	 * scheduler*/
 	(*adc_convertData)(ADC_Config.xchannel, ADC_Config.nchannel, ADC_Config.inputChannel);
+	SCHED_timerStart(&ADC_sampleTimer, ADC_SAMPLE_PERIOD, ADC_SAMPLE_PERIOD, ADC_sample);
+
+	/*lifetime timer value of the event being attended, to measure the LCD latency*/
+	uint64 eventTimeStamp;
+	/*last button event, and index to go through its buttons*/
+	BTTN_EventType buttonEvent;
+	uint16 button;
 
 	for (;;) {
 
-		/*If a button was pressed*/
+		/*Run the scheduler timers that have expired*/
+		SCHED_dispatch();
+
+		/*If a button was pressed, held or released*/
 		if((*button_ready)()){
-			/*Update the system state machine according to the button*/
-			(*system_update)((*button_read)());
+			(*button_read)(&buttonEvent);
+			eventTimeStamp = buttonEvent.timeStamp;
+			/*Update the system state machine according to each button, a chord has more
+			 * than one*/
+			for(button = BUTTON_0; button < BTTN_COUNT; button++){
+				if(buttonEvent.buttons & BTTN_MASK(button)){
+					(*system_update)(button, buttonEvent.event);
+				}
+			}
 			/*Update the PWM*/
-			(*PWM_update)(PWM_FTM_Config.FTM_Channel, PWM_FTM_Config.N_Channel, 0.01*PWM_FTM_Config.MOD*(*SystemWorkingFlags)()->currentSpeed);
-			/*Update the screen (it may be not be needed)*/
-			(*update_display)((*SystemDisplayingFlags)());
+			(*SystemWorkingFlags)(&workingFlags);
+			(*PWM_update)(PWM_FTM_Config.FTM_Channel, PWM_FTM_Config.N_Channel, 0.01*PWM_FTM_Config.MOD*workingFlags.currentSpeed);
+			/*Update the screen now, the button may have changed it (it may be not be needed)*/
+			(*update_display)(eventTimeStamp, TRUE);
 
 		}
 
-		/*If the ADC counter FTM has overflowed, start a new ADC convertion*/
-    	if((*ftm_mailBoxFlag)(ADC_FTM_Config.FTM_Channel)){
-    		/*Start a new convertion in the ADC*/
-        	(*adc_convertData)(ADC_Config.xchannel, ADC_Config.nchannel, ADC_Config.inputChannel);
-        	/*Clear the flag in the mailBox*/
-        	(*ftm_mailBoxData)(ADC_FTM_Config.FTM_Channel);
-    	}
-
     	/*If the convertion is completed, get the temperature*/
     	if((*adc_mailBoxFlag)(ADC_Config.xchannel)){
+    		eventTimeStamp = ADC_mailBoxTimeStamp(ADC_Config.xchannel);
     		/*change the currente temperature with the most recent one*/
     		(*change_temp)((*adc_mailBoxData)(ADC_Config.xchannel));
     		/*Check the alarm threshold and motor conditions*/
     		(*alarm_check)();
     		(*motor_check)();
     		/*Update the PWM*/
-    		(*PWM_update)(PWM_FTM_Config.FTM_Channel, PWM_FTM_Config.N_Channel, 0.01*PWM_FTM_Config.MOD*(*SystemWorkingFlags)()->currentSpeed);
-    		/*Update the screen (it may not be needed)*/
-    		(*update_display)((*SystemDisplayingFlags)());
+    		(*SystemWorkingFlags)(&workingFlags);
+    		(*PWM_update)(PWM_FTM_Config.FTM_Channel, PWM_FTM_Config.N_Channel, 0.01*PWM_FTM_Config.MOD*workingFlags.currentSpeed);
+    		/*Update the screen with the next refresh (it may not be needed)*/
+    		(*update_display)(eventTimeStamp, FALSE);
     	}
 
     	/*If the Input capture has 2 values, get the frequence*/
     	if((*ftm_mailBoxFlag)(Input_FTM_Config.FTM_Channel)){
+    		eventTimeStamp = FTM_mailBoxTimeStamp(Input_FTM_Config.FTM_Channel);
     		/*Change the current frequency with the most recent one*/
     		(*change_Frequency)((*ftm_mailBoxData)(Input_FTM_Config.FTM_Channel), (*ftm_mailBoxData)(4));
-    		/*Update the screen (it may not be needed)*/
-    		(*update_display)((*SystemDisplayingFlags)());
+    		/*Update the screen with the next refresh (it may not be needed)*/
+    		(*update_display)(eventTimeStamp, FALSE);
     	}
 	}
     /* Never leave main */
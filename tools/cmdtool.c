@@ -0,0 +1,557 @@
+/**
+	\file
+	\brief
+		Host tool for the command channel (see CMD.h for the protocol). It sends a request
+		with the operations of the command line, all of them in one batch, and writes the
+		response. The telemetry frames that arrive meanwhile are skipped.
+
+		With -t the tool tests the command channel through a pseudo terminal, as a loopback
+		of the serial port: a child process runs CMD.c on the slave side, with the flags in
+		RAM and the ranges of SYSUPD, and sends telemetry frames between the responses, each
+		one keeping the transmitter busy for a while, like a frame of the mirror; the
+		tool sends random batches (also wrong and corrupted ones) on the master side, and
+		checks every response with a model of the flags.
+
+		Build and use:
+			cc -I. -o cmdtool tools/cmdtool.c CMD.c COBS.c CRC.c
+			./cmdtool /dev/ttyACM0 alarm speed temperature
+			./cmdtool /dev/ttyACM0 alarm=30 perInc=10 alarm perInc
+			./cmdtool -t [transactions, 2000 by default]
+	\date	19/10/2026
+ */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <termios.h>
+#include <time.h>
+#include <sys/wait.h>
+#include "CMD.h"
+#include "CRC.h"
+
+/*Must match SYSUPD.h*/
+#define ALARM_MIN 15
+#define ALARM_MAX 45
+#define PERCEN_MIN 5
+#define PERCEN_MAX 100
+#define FAHRENHEIT 1
+#define MANUAL 1
+
+/*Must match TLM.h, the frames that the tool skips*/
+#define TLM_KIND_STATUS 0x01
+#define TLM_FRAME_SIZE 22
+
+/*Time to wait for a response, in ms, and in the test for a request that is corrupted*/
+#define RESPONSE_TIMEOUT 1000
+#define CORRUPTED_TIMEOUT 50
+
+/*Names of the fields, indexed by CMD_FieldType*/
+static const char* const fieldName[CMD_FIELDS] = {
+		"state", "alarm", "speed", "format", "perInc", "manual", "temperature", "frec"
+};
+
+/*Names of the status, indexed by CMD_StatusType*/
+static const char* const statusName[] = {
+		"ok", "malformed", "unknown field", "read only", "out of range", "too long"
+};
+
+/**
+ * Struct ResponseType is a response decoded
+ * **/
+typedef struct{
+	uint8 tag;
+	uint8 status;
+	uint8 operation;
+	uint8 fields;
+	uint8 field[CMD_FRAME_SIZE];
+	sint32 value[CMD_FRAME_SIZE];
+}ResponseType;
+
+/*Bytes received since the last delimiter*/
+static uint8 received[CMD_ENCODED_SIZE];
+static int receivedLength = 0;
+
+/*Bytes of the value of a field, like CMD_size() in CMD.c*/
+static int valueSize(uint8 field){
+	return ((CMD_TEMPERATURE == field) || (CMD_FREC == field)) ? 4 : 1;
+}
+
+/*Raw bytes, no echo nor translations*/
+static int setRaw(int fd){
+	struct termios settings;
+
+	if(tcgetattr(fd, &settings)){
+		return -1;
+	}
+	cfmakeraw(&settings);
+#ifdef B460800
+	cfsetispeed(&settings, B460800);
+	cfsetospeed(&settings, B460800);
+#endif
+	return tcsetattr(fd, TCSANOW, &settings);
+}
+
+/*Write all the bytes*/
+static int writeAll(int fd, const uint8* data, int length){
+	ssize_t count;
+
+	while(length > 0){
+		count = write(fd, data, length);
+		if(count < 0){
+			if(EAGAIN == errno){
+				continue;
+			}
+			return -1;
+		}
+		data += count;
+		length -= count;
+	}
+	return 0;
+}
+
+/*Send a request with the operations*/
+static int sendRequest(int fd, uint8 tag, const uint8* operations, int length){
+	uint8 request[CMD_FRAME_SIZE];
+	uint8 encoded[CMD_ENCODED_SIZE];
+	uint16 crc;
+
+	request[0] = CMD_KIND_REQUEST;
+	request[1] = tag;
+	memcpy(&request[CMD_REQUEST_HEADER], operations, length);
+	length += CMD_REQUEST_HEADER;
+	crc = CRC_ccitt(CRC_INIT, request, length);
+	request[length++] = (uint8)crc;
+	request[length++] = (uint8)(crc >> 8);
+	return writeAll(fd, encoded, COBS_encode(request, length, encoded));
+}
+
+/*Decode a response, FALSE if the frame is another one*/
+static int parseResponse(uint8* frame, int length, ResponseType* response){
+	uint16 crc;
+	int index;
+	int size;
+	uint32 value;
+
+	length = COBS_decode(frame, length, frame);
+	if((COBS_INVALID == length) || (length < CMD_RESPONSE_HEADER + CMD_CRC_SIZE) ||
+			(CMD_KIND_RESPONSE != frame[0])){
+		return 0;
+	}
+	length -= CMD_CRC_SIZE;
+	crc = CRC_ccitt(CRC_INIT, frame, length);
+	if((frame[length] != (uint8)crc) || (frame[length + 1] != (uint8)(crc >> 8))){
+		return 0;
+	}
+	response->tag = frame[1];
+	response->status = frame[2];
+	response->operation = frame[3];
+	response->fields = 0;
+	for(index = CMD_RESPONSE_HEADER; index < length; index += size){
+		if(frame[index] >= CMD_FIELDS){
+			return 0;
+		}
+		response->field[response->fields] = frame[index++];
+		size = valueSize(response->field[response->fields]);
+		if(index + size > length){
+			return 0;
+		}
+		value = 0;
+		while(size--){
+			value = (value << 8) | frame[index + size];
+		}
+		size = valueSize(response->field[response->fields]);
+		response->value[response->fields++] = (1 == size) ? (sint32)value : (sint32)(int)value;
+	}
+	return 1;
+}
+
+/*Time in ms*/
+static long now(){
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000 + time.tv_nsec / 1000000;
+}
+
+/*Wait for the response with a tag, FALSE if it doesn't arrive in time. The other frames
+ * don't make the wait longer*/
+static int receiveResponse(int fd, uint8 tag, int timeout, ResponseType* response){
+	struct pollfd wait = {fd, POLLIN, 0};
+	long deadline = now() + timeout;
+	long left;
+	uint8 byte;
+
+	while(((left = deadline - now()) > 0) && (poll(&wait, 1, (int)left) > 0)){
+		if(read(fd, &byte, 1) != 1){
+			return 0;
+		}
+		if(COBS_DELIMITER != byte){
+			if(receivedLength < CMD_ENCODED_SIZE){
+				received[receivedLength++] = byte;
+			}
+			continue;
+		}
+		if(parseResponse(received, receivedLength, response) && (tag == response->tag)){
+			receivedLength = 0;
+			return 1;
+		}
+		receivedLength = 0;
+	}
+	return 0;
+}
+
+/*Board side of the test: flags in RAM, serial port in the slave of the pseudo terminal*/
+static int boardPort;
+/*Polls for which the transmitter is still busy with the last telemetry frame*/
+#define BOARD_BUSY_POLLS 30
+static long boardBusyPolls = 0;
+static CMD_FlagsType boardFlags = {0, 30, 50, 0, 15, 0, 2350, 12000};
+
+static uint8 boardReceive(uint8* byte){
+	return (1 == read(boardPort, byte, 1)) ? TRUE : FALSE;
+}
+
+static uint8 boardSend(const uint8* data, uint16 length){
+	if(boardBusyPolls){
+		fprintf(stderr, "board: response sent while the transmitter is busy\n");
+		_exit(1);
+	}
+	return writeAll(boardPort, data, length) ? FALSE : TRUE;
+}
+
+static uint8 boardBusy(){
+	return boardBusyPolls ? TRUE : FALSE;
+}
+
+static void boardRead(CMD_FlagsType* flags){
+	/*The measures change all the time*/
+	boardFlags.temperature += 3;
+	boardFlags.frec -= 7;
+	*flags = boardFlags;
+}
+
+/*Like SYSUPD_settingsWrite()*/
+static uint8 boardWrite(const NVS_SettingsType* settings){
+	if((settings->alarm < ALARM_MIN) || (settings->alarm > ALARM_MAX) ||
+			(settings->format > FAHRENHEIT) || (settings->manual > MANUAL) ||
+			(settings->perInc < PERCEN_MIN) || (settings->perInc > PERCEN_MAX) ||
+			(settings->speed > PERCEN_MAX)){
+		return FALSE;
+	}
+	boardFlags.alarm = settings->alarm;
+	boardFlags.format = settings->format;
+	boardFlags.perInc = settings->perInc;
+	boardFlags.manual = settings->manual;
+	boardFlags.speed = settings->speed;
+	/*setUpdate() goes back to the default display*/
+	boardFlags.state = 0;
+	return TRUE;
+}
+
+static const CMD_SystemType boardSystem = {boardReceive, boardSend, boardBusy, boardRead, boardWrite};
+
+/*Run the command channel until the master is closed, with a telemetry frame now and then*/
+static void board(int fd){
+	uint8 telemetry[TLM_FRAME_SIZE] = {TLM_KIND_STATUS};
+	uint8 encoded[COBS_MAX_SIZE(TLM_FRAME_SIZE)];
+	struct pollfd hangup = {fd, 0, 0};
+	long polls;
+
+	boardPort = fd;
+	CMD_init(&boardSystem);
+	for(polls = 0; ; polls++){
+		CMD_poll();
+		if(boardBusyPolls){
+			boardBusyPolls--;
+		} else if(0 == polls % 50){
+			writeAll(fd, encoded, COBS_encode(telemetry, TLM_FRAME_SIZE, encoded));
+			boardBusyPolls = BOARD_BUSY_POLLS;
+		}
+		if(poll(&hangup, 1, 0) && (hangup.revents & POLLHUP)){
+			break;
+		}
+		usleep(100);
+	}
+	_exit(0);
+}
+
+/*Field value of the model*/
+static sint32 modelValue(const CMD_FlagsType* model, uint8 field){
+	switch(field){
+	case CMD_STATE: return model->state;
+	case CMD_ALARM: return model->alarm;
+	case CMD_SPEED: return model->speed;
+	case CMD_FORMAT: return model->format;
+	case CMD_PERINC: return model->perInc;
+	case CMD_MANUAL: return model->manual;
+	default: return 0;
+	}
+}
+
+/*Status that the board must answer to some operations, and the model after them*/
+static uint8 expect(CMD_FlagsType* model, const uint8* operations, int length, uint8* operation){
+	CMD_FlagsType merged = *model;
+	int writes = 0;
+	int size = CMD_RESPONSE_HEADER;
+	int index = 0;
+	uint8 field;
+	uint8 value;
+
+	for(*operation = 0; index < length; (*operation)++){
+		field = operations[index] & ~CMD_WRITE;
+		if(field >= CMD_FIELDS){
+			return CMD_UNKNOWN_FIELD;
+		}
+		if(!(operations[index++] & CMD_WRITE)){
+			size += 1 + valueSize(field);
+			if(size > CMD_FRAME_SIZE - CMD_CRC_SIZE){
+				return CMD_TOO_LONG;
+			}
+			continue;
+		}
+		if(index == length){
+			return CMD_MALFORMED;
+		}
+		value = operations[index++];
+		switch(field){
+		case CMD_ALARM: merged.alarm = value; break;
+		case CMD_SPEED: merged.speed = value; break;
+		case CMD_FORMAT: merged.format = value; break;
+		case CMD_PERINC: merged.perInc = value; break;
+		case CMD_MANUAL: merged.manual = value; break;
+		default: return CMD_READ_ONLY;
+		}
+		writes = 1;
+	}
+	if(writes){
+		if((merged.alarm < ALARM_MIN) || (merged.alarm > ALARM_MAX) ||
+				(merged.format > FAHRENHEIT) || (merged.manual > MANUAL) ||
+				(merged.perInc < PERCEN_MIN) || (merged.perInc > PERCEN_MAX) ||
+				(merged.speed > PERCEN_MAX)){
+			return CMD_RANGE;
+		}
+		merged.state = 0;
+		*model = merged;
+	}
+	return CMD_OK;
+}
+
+/*Random value for a write, in range most of the times*/
+static uint8 randomValue(uint8 field){
+	if(0 == rand() % 10){
+		return (uint8)rand();
+	}
+	switch(field){
+	case CMD_ALARM: return (uint8)(ALARM_MIN + rand() % (ALARM_MAX - ALARM_MIN + 1));
+	case CMD_FORMAT:
+	case CMD_MANUAL: return (uint8)(rand() % 2);
+	case CMD_PERINC: return (uint8)(PERCEN_MIN + rand() % (PERCEN_MAX - PERCEN_MIN + 1));
+	default: return (uint8)(rand() % (PERCEN_MAX + 1));
+	}
+}
+
+static int selfTest(long transactions){
+	CMD_FlagsType model = boardFlags;
+	ResponseType response;
+	uint8 operations[CMD_FRAME_SIZE];
+	uint8 request[CMD_FRAME_SIZE];
+	uint8 encoded[CMD_ENCODED_SIZE];
+	uint8 status;
+	uint8 operation;
+	uint8 field;
+	uint8 tag = 0;
+	uint16 crc;
+	long transaction;
+	long corrupted = 0;
+	long rejected = 0;
+	int length;
+	int count;
+	int index;
+	int reads;
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	int slave;
+	pid_t child;
+
+	if((master < 0) || grantpt(master) || unlockpt(master)){
+		perror("pseudo terminal");
+		return 2;
+	}
+	slave = open(ptsname(master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if((slave < 0) || setRaw(slave) || setRaw(master)){
+		perror(ptsname(master));
+		return 2;
+	}
+	child = fork();
+	if(0 == child){
+		close(master);
+		board(slave);
+	}
+	close(slave);
+	srand(1);
+
+	for(transaction = 0; transaction < transactions; transaction++){
+		tag++;
+		/*Random operations, mostly on fields that exist*/
+		length = 0;
+		count = 1 + rand() % 12;
+		while(count-- && (length < CMD_FRAME_SIZE - CMD_REQUEST_HEADER - CMD_CRC_SIZE - 1)){
+			field = (0 == rand() % 40) ? (uint8)(CMD_FIELDS + rand() % 8) : (uint8)(rand() % CMD_FIELDS);
+			if(rand() % 3){
+				operations[length++] = field;
+			} else {
+				/*Mostly the settings, the other fields are read only*/
+				if(rand() % 20){
+					field = (uint8)(CMD_ALARM + rand() % (CMD_MANUAL - CMD_ALARM + 1));
+				}
+				operations[length++] = field | CMD_WRITE;
+				operations[length++] = randomValue(field);
+			}
+		}
+		/*A write without its value*/
+		if(0 == rand() % 40){
+			operations[length++] = CMD_ALARM | CMD_WRITE;
+		}
+
+		/*A corrupted request is not answered, and changes nothing*/
+		if(0 == rand() % 30){
+			request[0] = CMD_KIND_REQUEST;
+			request[1] = tag;
+			memcpy(&request[CMD_REQUEST_HEADER], operations, length);
+			crc = CRC_ccitt(CRC_INIT, request, length + CMD_REQUEST_HEADER);
+			request[length + CMD_REQUEST_HEADER] = (uint8)crc;
+			request[length + CMD_REQUEST_HEADER + 1] = (uint8)(crc >> 8);
+			count = COBS_encode(request, length + CMD_REQUEST_HEADER + CMD_CRC_SIZE, encoded);
+			encoded[rand() % (count - 1)] ^= (uint8)(1 << (rand() % 8));
+			writeAll(master, encoded, count);
+			if(receiveResponse(master, tag, CORRUPTED_TIMEOUT, &response)){
+				fprintf(stderr, "transaction %ld: corrupted request answered\n", transaction);
+				return 1;
+			}
+			corrupted++;
+			continue;
+		}
+
+		status = expect(&model, operations, length, &operation);
+		if(sendRequest(master, tag, operations, length) ||
+				!receiveResponse(master, tag, RESPONSE_TIMEOUT, &response)){
+			fprintf(stderr, "transaction %ld: no response\n", transaction);
+			return 1;
+		}
+		if((response.status != status) || (response.operation != operation)){
+			fprintf(stderr, "transaction %ld: status %u at %u, expected %u at %u\n", transaction,
+					response.status, response.operation, status, operation);
+			return 1;
+		}
+		if(CMD_OK != status){
+			rejected++;
+			if(response.fields){
+				fprintf(stderr, "transaction %ld: fields in an error\n", transaction);
+				return 1;
+			}
+			continue;
+		}
+		/*The fields read, in order, with the values after the writes*/
+		for(index = 0, reads = 0; index < length; index++){
+			if(operations[index] & CMD_WRITE){
+				index++;
+				continue;
+			}
+			if((reads == response.fields) || (response.field[reads] != operations[index]) ||
+					((valueSize(operations[index]) == 1) &&
+					(response.value[reads] != modelValue(&model, operations[index])))){
+				fprintf(stderr, "transaction %ld: wrong field %d\n", transaction, reads);
+				return 1;
+			}
+			reads++;
+		}
+		if(reads != response.fields){
+			fprintf(stderr, "transaction %ld: %u fields, expected %d\n", transaction, response.fields, reads);
+			return 1;
+		}
+	}
+	close(master);
+	kill(child, SIGTERM);
+	waitpid(child, 0, 0);
+	printf("%ld transactions through a pseudo terminal, %ld rejected, %ld corrupted: OK\n",
+			transactions, rejected, corrupted);
+	return 0;
+}
+
+/*Send the operations of the command line, name to read and name=value to write*/
+static int command(const char* path, int argc, char** argv){
+	ResponseType response;
+	uint8 operations[CMD_FRAME_SIZE];
+	uint8 tag = (uint8)getpid();
+	const char* equal;
+	int length = 0;
+	int index;
+	int field;
+	int fd = open(path, O_RDWR | O_NOCTTY);
+
+	if(fd < 0){
+		perror(path);
+		return 2;
+	}
+	if(isatty(fd) && setRaw(fd)){
+		perror(path);
+		return 2;
+	}
+	for(index = 0; index < argc; index++){
+		equal = strchr(argv[index], '=');
+		for(field = 0; field < CMD_FIELDS; field++){
+			if(equal ? (!strncmp(argv[index], fieldName[field], equal - argv[index]) &&
+					!fieldName[field][equal - argv[index]]) : !strcmp(argv[index], fieldName[field])){
+				break;
+			}
+		}
+		if((CMD_FIELDS == field) || (length + 2 > CMD_FRAME_SIZE - CMD_REQUEST_HEADER - CMD_CRC_SIZE)){
+			fprintf(stderr, "%s: unknown field, or too many operations\n", argv[index]);
+			return 2;
+		}
+		if(equal){
+			operations[length++] = (uint8)(field | CMD_WRITE);
+			operations[length++] = (uint8)strtol(equal + 1, 0, 0);
+		} else {
+			operations[length++] = (uint8)field;
+		}
+	}
+
+	if(sendRequest(fd, tag, operations, length) ||
+			!receiveResponse(fd, tag, RESPONSE_TIMEOUT, &response)){
+		fprintf(stderr, "%s: no response\n", path);
+		return 1;
+	}
+	if(CMD_OK != response.status){
+		fprintf(stderr, "%s, operation %u\n",
+				(response.status < sizeof(statusName)/sizeof(statusName[0])) ?
+				statusName[response.status] : "error", response.operation + 1);
+		return 1;
+	}
+	for(index = 0; index < response.fields; index++){
+		if(valueSize(response.field[index]) == 1){
+			printf("%s=%ld\n", fieldName[response.field[index]], (long)response.value[index]);
+		} else {
+			printf("%s=%.2f\n", fieldName[response.field[index]], response.value[index] / 100.0);
+		}
+	}
+	close(fd);
+	return 0;
+}
+
+int main(int argc, char** argv){
+	if((argc > 1) && !strcmp(argv[1], "-t")){
+		return selfTest((argc > 2) ? strtol(argv[2], 0, 0) : 2000);
+	}
+	if(argc < 3){
+		fprintf(stderr, "use: %s serial port field[=value]... | -t [transactions]\n", argv[0]);
+		return 2;
+	}
+	return command(argv[1], argc - 2, &argv[2]);
+}
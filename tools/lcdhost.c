@@ -0,0 +1,320 @@
+/**
+	\file
+	\brief
+		Host build of the LCD driver (LCDNokia5110.c), DISP and GRAPH. The driver runs as in
+		the firmware, on the registers in RAM of tools/lcdhost.h: each byte that
+		LCDNokia_writeByte() sends is taken from what it wrote to the D/C pin and to the
+		SPI, and given to the model of the controller (pcd8544.h), or written to a capture
+		for tools/lcdsink.c.
+
+		With a capture file, the LCD is started with LCDNokia_init() and every screen of
+		DISP is drawn with update_Display(), from fixed values, and then updated with some
+		of its fields changed (the trend graph gets a new sample). A frame ends after each
+		flush, and its number and screen are written to stdout. The images of the frames
+		are in tools/golden, so the screens are checked with:
+			./lcdhost disp.bin && ./lcdsink disp.bin -g tools/golden/disp
+		and, when a screen changes on purpose, saved again with -p tools/golden/disp.
+
+		With -t the tool tests itself: after LCDNokia_init() the controller must be in the
+		basic set with the normal mode, and after each LCDNokia_flush() of random drawing
+		the memory of the controller must be the frame of the driver (LCDNokia_frame()).
+
+		Build and use, with the MK64F12.h of the SDK:
+			cc -I. -I<SDK include> -include tools/lcdhost.h -o lcdhost tools/lcdhost.c \
+				tools/pcd8544.c LCDNokia5110.c DISP.c GRAPH.c
+			./lcdhost disp.bin
+			./lcdhost -t [flushes, 1000 by default] [seed]
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "LCDNokia5110.h"
+#include "SPI.h"
+#include "DISP.h"
+#include "GRAPH.h"
+#include "HIST.h"
+#include "PIT.h"
+#include "DELAY.h"
+#include "pcd8544.h"
+
+/*D/C level of the pair that ends a frame in the capture, as in tools/lcdsink.c*/
+#define HOST_FRAME_END 0xFF
+/*Bit of the D/C pin in the port*/
+#define HOST_DATA_OR_CMD (1u << DATA_OR_CMD_PIN)
+/*Samples of the history*/
+#define HOST_SAMPLES (GRAPH_COLUMNS + 16)
+
+GPIO_Type lcdHostGpio[5];
+SPI_Type lcdHostSpi[3];
+
+/*Capture, the controller fed with it, the traffic of the frame and the frames ended*/
+static FILE* hostCapture = 0;
+static PCD_Type hostPcd;
+static PCD_CountersType hostCounters;
+static long hostFrames = 0;
+/*The values on the screens*/
+static SystemDisplayFlags hostSdf;
+static SystemUpdateFlags hostSuf;
+static HIST_SampleType hostHistory[HOST_SAMPLES];
+static uint16 hostSampleCount = 0;
+
+void LCDNokia_capture(uint8 DataOrCmd, uint8 data){
+	GPIO_Type* port = PTD;
+	uint8 level;
+	uint8 byte = (uint8)SPI0->PUSHR;
+
+	/*The D/C level is the last write to the pin, through PSOR or PCOR*/
+	if(port->PSOR & HOST_DATA_OR_CMD){
+		level = LCD_DATA;
+	} else if(port->PCOR & HOST_DATA_OR_CMD){
+		level = LCD_CMD;
+	} else {
+		fprintf(stderr, "byte %02x sent without writing the D/C pin\n", data);
+		exit(1);
+	}
+	if((level != (DataOrCmd ? LCD_DATA : LCD_CMD)) || (byte != data)){
+		fprintf(stderr, "the pins don't match LCDNokia_writeByte(%d, %02x)\n", DataOrCmd, data);
+		exit(1);
+	}
+	port->PSOR = 0;
+	port->PCOR = 0;
+
+	PCD_write(&hostPcd, level, byte, &hostCounters);
+	if(hostCapture){
+		fputc(level, hostCapture);
+		fputc(byte, hostCapture);
+	}
+}
+
+/*The rest of the firmware that the driver, DISP and GRAPH use*/
+void SPI_startTranference(SPI_ChannelType channel){
+	SPI_handle[channel]->MCR &= ~SPI_MCR_HALT_MASK;
+}
+
+void SPI_stopTranference(SPI_ChannelType channel){
+	SPI_handle[channel]->MCR |= SPI_MCR_HALT_MASK;
+}
+
+SPI_Type* const SPI_handle[3] = {SPI0, SPI1, SPI2};
+
+void DELAY_us(uint32 micros){
+	(void)micros;
+}
+
+uint64 PIT_lifetimeElapsed(uint64 timeStamp){
+	(void)timeStamp;
+	return 0;
+}
+
+uint64 PIT_ticksToMicros(uint64 ticks){
+	return ticks;
+}
+
+void SCHED_timerStart(SCHED_TimerType* timer, uint32 delay, uint32 period, SCHED_CallbackType callback){
+	(void)timer;
+	(void)delay;
+	(void)period;
+	(void)callback;
+}
+
+uint8 SYSUPD_SDFsnapshot(SystemDisplayFlags* snapshot){
+	*snapshot = hostSdf;
+	return 0;
+}
+
+void SYSUPD_SUFsnapshot(SystemUpdateFlags* snapshot){
+	*snapshot = hostSuf;
+}
+
+uint16 HIST_count(){
+	return hostSampleCount;
+}
+
+const HIST_SampleType* HIST_sample(uint16 age){
+	return (age < hostSampleCount) ? &hostHistory[hostSampleCount - 1 - age] : 0;
+}
+
+/*Add a sample to the history, a triangle between 22 and 27 degrees*/
+static void hostSample(){
+	uint16 phase = hostSampleCount % 20;
+
+	hostHistory[hostSampleCount].timeStamp = hostSampleCount * HIST_PERIOD_MS;
+	hostHistory[hostSampleCount].value[HIST_TEMPERATURE] = 22.0f + 0.5f * ((phase < 10) ? phase : 20 - phase);
+	hostHistory[hostSampleCount].value[HIST_FREC] = 0;
+	hostSampleCount++;
+}
+
+/*End a frame in the capture*/
+static void hostFrame(const char* name){
+	fputc(HOST_FRAME_END, hostCapture);
+	fputc(0, hostCapture);
+	printf("%ld: %s, %ld commands, %ld data bytes\n", hostFrames++, name, hostCounters.commands,
+			hostCounters.data);
+	memset(&hostCounters, 0, sizeof(hostCounters));
+}
+
+/*Draw a screen whole, and then again with some of its fields changed*/
+static void hostScreen(MenuStateType state, const char* name, const SystemDisplayFlags* changed, uint8 dirty){
+	char text[128];
+
+	hostSdf.currentState = state;
+	update_Display(&hostSdf, SDF_ALL_DIRTY);
+	hostFrame(name);
+	if(changed){
+		hostSdf = *changed;
+		hostSdf.currentState = state;
+		update_Display(&hostSdf, dirty);
+		snprintf(text, sizeof(text), "%s, updated", name);
+		hostFrame(text);
+	}
+}
+
+static int hostDisp(const char* path){
+	SystemDisplayFlags base;
+	SystemDisplayFlags changed;
+
+	hostCapture = fopen(path, "wb");
+	if(!hostCapture){
+		perror(path);
+		return 2;
+	}
+	PCD_reset(&hostPcd);
+	lcdHostSpi[0].SR = SPI_SR_TCF_MASK;
+	while(hostSampleCount < GRAPH_COLUMNS){
+		hostSample();
+	}
+	hostSuf.currentAlarm = 26;
+
+	LCDNokia_init();
+	hostFrame("LCDNokia_init");
+
+	base.currentState = DEFAULT_DISP;
+	base.currentAlarm = 26;
+	base.currentSpeed = 80;
+	base.currentFormat = 0;
+	base.currentPerInc = 15;
+	base.currentManual = 0;
+	base.currentTemperature = 2534;
+	base.currentFrec = 123456;
+	hostSdf = base;
+
+	changed = base;
+	changed.currentTemperature = 2591;
+	changed.currentSpeed = 75;
+	hostScreen(DEFAULT_DISP, "default", &changed, SDF_TEMPERATURE_DIRTY | SDF_SPEED_DIRTY);
+	hostScreen(MENU_DISP, "main menu", 0, 0);
+	changed = hostSdf;
+	changed.currentAlarm = 27;
+	hostScreen(ALARM_DISP, "alarm", &changed, SDF_ALARM_DIRTY);
+	changed = hostSdf;
+	changed.currentFormat = 1;
+	changed.currentTemperature = 7864;
+	hostScreen(FORMAT_TEMP_DISP, "temperature format", &changed, SDF_FORMAT_DIRTY | SDF_TEMPERATURE_DIRTY);
+	hostSdf.currentFormat = 0;
+	hostSdf.currentTemperature = 2591;
+	changed = hostSdf;
+	changed.currentPerInc = 20;
+	hostScreen(PERCEN_DEC_DISP, "percentage", &changed, SDF_PERINC_DIRTY);
+	changed = hostSdf;
+	changed.currentManual = 1;
+	changed.currentSpeed = 60;
+	hostScreen(CTRL_MANUAL_DISP, "motor control", &changed, SDF_MANUAL_DIRTY | SDF_SPEED_DIRTY);
+	changed = hostSdf;
+	changed.currentFrec = 98700;
+	hostScreen(FREC_DISP, "frequency", &changed, SDF_FREC_DIRTY);
+	hostScreen(GRAPH_DISP, "trend graph", 0, 0);
+	/*As the display refresh does, when the history has a new sample*/
+	hostSample();
+	if(GRAPH_update()){
+		LCDNokia_flush();
+	}
+	hostFrame("trend graph, new sample");
+
+	fclose(hostCapture);
+	return 0;
+}
+
+/*Draw something random with the driver*/
+static void hostDraw(){
+	static const LCD_NumberFormatType format = {5, 2, "'C"};
+	static uint8 bitmap[LCD_X * LCD_Y / 8];
+	uint16 index;
+
+	switch(rand() % 16){
+	case 0:
+		LCDNokia_clear();
+		break;
+	case 1:
+		LCDNokia_scroll(rand() % 8);
+		break;
+	case 2:
+		for(index = 0; index < sizeof(bitmap); index++){
+			bitmap[index] = (uint8)rand();
+		}
+		LCDNokia_bitmap(bitmap);
+		break;
+	case 3:
+	case 4:
+	case 5:
+		LCDNokia_column(rand() % LCD_X, ((uint64)rand() << 32) | (uint64)rand());
+		break;
+	case 6:
+	case 7:
+		LCDNokia_gotoXY(rand() % LCD_X, rand() % LCD_ROWS);
+		LCDNokia_sendNumber(rand() % 20000 - 10000, &format);
+		break;
+	default:
+		LCDNokia_gotoXY(rand() % LCD_X, rand() % LCD_ROWS);
+		LCDNokia_sendChar(' ' + rand() % 95);
+		break;
+	}
+}
+
+static int hostSelfTest(long flushes){
+	long flush;
+	int count;
+
+	PCD_reset(&hostPcd);
+	lcdHostSpi[0].SR = SPI_SR_TCF_MASK;
+	LCDNokia_init();
+	/*0xBF is the Vop, in the extended set it doesn't move the address*/
+	if(hostPcd.function || (PCD_NORMAL != hostPcd.mode) || (0x3F != hostPcd.vop) || (4 != hostPcd.bias) ||
+			hostCounters.moves || hostCounters.data){
+		fprintf(stderr, "LCDNokia_init: function set %02x, mode %d, Vop %02x, bias %d, %ld moves, %ld data bytes\n",
+				hostPcd.function, hostPcd.mode, hostPcd.vop, hostPcd.bias, hostCounters.moves, hostCounters.data);
+		return 1;
+	}
+
+	for(flush = 0; flush < flushes; flush++){
+		memset(&hostCounters, 0, sizeof(hostCounters));
+		for(count = rand() % 8; count >= 0; count--){
+			hostDraw();
+		}
+		LCDNokia_flush();
+		/*The memory of the LCD is unknown after LCDNokia_init, the first flush sends it whole*/
+		if((0 == flush) && (LCD_X * LCD_ROWS != hostCounters.data)){
+			fprintf(stderr, "first flush: %ld data bytes\n", hostCounters.data);
+			return 1;
+		}
+		if(memcmp(hostPcd.memory, LCDNokia_frame(), sizeof(hostPcd.memory))){
+			fprintf(stderr, "flush %ld: the LCD is not the frame of the driver\n", flush);
+			return 1;
+		}
+	}
+	printf("%ld flushes ok\n", flushes);
+	return 0;
+}
+
+int main(int argc, char** argv){
+	if((argc > 1) && !strcmp(argv[1], "-t")){
+		srand((argc > 3) ? strtol(argv[3], 0, 0) : 1);
+		return hostSelfTest((argc > 2) ? strtol(argv[2], 0, 0) : 1000);
+	}
+	if(argc != 2){
+		fprintf(stderr, "use: %s capture | -t [flushes] [seed]\n", argv[0]);
+		return 2;
+	}
+	return hostDisp(argv[1]);
+}
@@ -0,0 +1,38 @@
+/**
+	\file
+	\brief
+		Host stub of the SPI and GPIO writes for tools/lcdhost.c. It is included first
+		(-include) in the LCD driver, DISP and GRAPH, so the GPIO ports and the SPIs are
+		registers in RAM, and LCDNokia_writeByte() calls LCDNokia_capture() with each byte.
+	\date	19/10/2026
+ */
+
+#ifndef TOOLS_LCDHOST_H_
+#define TOOLS_LCDHOST_H_
+
+#include "MK64F12.h"
+
+#define LCD_CAPTURE
+
+/*The registers, in RAM*/
+extern GPIO_Type lcdHostGpio[5];
+extern SPI_Type lcdHostSpi[3];
+
+#undef PTA
+#define PTA (&lcdHostGpio[0])
+#undef PTB
+#define PTB (&lcdHostGpio[1])
+#undef PTC
+#define PTC (&lcdHostGpio[2])
+#undef PTD
+#define PTD (&lcdHostGpio[3])
+#undef PTE
+#define PTE (&lcdHostGpio[4])
+#undef SPI0
+#define SPI0 (&lcdHostSpi[0])
+#undef SPI1
+#define SPI1 (&lcdHostSpi[1])
+#undef SPI2
+#define SPI2 (&lcdHostSpi[2])
+
+#endif /* TOOLS_LCDHOST_H_ */
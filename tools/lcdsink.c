@@ -0,0 +1,130 @@
+/**
+	\file
+	\brief
+		Host tool that stands in for the LCD: it replays a capture of the bytes that
+		LCDNokia_writeByte() sent on the model of its controller (see pcd8544.h). The
+		capture has two bytes per LCDNokia_writeByte(), the D/C level (LCD_CMD or LCD_DATA)
+		and the byte, as tools/lcdhost.c writes it from the driver built on the host, or
+		as converted from a logic analyzer; a pair with the level SINK_FRAME_END ends a
+		frame (lcdhost ends one after each LCDNokia_flush), and so does the end of the
+		capture.
+
+		For each frame, a CSV line to stdout with the commands, the data bytes, the address
+		moves (and how many of them didn't change the address), and the bytes of the memory
+		that changed. With -p the image shown after each frame is saved as prefixNNNN.pbm,
+		and with -g the image after each frame is compared to the golden prefixNNNN.pbm
+		(exit code 1 if one is not the same), so the screens can be tested and the SPI
+		traffic of each update measured. The golden images of the screens of DISP are in
+		tools/golden (see tools/lcdhost.c).
+
+		Build and use:
+			cc -I. -o lcdsink tools/lcdsink.c tools/pcd8544.c
+			./lcdsink capture.bin [-p prefix] [-g golden prefix]
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pcd8544.h"
+
+/*D/C level of the pair that ends a frame in the capture*/
+#define SINK_FRAME_END 0xFF
+
+/*End of a frame: its line, its image and its check. Returns the pixels that differ from
+ * the golden image, or -1 on an error*/
+static int endFrame(const PCD_Type* pcd, long frame, PCD_CountersType* counters, const char* prefix,
+		const char* golden){
+	char path[4096];
+	int differ = 0;
+
+	printf("%ld,%ld,%ld,%ld,%ld,%ld\n", frame, counters->commands, counters->data, counters->moves,
+			counters->redundant, counters->changed);
+	memset(counters, 0, sizeof(*counters));
+	if(prefix){
+		snprintf(path, sizeof(path), "%s%04ld.pbm", prefix, frame);
+		if(PCD_savePbm(pcd, path)){
+			return -1;
+		}
+	}
+	if(golden){
+		snprintf(path, sizeof(path), "%s%04ld.pbm", golden, frame);
+		differ = PCD_comparePbm(pcd, path);
+		if(differ > 0){
+			fprintf(stderr, "frame %ld: %d pixels differ from %s\n", frame, differ, path);
+		}
+	}
+	return differ;
+}
+
+static int sinkCapture(const char* capture, const char* prefix, const char* golden){
+	static PCD_Type pcd;
+	PCD_CountersType counters;
+	PCD_CountersType total;
+	FILE* in = fopen(capture, "rb");
+	long frame = 0;
+	long failed = 0;
+	int level;
+	int byte;
+	int pending = 0;
+	int differ;
+
+	if(!in){
+		perror(capture);
+		return 2;
+	}
+	PCD_reset(&pcd);
+	memset(&counters, 0, sizeof(counters));
+	memset(&total, 0, sizeof(total));
+	printf("frame,commands,data,moves,redundant moves,bytes changed\n");
+	while(((level = fgetc(in)) != EOF) && ((byte = fgetc(in)) != EOF)){
+		if(SINK_FRAME_END == level){
+			differ = endFrame(&pcd, frame++, &counters, prefix, golden);
+			if(differ < 0){
+				return 2;
+			}
+			failed += (differ > 0);
+			pending = 0;
+			continue;
+		}
+		PCD_write(&pcd, (uint8)level, (uint8)byte, &counters);
+		total.commands += (LCD_DATA != level);
+		total.data += (LCD_DATA == level);
+		pending = 1;
+	}
+	fclose(in);
+	if(pending){
+		differ = endFrame(&pcd, frame++, &counters, prefix, golden);
+		if(differ < 0){
+			return 2;
+		}
+		failed += (differ > 0);
+	}
+	fprintf(stderr, "%ld frames, %ld commands, %ld data bytes", frame, total.commands, total.data);
+	if(golden){
+		fprintf(stderr, ", %ld frames differ from the golden images", failed);
+	}
+	fprintf(stderr, "\n");
+	return failed ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+	const char* prefix = 0;
+	const char* golden = 0;
+	int index;
+
+	for(index = 2; index + 1 < argc; index += 2){
+		if(!strcmp(argv[index], "-p")){
+			prefix = argv[index + 1];
+		} else if(!strcmp(argv[index], "-g")){
+			golden = argv[index + 1];
+		} else {
+			break;
+		}
+	}
+	if((argc < 2) || (index != argc)){
+		fprintf(stderr, "use: %s capture [-p prefix] [-g golden prefix]\n", argv[0]);
+		return 2;
+	}
+	return sinkCapture(argv[1], prefix, golden);
+}
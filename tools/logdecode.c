@@ -0,0 +1,184 @@
+/**
+	\file
+	\brief
+		Host tool that decodes a dump of the sample log (see LOG.h for the block layout).
+		The dump is the memory returned by LOG_blocks(), LOG_BLOCKS*LOG_BLOCK_SIZE bytes,
+		saved from the debugger. The samples are written to stdout as CSV, in time order,
+		followed by the compression ratio.
+
+		The log uses the blocks as a ring, so they are decoded in the order of the ring,
+		from the block that follows the newest one. The timestamps are only compared
+		between blocks next to each other, as differences, so the order holds when the
+		32-bit millisecond tick wraps (every 49.7 days).
+
+		Build and use:
+			cc -o logdecode tools/logdecode.c
+			./logdecode dump.bin [block size, 256 by default]
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*Must match LOG.h*/
+#define LOG_BLOCK_SIZE 256
+#define LOG_HEADER_SIZE 14
+#define LOG_RAW_SAMPLE_SIZE 12
+
+/*Read a value in little endian*/
+static uint32_t get(const uint8_t* data, int bytes){
+	uint32_t value = 0;
+
+	while(bytes--){
+		value = (value << 8) | data[bytes];
+	}
+	return value;
+}
+
+/*Read a varint, returns the offset after it, or -1 past the end of the block*/
+static long getVarint(const uint8_t* data, long offset, long size, uint32_t* value){
+	uint32_t code = 0;
+	int shift = 0;
+	uint8_t byte;
+
+	do{
+		if(offset >= size){
+			return -1;
+		}
+		byte = data[offset++];
+		code |= (uint32_t)(byte & 0x7F) << shift;
+		shift += 7;
+	}while((byte & 0x80) && (shift < 35));
+	*value = code;
+	return offset;
+}
+
+static int32_t unzigzag(uint32_t code){
+	return (int32_t)((code >> 1) ^ (0u - (code & 1)));
+}
+
+/*Block of the dump, with its first timestamp to find the oldest one*/
+typedef struct{
+	const uint8_t* data;
+	uint32_t firstTime;
+}Block;
+
+/*Position of the oldest block: the blocks in use follow each other in the ring, so the
+ * oldest one is the only one that starts before the block that precedes it*/
+static long oldestBlock(const Block* blocks, long used){
+	long index;
+
+	for(index = 0; index < used; index++){
+		if((int32_t)(blocks[index].firstTime - blocks[(index + used - 1) % used].firstTime) < 0){
+			return index;
+		}
+	}
+	return 0;
+}
+
+/*Print the samples of a block, returns the bytes that they take, or -1 if it is corrupt*/
+static long decodeBlock(const uint8_t* data, long size, unsigned long* samples){
+	uint32_t timeStamp = get(&data[0], 4);
+	int32_t temperature = (int32_t)get(&data[4], 4);
+	int32_t frec = (int32_t)get(&data[8], 4);
+	unsigned count = get(&data[12], 2);
+	int32_t interval = 0;
+	uint32_t code;
+	uint32_t change;
+	long offset = LOG_HEADER_SIZE;
+	unsigned sample;
+
+	for(sample = 0; sample < count; sample++){
+		if(sample){
+			if((offset = getVarint(data, offset, size, &code)) < 0){
+				return -1;
+			}
+			if(code & 1){
+				if((offset = getVarint(data, offset, size, &change)) < 0){
+					return -1;
+				}
+				interval += unzigzag(change);
+			}
+			timeStamp += interval;
+			temperature += unzigzag(code >> 1);
+			if((offset = getVarint(data, offset, size, &code)) < 0){
+				return -1;
+			}
+			frec += unzigzag(code);
+		}
+		printf("%lu,%.2f,%.2f\n", (unsigned long)timeStamp, temperature / 100.0, frec / 100.0);
+	}
+	*samples += count;
+	return offset;
+}
+
+int main(int argc, char** argv){
+	long blockSize = LOG_BLOCK_SIZE;
+	unsigned long samples = 0;
+	unsigned long bytes = 0;
+	uint8_t* dump;
+	Block* blocks;
+	long size;
+	long used = 0;
+	long oldest;
+	long index;
+	long length;
+	FILE* file;
+
+	if(argc < 2){
+		fprintf(stderr, "usage: %s dump.bin [block size]\n", argv[0]);
+		return 1;
+	}
+	if(argc > 2){
+		blockSize = strtol(argv[2], 0, 0);
+	}
+	if(blockSize <= LOG_HEADER_SIZE){
+		fprintf(stderr, "bad block size\n");
+		return 1;
+	}
+
+	file = fopen(argv[1], "rb");
+	if(!file){
+		perror(argv[1]);
+		return 1;
+	}
+	fseek(file, 0, SEEK_END);
+	size = ftell(file);
+	fseek(file, 0, SEEK_SET);
+	dump = malloc(size ? size : 1);
+	blocks = malloc(sizeof(Block) * (size / blockSize + 1));
+	if(!dump || !blocks || (long)fread(dump, 1, size, file) != size){
+		fprintf(stderr, "can't read %s\n", argv[1]);
+		return 1;
+	}
+	fclose(file);
+
+	/*The unused blocks have no samples*/
+	for(index = 0; index + blockSize <= size; index += blockSize){
+		if(get(&dump[index + 12], 2)){
+			blocks[used].data = &dump[index];
+			blocks[used].firstTime = get(&dump[index], 4);
+			used++;
+		}
+	}
+	oldest = oldestBlock(blocks, used);
+
+	printf("time_ms,temperature_c,frec_hz\n");
+	for(index = 0; index < used; index++){
+		const Block* block = &blocks[(oldest + index) % used];
+
+		length = decodeBlock(block->data, blockSize, &samples);
+		if(length < 0){
+			fprintf(stderr, "block at %ld is corrupt\n", (long)(block->data - dump));
+			return 1;
+		}
+		bytes += length;
+	}
+
+	fprintf(stderr, "%lu samples in %lu bytes, %.2f:1\n", samples, bytes,
+			bytes ? (double)samples * LOG_RAW_SAMPLE_SIZE / bytes : 0.0);
+	free(blocks);
+	free(dump);
+	return 0;
+}
@@ -0,0 +1,263 @@
+/**
+	\file
+	\brief
+		Host viewer of the screen mirror (see MIRR.h for the frame layout). It reads the
+		frames from a serial port, or a file with a capture of it, skips the other frames
+		(telemetry, responses), and applies the spans of each mirror frame to a copy of the
+		LCD memory. The screen is drawn in the terminal after each frame, two pixel rows per
+		character, or saved as a PBM image; a frame with a bad CRC is skipped, and the
+		screen is right again with the next frame that has the whole screen.
+
+		Build and use:
+			cc -I. -o mirrview tools/mirrview.c COBS.c CRC.c
+			./mirrview /dev/ttyACM0                    (terminal)
+			./mirrview /dev/ttyACM0 screen.pbm         (the image after each frame)
+			./mirrview capture.bin screen.pbm          (the image at the end of the capture)
+	\date	19/10/2026
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "MIRR.h"
+#include "CRC.h"
+
+/*Copy of the LCD memory, and if a frame with the whole screen arrived*/
+static uint8 screen[LCD_ROWS][LCD_X];
+static int haveKey = 0;
+/*Counters*/
+static long frames = 0;
+static long errors = 0;
+static long lost = 0;
+static long screenBytes = 0;
+static long frameBytes = 0;
+
+static volatile sig_atomic_t stop = 0;
+
+static void onSignal(int signal){
+	(void)signal;
+	stop = 1;
+}
+
+/*Expand a span compressed with RLE, FALSE if it doesn't have count bytes*/
+static int unRle(const uint8* data, int length, uint8* out, int count, int* used){
+	int index = 0;
+	int size = 0;
+	int run;
+	uint8 control;
+
+	while(size < count){
+		if(index >= length){
+			return 0;
+		}
+		control = data[index++];
+		if(control < 0x80){
+			run = control + 1;
+			if((index + run > length) || (size + run > count)){
+				return 0;
+			}
+			memcpy(&out[size], &data[index], run);
+			index += run;
+		} else {
+			run = control - 0x80 + MIRR_RUN_MIN;
+			if((index >= length) || (size + run > count)){
+				return 0;
+			}
+			memset(&out[size], data[index++], run);
+		}
+		size += run;
+	}
+	*used = index;
+	return 1;
+}
+
+/*Apply a mirror frame decoded to the screen, FALSE if it is not valid. The spans are
+ * checked whole before the screen changes*/
+static int apply(const uint8* frame, int length){
+	static uint8 sequence;
+	uint8 spans[LCD_ROWS * 2][LCD_X];
+	uint8 row[LCD_ROWS * 2];
+	uint8 first[LCD_ROWS * 2];
+	uint8 count[LCD_ROWS * 2];
+	uint16 crc;
+	int span = 0;
+	int index;
+	int used;
+
+	if((length < MIRR_HEADER + MIRR_CRC_SIZE) || (MIRR_KIND_FRAME != frame[0])){
+		return 0;
+	}
+	length -= MIRR_CRC_SIZE;
+	crc = CRC_ccitt(CRC_INIT, frame, length);
+	if((frame[length] != (uint8)crc) || (frame[length + 1] != (uint8)(crc >> 8))){
+		return 0;
+	}
+	for(index = MIRR_HEADER; index < length; index += used){
+		if((span == LCD_ROWS * 2) || (index + MIRR_SPAN_HEADER > length)){
+			return 0;
+		}
+		row[span] = frame[index];
+		first[span] = frame[index + 1];
+		count[span] = frame[index + 2];
+		index += MIRR_SPAN_HEADER;
+		if((row[span] >= LCD_ROWS) || !count[span] || (first[span] + count[span] > LCD_X) ||
+				!unRle(&frame[index], length - index, spans[span], count[span], &used)){
+			return 0;
+		}
+		span++;
+	}
+
+	if(frames && (frame[1] != (uint8)(sequence + 1))){
+		lost += (uint8)(frame[1] - sequence - 1);
+	}
+	sequence = frame[1];
+	if(frame[2] & MIRR_FLAG_KEY){
+		haveKey = 1;
+	}
+	for(index = 0; index < span; index++){
+		memcpy(&screen[row[index]][first[index]], spans[index], count[index]);
+		screenBytes += count[index];
+	}
+	return 1;
+}
+
+static int pixel(int x, int y){
+	return (screen[y / 8][x] >> (y % 8)) & 1;
+}
+
+/*Draw the screen in the terminal, from its top left corner*/
+static void drawTerminal(){
+	int x;
+	int y;
+
+	printf("\033[H");
+	for(y = 0; y < LCD_Y; y += 2){
+		for(x = 0; x < LCD_X; x++){
+			fputs(pixel(x, y) ? (pixel(x, y + 1) ? "\xe2\x96\x88" : "\xe2\x96\x80") :
+					(pixel(x, y + 1) ? "\xe2\x96\x84" : " "), stdout);
+		}
+		putchar('\n');
+	}
+	printf("frame %ld%s, %ld bad, %ld lost\033[K\n", frames, haveKey ? "" : " (waiting for a key frame)",
+			errors, lost);
+	fflush(stdout);
+}
+
+/*Save the screen as a PBM image, written whole before it replaces the previous one*/
+static int savePbm(const char* path){
+	char temporary[4096];
+	FILE* out;
+	int x;
+	int y;
+	uint8 byte;
+
+	snprintf(temporary, sizeof(temporary), "%s.tmp", path);
+	out = fopen(temporary, "wb");
+	if(!out){
+		perror(temporary);
+		return -1;
+	}
+	fprintf(out, "P4\n%d %d\n", LCD_X, LCD_Y);
+	for(y = 0; y < LCD_Y; y++){
+		for(x = 0, byte = 0; x < LCD_X; x++){
+			byte |= pixel(x, y) << (7 - x % 8);
+			if((7 == x % 8) || (LCD_X - 1 == x)){
+				fputc(byte, out);
+				byte = 0;
+			}
+		}
+	}
+	fclose(out);
+	return rename(temporary, path);
+}
+
+/*Raw bytes, no echo nor translations*/
+static int setRaw(int fd){
+	struct termios settings;
+
+	if(tcgetattr(fd, &settings)){
+		return -1;
+	}
+	cfmakeraw(&settings);
+#ifdef B460800
+	cfsetispeed(&settings, B460800);
+	cfsetospeed(&settings, B460800);
+#endif
+	return tcsetattr(fd, TCSANOW, &settings);
+}
+
+int main(int argc, char** argv){
+	static uint8 received[COBS_MAX_SIZE(MIRR_FRAME_SIZE)];
+	uint8 bytes[256];
+	const char* pbm = (argc > 2) ? argv[2] : 0;
+	int length = 0;
+	int overflow = 0;
+	int tty;
+	int decoded;
+	ssize_t count;
+	ssize_t index;
+	int fd;
+
+	if((argc < 2) || (argc > 3)){
+		fprintf(stderr, "use: %s serial port or capture [image.pbm]\n", argv[0]);
+		return 2;
+	}
+	fd = open(argv[1], O_RDONLY | O_NOCTTY);
+	if(fd < 0){
+		perror(argv[1]);
+		return 2;
+	}
+	tty = isatty(fd);
+	if(tty && setRaw(fd)){
+		perror(argv[1]);
+		return 2;
+	}
+	signal(SIGINT, onSignal);
+	if(!pbm){
+		printf("\033[2J");
+	}
+
+	while(!stop && ((count = read(fd, bytes, sizeof(bytes))) > 0)){
+		for(index = 0; index < count; index++){
+			if(COBS_DELIMITER != bytes[index]){
+				if(length < (int)sizeof(received)){
+					received[length++] = bytes[index];
+				} else {
+					overflow = 1;
+				}
+				continue;
+			}
+			decoded = overflow ? COBS_INVALID : COBS_decode(received, length, received);
+			overflow = 0;
+			length = 0;
+			/*The other kinds of frame are not counted*/
+			if((COBS_INVALID == decoded) || (decoded < 1) ||
+					((MIRR_KIND_FRAME == received[0]) && !apply(received, decoded))){
+				errors++;
+				continue;
+			}
+			if(MIRR_KIND_FRAME != received[0]){
+				continue;
+			}
+			frames++;
+			frameBytes += decoded;
+			if(!pbm){
+				drawTerminal();
+			} else if(tty && savePbm(pbm)){
+				return 2;
+			}
+		}
+	}
+	close(fd);
+	if(pbm && savePbm(pbm)){
+		return 2;
+	}
+	fprintf(stderr, "%ld frames, %ld bad, %ld lost, %ld screen bytes in %ld frame bytes\n",
+			frames, errors, lost, screenBytes, frameBytes);
+	return 0;
+}
@@ -0,0 +1,216 @@
+/**
+	\file
+	\brief
+		Host tool that runs the settings store (NVS.c) on a flash simulated in RAM. The
+		simulated flash behaves like the FTFE: an erase sets the bytes to 0xFF, a phrase can
+		only be programmed once after an erase, and the commands take some polls to finish.
+		The tool saves random settings and cuts the power at random points, also in the
+		middle of a command (the bytes being programmed or erased are left half done). After
+		each cut the store is started again, and the settings restored must be the last ones
+		committed, or the ones that were being written. Some programs also fail without
+		changing a bit, so the slot of a record can fail while it is still blank.
+
+		Build and use:
+			cc -I. -o nvssim tools/nvssim.c NVS.c CRC.c
+			./nvssim [power cycles, 10000 by default] [seed]
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NVS.h"
+
+/*Polls that each command takes*/
+#define SIM_PROGRAM_POLLS 1
+#define SIM_ERASE_POLLS 20
+/*One program in this many fails without programming anything*/
+#define SIM_FAULT_RATE 50
+
+/*Memory of the simulated flash, only the sectors of the log*/
+static uint8 simMemory[NVS_SECTORS * FLASH_SECTOR_SIZE];
+/*Command running: address, polls left, and the data of a program*/
+static int simCommand = 0;
+static uint32 simAddress;
+static int simPolls = 0;
+static uint8 simData[FLASH_PHRASE];
+static int simFailed = FALSE;
+/*The last program failed on purpose, the next one doesn't, so NVS never runs out of
+ * retries*/
+static int simFaulted = FALSE;
+/*Phrases programmed since their erase*/
+static uint8 simProgrammed[NVS_SECTORS * FLASH_SECTOR_SIZE / FLASH_PHRASE];
+
+static uint32 simOffset(uint32 address){
+	if(address < NVS_BASE || address >= NVS_BASE + sizeof(simMemory)){
+		fprintf(stderr, "access out of the log at %08lx\n", (unsigned long)address);
+		exit(2);
+	}
+	return address - NVS_BASE;
+}
+
+/*End the running command*/
+static void simComplete(){
+	uint32 offset = simOffset(simAddress);
+	int index;
+
+	if(FLASH_ERASE_SECTOR == simCommand){
+		offset -= offset % FLASH_SECTOR_SIZE;
+		memset(&simMemory[offset], FLASH_ERASED, FLASH_SECTOR_SIZE);
+		memset(&simProgrammed[offset / FLASH_PHRASE], 0, FLASH_SECTOR_SIZE / FLASH_PHRASE);
+	} else if(FLASH_PROGRAM_PHRASE == simCommand){
+		for(index = 0; index < FLASH_PHRASE; index++){
+			simMemory[offset + index] &= simData[index];
+		}
+	}
+	simCommand = 0;
+}
+
+static uint8 simBusy(){
+	if(simCommand && (0 == --simPolls)){
+		simComplete();
+	}
+	return simCommand ? TRUE : FALSE;
+}
+
+static uint8 simFailedCommand(){
+	return simFailed;
+}
+
+static uint8 simProgram(uint32 address, const uint8* data){
+	uint32 offset = simOffset(address);
+
+	if(simCommand){
+		return FALSE;
+	}
+	/*Misaligned or programmed twice, like ACCERR or MGSTAT0*/
+	simFailed = ((offset % FLASH_PHRASE) || simProgrammed[offset / FLASH_PHRASE]) ? TRUE : FALSE;
+	if(simFailed){
+		return TRUE;
+	}
+	/*A fault: the command ends with an error and the phrase is left as it was, blank if it
+	 * is the first one of the record*/
+	if(!simFaulted && !(rand() % SIM_FAULT_RATE)){
+		simFaulted = TRUE;
+		simFailed = TRUE;
+		return TRUE;
+	}
+	simFaulted = FALSE;
+	simProgrammed[offset / FLASH_PHRASE] = TRUE;
+	memcpy(simData, data, FLASH_PHRASE);
+	simAddress = address;
+	simCommand = FLASH_PROGRAM_PHRASE;
+	simPolls = SIM_PROGRAM_POLLS;
+	return TRUE;
+}
+
+static uint8 simErase(uint32 address){
+	simOffset(address);
+	if(simCommand){
+		return FALSE;
+	}
+	simFailed = FALSE;
+	simAddress = address;
+	simCommand = FLASH_ERASE_SECTOR;
+	simPolls = SIM_ERASE_POLLS;
+	return TRUE;
+}
+
+static const uint8* simRead(uint32 address){
+	return &simMemory[simOffset(address)];
+}
+
+static const FLASH_DriverType simFlash = {simBusy, simFailedCommand, simProgram, simErase, simRead};
+
+/*Cut the power: the command running is left half done*/
+static void simPowerCut(){
+	uint32 offset;
+	int index;
+
+	if(FLASH_PROGRAM_PHRASE == simCommand){
+		offset = simOffset(simAddress);
+		for(index = 0; index < FLASH_PHRASE; index++){
+			simMemory[offset + index] &= simData[index] | (uint8)rand();
+		}
+	} else if(FLASH_ERASE_SECTOR == simCommand){
+		offset = simOffset(simAddress);
+		offset -= offset % FLASH_SECTOR_SIZE;
+		for(index = 0; index < FLASH_SECTOR_SIZE; index++){
+			simMemory[offset + index] |= (uint8)rand();
+		}
+		/*The sector can't be trusted, it must be erased again*/
+		memset(&simProgrammed[offset / FLASH_PHRASE], 1, FLASH_SECTOR_SIZE / FLASH_PHRASE);
+	}
+	simCommand = 0;
+}
+
+static void randomSettings(NVS_SettingsType* settings){
+	settings->alarm = (uint8)(15 + rand() % 31);
+	settings->format = (uint8)(rand() % 2);
+	settings->perInc = (uint8)(5 * (1 + rand() % 20));
+	settings->manual = (uint8)(rand() % 2);
+	settings->speed = (uint8)(rand() % 101);
+}
+
+int main(int argc, char** argv){
+	long cycles = (argc > 1) ? strtol(argv[1], 0, 0) : 10000;
+	NVS_SettingsType committed;
+	NVS_SettingsType writing;
+	NVS_SettingsType restored;
+	NVS_StatsType stats;
+	int haveCommitted = FALSE;
+	int haveWriting = FALSE;
+	int restoredValid;
+	int right;
+	long cycle;
+	long saves = 0;
+	long erases = 0;
+	long polls;
+	long cut;
+
+	srand((argc > 2) ? (unsigned)strtoul(argv[2], 0, 0) : 1);
+	memset(simMemory, FLASH_ERASED, sizeof(simMemory));
+
+	for(cycle = 0; cycle < cycles; cycle++){
+		/*Power up*/
+		NVS_init(&simFlash);
+		restoredValid = NVS_restore(&restored);
+		if(restoredValid){
+			right = (haveCommitted && !memcmp(&restored, &committed, sizeof(restored))) ||
+					(haveWriting && !memcmp(&restored, &writing, sizeof(restored)));
+		} else {
+			right = !haveCommitted;
+		}
+		if(!right){
+			fprintf(stderr, "cycle %ld: wrong settings restored\n", cycle);
+			return 1;
+		}
+		haveCommitted = restoredValid;
+		haveWriting = FALSE;
+		committed = restored;
+
+		/*Save some settings, and cut the power at a random poll*/
+		cut = rand() % 400;
+		for(polls = 0; polls < cut; polls++){
+			if(!NVS_busy()){
+				randomSettings(&writing);
+				NVS_save(&writing);
+				haveWriting = TRUE;
+				saves++;
+			}
+			NVS_poll();
+			if(!NVS_busy()){
+				committed = writing;
+				haveCommitted = TRUE;
+				haveWriting = FALSE;
+			}
+		}
+		NVS_stats(&stats);
+		erases += stats.erases;
+		simPowerCut();
+	}
+
+	printf("%ld power cycles, %ld saves, %ld sector erases, newest sequence %lu: OK\n",
+			cycles, saves, erases, (unsigned long)stats.sequence);
+	return 0;
+}
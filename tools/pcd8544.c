@@ -0,0 +1,147 @@
+/**
+	\file
+	\brief
+		Host model of the PCD8544 (see pcd8544.h).
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pcd8544.h"
+
+/*Bytes of a row of a PBM (P4), LCD_X bits padded to bytes*/
+#define PCD_PBM_ROW ((LCD_X + 7) / 8)
+
+void PCD_reset(PCD_Type* pcd){
+	memset(pcd, 0, sizeof(*pcd));
+	pcd->function = PCD_POWER_DOWN;
+	pcd->mode = PCD_BLANK;
+}
+
+static void PCD_command(PCD_Type* pcd, uint8 byte, PCD_CountersType* counters){
+	counters->commands++;
+	if(PCD_FUNCTION_SET == (byte & 0xF8)){
+		pcd->function = byte & (PCD_POWER_DOWN | PCD_VERTICAL | PCD_EXTENDED);
+	} else if(pcd->function & PCD_EXTENDED){
+		if(byte & 0x80){
+			pcd->vop = byte & 0x7F;
+		} else if(0x10 == (byte & 0xF8)){
+			pcd->bias = byte & 0x07;
+		} else if(0x04 == (byte & 0xFC)){
+			pcd->temperature = byte & 0x03;
+		}
+	} else if(byte & PCD_SET_X){
+		/*Addresses out of the memory are ignored, as in the controller*/
+		if((byte & 0x7F) < LCD_X){
+			counters->moves++;
+			counters->redundant += (pcd->x == (byte & 0x7F));
+			pcd->x = byte & 0x7F;
+		}
+	} else if(byte & PCD_SET_Y){
+		if((byte & 0x07) < LCD_ROWS){
+			counters->moves++;
+			counters->redundant += (pcd->y == (byte & 0x07));
+			pcd->y = byte & 0x07;
+		}
+	} else if(PCD_DISPLAY_CONTROL == (byte & 0xF8)){
+		pcd->mode = (PCD_ModeType)(((byte & PCD_DISPLAY_D) ? 2 : 0) | ((byte & PCD_DISPLAY_E) ? 1 : 0));
+	}
+}
+
+static void PCD_data(PCD_Type* pcd, uint8 byte, PCD_CountersType* counters){
+	counters->data++;
+	counters->changed += (pcd->memory[pcd->y][pcd->x] != byte);
+	pcd->memory[pcd->y][pcd->x] = byte;
+	if(pcd->function & PCD_VERTICAL){
+		if(++pcd->y == LCD_ROWS){
+			pcd->y = 0;
+			pcd->x = (pcd->x + 1) % LCD_X;
+		}
+	} else if(++pcd->x == LCD_X){
+		pcd->x = 0;
+		pcd->y = (pcd->y + 1) % LCD_ROWS;
+	}
+}
+
+void PCD_write(PCD_Type* pcd, uint8 dataOrCmd, uint8 byte, PCD_CountersType* counters){
+	if(LCD_DATA == dataOrCmd){
+		PCD_data(pcd, byte, counters);
+	} else {
+		PCD_command(pcd, byte, counters);
+	}
+}
+
+int PCD_pixel(const PCD_Type* pcd, int x, int y){
+	int bit = (pcd->memory[y / 8][x] >> (y % 8)) & 1;
+
+	if(pcd->function & PCD_POWER_DOWN){
+		return 0;
+	}
+	switch(pcd->mode){
+	case PCD_BLANK:
+		return 0;
+	case PCD_ALL_ON:
+		return 1;
+	case PCD_INVERSE:
+		return !bit;
+	default:
+		return bit;
+	}
+}
+
+/*The image shown, as the data of a PBM*/
+static void PCD_image(const PCD_Type* pcd, uint8 image[LCD_Y][PCD_PBM_ROW]){
+	int x;
+	int y;
+
+	memset(image, 0, LCD_Y * PCD_PBM_ROW);
+	for(y = 0; y < LCD_Y; y++){
+		for(x = 0; x < LCD_X; x++){
+			image[y][x / 8] |= PCD_pixel(pcd, x, y) << (7 - x % 8);
+		}
+	}
+}
+
+int PCD_savePbm(const PCD_Type* pcd, const char* path){
+	uint8 image[LCD_Y][PCD_PBM_ROW];
+	FILE* out = fopen(path, "wb");
+
+	if(!out){
+		perror(path);
+		return -1;
+	}
+	PCD_image(pcd, image);
+	fprintf(out, "P4\n%d %d\n", LCD_X, LCD_Y);
+	fwrite(image, 1, sizeof(image), out);
+	return fclose(out) ? -1 : 0;
+}
+
+int PCD_comparePbm(const PCD_Type* pcd, const char* path){
+	uint8 image[LCD_Y][PCD_PBM_ROW];
+	uint8 golden[LCD_Y][PCD_PBM_ROW];
+	FILE* in = fopen(path, "rb");
+	int width;
+	int height;
+	int x;
+	int y;
+	int differ = 0;
+
+	if(!in){
+		perror(path);
+		return -1;
+	}
+	if((fscanf(in, "P4 %d %d", &width, &height) != 2) || (LCD_X != width) || (LCD_Y != height) ||
+			(fgetc(in) == EOF) || (fread(golden, 1, sizeof(golden), in) != sizeof(golden))){
+		fprintf(stderr, "%s is not a %dx%d PBM\n", path, LCD_X, LCD_Y);
+		fclose(in);
+		return -1;
+	}
+	fclose(in);
+	PCD_image(pcd, image);
+	for(y = 0; y < LCD_Y; y++){
+		for(x = 0; x < LCD_X; x++){
+			differ += ((image[y][x / 8] ^ golden[y][x / 8]) >> (7 - x % 8)) & 1;
+		}
+	}
+	return differ;
+}
@@ -0,0 +1,106 @@
+/**
+	\file
+	\brief
+		Host model of the PCD8544, the controller of the LCD, shared by tools/lcdsink.c and
+		tools/lcdhost.c. It takes the bytes that LCDNokia_writeByte() sends, with the level
+		of the D/C pin, and keeps the LCD memory and the image shown as the controller does.
+
+		The commands are decoded with the H bit of the last function set: in the basic set
+		0x40|y and 0x80|x move the address and 0x08-0x0D select the display mode, in the
+		extended set 0x80|Vop, the bias and the temperature coefficient are only kept. A
+		data byte is written at the address, that moves to the next column, or to the next
+		row with the vertical addressing.
+	\date	19/10/2026
+ */
+
+#ifndef TOOLS_PCD8544_H_
+#define TOOLS_PCD8544_H_
+
+#include "LCDNokia5110.h"
+
+/*Bits of the commands*/
+#define PCD_FUNCTION_SET 0x20
+#define PCD_POWER_DOWN 0x04
+#define PCD_VERTICAL 0x02
+#define PCD_EXTENDED 0x01
+#define PCD_DISPLAY_CONTROL 0x08
+#define PCD_DISPLAY_D 0x04
+#define PCD_DISPLAY_E 0x01
+#define PCD_SET_Y 0x40
+#define PCD_SET_X 0x80
+
+/*! This enumerated constant is what the glass shows, selected by D and E*/
+typedef enum {
+	PCD_BLANK,
+	PCD_ALL_ON,
+	PCD_NORMAL,
+	PCD_INVERSE
+} PCD_ModeType;
+
+/**
+ * Struct PCD_Type is the state of the controller
+ * **/
+typedef struct{
+	uint8 memory[LCD_ROWS][LCD_X];
+	uint8 x;
+	uint8 y;
+	/*bits of the last function set*/
+	uint8 function;
+	PCD_ModeType mode;
+	/*extended set, only kept*/
+	uint8 vop;
+	uint8 bias;
+	uint8 temperature;
+}PCD_Type;
+
+/**
+ * Struct PCD_CountersType is the traffic of a frame
+ * **/
+typedef struct{
+	long commands;
+	long data;
+	long moves;
+	/*moves to the address it already had*/
+	long redundant;
+	/*data bytes that changed the memory*/
+	long changed;
+}PCD_CountersType;
+
+/*!
+ 	 \brief	 This function puts the controller in its reset state. The memory is not defined
+ 	 after the reset, it is cleared
+ 	 \param[out] pcd - the controller
+ 	 \return void
+ */
+void PCD_reset(PCD_Type* pcd);
+
+/*!
+ 	 \brief	 This function takes a byte sent to the controller
+ 	 \param[in,out] pcd - the controller
+ 	 \param[in] dataOrCmd - level of the D/C pin, LCD_DATA or LCD_CMD
+ 	 \param[in] byte - the byte
+ 	 \param[in,out] counters - the traffic, the byte is added to it
+ 	 \return void
+ */
+void PCD_write(PCD_Type* pcd, uint8 dataOrCmd, uint8 byte, PCD_CountersType* counters);
+
+/*!
+ 	 \brief	 This function returns a pixel as the glass shows it
+ 	 \return int - 1 if it is dark
+ */
+int PCD_pixel(const PCD_Type* pcd, int x, int y);
+
+/*!
+ 	 \brief	 This function saves the image shown as a PBM (P4)
+ 	 \return int - 0, or -1 if it couldn't be written
+ */
+int PCD_savePbm(const PCD_Type* pcd, const char* path);
+
+/*!
+ 	 \brief	 This function compares the image shown with a PBM saved by PCD_savePbm (or any
+ 	 P4 of the same size without comments)
+ 	 \return int - the pixels that differ, or -1 if the PBM couldn't be read
+ */
+int PCD_comparePbm(const PCD_Type* pcd, const char* path);
+
+#endif /* TOOLS_PCD8544_H_ */
@@ -0,0 +1,210 @@
+/**
+	\file
+	\brief
+		Host test of PERIPH.hpp against the C drivers. The registers of SIM, the Flex
+		timers, the ADCs and the SPIs are blocks in RAM, starting with their reset values.
+		Each configuration of main.c is applied from reset with FTM_init, ADC_init or
+		SPI_init, and again with the init() of PERIPH.hpp; the register images left by
+		both must be the same, word by word, else the registers that differ are written
+		and the exit code is 1.
+
+		A thread stands in for the ADC: it ends the calibration, clearing CAL, with no
+		failure. The interruptions are not compared, only the registers (ADC_init enables
+		the ones of both ADCs).
+
+		With "combine", a configuration with COMBINE and DECAPEN is also tested: FTM_init
+		writes them to MODE, and PERIPH.hpp to COMBINE, so it fails until the drivers agree.
+
+		The drivers are built as C, as in the firmware, with tools/periphtest.h included
+		first; it points the instances to the registers in RAM.
+
+		Build and use, with the MK64F12.h of the SDK:
+			cc -c -I. -I<SDK include> -include tools/periphtest.h FlexTimer.c ADC.c SPI.c
+			c++ -std=c++17 -pthread -I. -I<SDK include> -o periphtest tools/periphtest.cpp \
+				FlexTimer.o ADC.o SPI.o
+			./periphtest [combine]
+	\date	19/10/2026
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include "periphtest.h"
+#include "PERIPH.hpp"
+
+extern "C" {
+unsigned long long testSimMemory[(sizeof(SIM_Type) + 7) / 8];
+unsigned long long testFtmMemory[4][(sizeof(FTM_Type) + 7) / 8];
+unsigned long long testAdcMemory[2][(sizeof(ADC_Type) + 7) / 8];
+unsigned long long testSpiMemory[3][(sizeof(SPI_Type) + 7) / 8];
+
+void NVIC_enableInterruptAndPriority(InterruptType interruptNumber, PriorityLevelType priority){
+	(void)interruptNumber;
+	(void)priority;
+}
+
+uint64 PIT_lifetimeRead(){
+	return 0;
+}
+}
+
+/*Reset values, from the reference manual, of the registers that the drivers touch and
+ * that are not 0*/
+#define RESET_FTM_MODE 0x00000004
+#define RESET_ADC_SC1 0x0000001F
+#define RESET_SPI_MCR 0x00004001
+
+/**
+ * Struct TestImageType is a copy of all the registers
+ * **/
+struct TestImageType{
+	unsigned long long sim[sizeof(testSimMemory) / 8];
+	unsigned long long ftm[4][sizeof(testFtmMemory[0]) / 8];
+	unsigned long long adc[2][sizeof(testAdcMemory[0]) / 8];
+	unsigned long long spi[3][sizeof(testSpiMemory[0]) / 8];
+};
+
+/*The ADC of the host, while the test runs*/
+static std::atomic<bool> testRunning(true);
+
+static void testAdcHardware(){
+	unsigned index;
+
+	while(testRunning){
+		for(index = 0; index < 2; index++){
+			if(ADC_handle[index]->SC3 & ADC_SC3_CAL_MASK){
+				ADC_handle[index]->SC3 &= ~ADC_SC3_CAL_MASK;
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+static void testReset(){
+	unsigned index;
+
+	std::memset(testSimMemory, 0, sizeof(testSimMemory));
+	std::memset(testFtmMemory, 0, sizeof(testFtmMemory));
+	std::memset(testAdcMemory, 0, sizeof(testAdcMemory));
+	std::memset(testSpiMemory, 0, sizeof(testSpiMemory));
+	for(index = 0; index < 4; index++){
+		FTM_handle[index]->MODE = RESET_FTM_MODE;
+	}
+	for(index = 0; index < 2; index++){
+		ADC_handle[index]->SC1[0] = RESET_ADC_SC1;
+		ADC_handle[index]->SC1[1] = RESET_ADC_SC1;
+	}
+	for(index = 0; index < 3; index++){
+		SPI_handle[index]->MCR = RESET_SPI_MCR;
+	}
+}
+
+static void testCapture(TestImageType* image){
+	std::memcpy(image->sim, testSimMemory, sizeof(testSimMemory));
+	std::memcpy(image->ftm, testFtmMemory, sizeof(testFtmMemory));
+	std::memcpy(image->adc, testAdcMemory, sizeof(testAdcMemory));
+	std::memcpy(image->spi, testSpiMemory, sizeof(testSpiMemory));
+}
+
+/*Write the words of a block that differ, returns how many*/
+static int testCompare(const char* name, const void* driver, const void* periph, size_t size){
+	const uint32_t* c = static_cast<const uint32_t*>(driver);
+	const uint32_t* cpp = static_cast<const uint32_t*>(periph);
+	size_t index;
+	int differ = 0;
+
+	for(index = 0; index < size / sizeof(uint32_t); index++){
+		if(c[index] != cpp[index]){
+			std::printf("  %s+0x%02zx: C 0x%08lx, PERIPH 0x%08lx\n", name, index * sizeof(uint32_t),
+					(unsigned long)c[index], (unsigned long)cpp[index]);
+			differ++;
+		}
+	}
+	return differ;
+}
+
+/*Apply a configuration with the C driver and with PERIPH.hpp, from reset, and compare the
+ * images. Returns the registers that differ*/
+static int testCase(const char* name, void (*driver)(), void (*periph)()){
+	static TestImageType c;
+	static TestImageType cpp;
+	char block[8];
+	unsigned index;
+	int differ;
+
+	testReset();
+	driver();
+	testCapture(&c);
+	testReset();
+	periph();
+	testCapture(&cpp);
+
+	std::printf("%s\n", name);
+	differ = testCompare("SIM", &c.sim, &cpp.sim, sizeof(c.sim));
+	for(index = 0; index < 4; index++){
+		std::snprintf(block, sizeof(block), "FTM%u", index);
+		differ += testCompare(block, &c.ftm[index], &cpp.ftm[index], sizeof(c.ftm[index]));
+	}
+	for(index = 0; index < 2; index++){
+		std::snprintf(block, sizeof(block), "ADC%u", index);
+		differ += testCompare(block, &c.adc[index], &cpp.adc[index], sizeof(c.adc[index]));
+	}
+	for(index = 0; index < 3; index++){
+		std::snprintf(block, sizeof(block), "SPI%u", index);
+		differ += testCompare(block, &c.spi[index], &cpp.spi[index], sizeof(c.spi[index]));
+	}
+	std::printf("  %s\n", differ ? "FAILED" : "ok");
+	return differ;
+}
+
+/*The configurations of main.c, for the C drivers and for PERIPH.hpp*/
+static const SPI_ConfigType testSpiConfig = {SPI_DISABLE_FIFO, SPI_LOW_POLARITY, SPI_LOW_PHASE, SPI_MSB,
+		SPI_0, SPI_MASTER, SPI_BAUD_RATE_2, SPI_FSIZE_8};
+static constexpr PERIPH::SpiConfig testSpiPeriph = {SPI_DISABLE_FIFO, SPI_LOW_POLARITY, SPI_LOW_PHASE, SPI_MSB,
+		SPI_MASTER, SPI_BAUD_RATE_2, SPI_FSIZE_8};
+
+static const ADC_ConfigType testAdcConfig = {ADC_0, A, SINGLE_ENDED, DAD0, LOW_POWER, ADIV_8, LONG_SAMPLE,
+		BITS_16, BUS_CLOCK, SOFTWARE_TRIGGER, HW_AVRG_ENABLED, SAMPLES_32};
+static constexpr PERIPH::AdcConfig testAdcPeriph = {A, SINGLE_ENDED, LOW_POWER, ADIV_8, LONG_SAMPLE,
+		BITS_16, BUS_CLOCK, SOFTWARE_TRIGGER, HW_AVRG_ENABLED, SAMPLES_32};
+
+static const FTM_ConfigType testInputConfig = {FTM_2, CHANNEL_N_1, FALSE, FALSE, FALSE, FALSE, FALSE, FALSE, TRUE,
+		0, 0, FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, TRUE, TRUE};
+static constexpr PERIPH::FtmConfig testInputPeriph = {FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, FALSE, 0, TRUE};
+static constexpr PERIPH::FtmChannelConfig testInputChannel = {FALSE, FALSE, FALSE, TRUE, TRUE, 0, FALSE, FALSE};
+
+static const FTM_ConfigType testPwmConfig = {FTM_0, CHANNEL_N_1, FALSE, FALSE, TRUE, TRUE, FALSE, TRUE, FALSE,
+		167, 0, FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, FALSE, FALSE};
+static constexpr PERIPH::FtmConfig testPwmPeriph = {FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, TRUE, 167, FALSE};
+static constexpr PERIPH::FtmChannelConfig testPwmChannel = {TRUE, FALSE, TRUE, FALSE, FALSE, 0, FALSE, FALSE};
+
+/*Dual edge capture on FTM1, channels 0 and 1, only with "combine"*/
+static const FTM_ConfigType testCombineConfig = {FTM_1, CHANNEL_N_0, TRUE, TRUE, FALSE, FALSE, FALSE, FALSE, TRUE,
+		0xFFFF, 0, FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, FALSE, FALSE};
+static constexpr PERIPH::FtmConfig testCombinePeriph = {FLEX_TIMER_CLKS_1, FLEX_TIMER_PS_1, FALSE, 0xFFFF, FALSE};
+static constexpr PERIPH::FtmChannelConfig testCombineChannel = {FALSE, FALSE, FALSE, TRUE, FALSE, 0, TRUE, TRUE};
+
+int main(int argc, char** argv){
+	std::thread adc(testAdcHardware);
+	int differ = 0;
+
+	differ += testCase("SPI0, LCD", [](){ SPI_init(&testSpiConfig); },
+			[](){ PERIPH::Spi<0>::init<testSpiPeriph>(); });
+	differ += testCase("ADC0, temperature", [](){ ADC_init(&testAdcConfig); },
+			[](){ PERIPH::Adc<0>::init<testAdcPeriph>(); });
+	differ += testCase("FTM2, input capture", [](){ FTM_init(&testInputConfig); },
+			[](){ PERIPH::Ftm<2>::init<testInputPeriph>(); PERIPH::Ftm<2>::Channel<1>::init<testInputChannel>(); });
+	differ += testCase("FTM0, PWM", [](){ FTM_init(&testPwmConfig); },
+			[](){ PERIPH::Ftm<0>::init<testPwmPeriph>(); PERIPH::Ftm<0>::Channel<1>::init<testPwmChannel>(); });
+	if((argc > 1) && !std::strcmp(argv[1], "combine")){
+		differ += testCase("FTM1, dual edge capture", [](){ FTM_init(&testCombineConfig); },
+				[](){ PERIPH::Ftm<1>::init<testCombinePeriph>(); PERIPH::Ftm<1>::Channel<0>::init<testCombineChannel>(); });
+	}
+
+	testRunning = false;
+	adc.join();
+	std::printf("%d registers differ\n", differ);
+	return differ ? 1 : 0;
+}
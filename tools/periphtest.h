@@ -0,0 +1,54 @@
+/**
+	\file
+	\brief
+		Registers in RAM for tools/periphtest.cpp. It is included first (-include) in the C
+		drivers and in the test, so the instances of SIM, the Flex timers, the ADCs and the
+		SPIs point to blocks in RAM instead of the peripherals. The interruptions are not
+		enabled on the host.
+	\date	19/10/2026
+ */
+
+#ifndef TOOLS_PERIPHTEST_H_
+#define TOOLS_PERIPHTEST_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "MK64F12.h"
+
+/*The blocks, as bytes: the register structs have read only members*/
+extern unsigned long long testSimMemory[(sizeof(SIM_Type) + 7) / 8];
+extern unsigned long long testFtmMemory[4][(sizeof(FTM_Type) + 7) / 8];
+extern unsigned long long testAdcMemory[2][(sizeof(ADC_Type) + 7) / 8];
+extern unsigned long long testSpiMemory[3][(sizeof(SPI_Type) + 7) / 8];
+
+#ifdef __cplusplus
+}
+#endif
+
+#undef SIM
+#define SIM ((SIM_Type*)testSimMemory)
+#undef FTM0
+#define FTM0 ((FTM_Type*)testFtmMemory[0])
+#undef FTM1
+#define FTM1 ((FTM_Type*)testFtmMemory[1])
+#undef FTM2
+#define FTM2 ((FTM_Type*)testFtmMemory[2])
+#undef FTM3
+#define FTM3 ((FTM_Type*)testFtmMemory[3])
+#undef ADC0
+#define ADC0 ((ADC_Type*)testAdcMemory[0])
+#undef ADC1
+#define ADC1 ((ADC_Type*)testAdcMemory[1])
+#undef SPI0
+#define SPI0 ((SPI_Type*)testSpiMemory[0])
+#undef SPI1
+#define SPI1 ((SPI_Type*)testSpiMemory[1])
+#undef SPI2
+#define SPI2 ((SPI_Type*)testSpiMemory[2])
+
+#undef __enable_irq
+#define __enable_irq()
+
+#endif /* TOOLS_PERIPHTEST_H_ */
@@ -0,0 +1,246 @@
+/**
+	\file
+	\brief
+		Host test of the scheduler (SCHED.c). The PIT is not used: the tool calls the tick
+		callback that SCHED_init() installs, and SCHED_dispatch() after each tick, so every
+		callback must run in the tick at which its timer expires.
+
+		- A timer with a period of 256 ticks, one lap of the root level, must be called
+		  once per lap. So must a one-shot timer that starts itself again with a delay of
+		  256 from its callback. Both go back to the slot that is being dispatched.
+		- A timer stopped by the callback of another timer of the same slot is not called.
+		- Random one-shot and periodic timers, also started and stopped from the callbacks,
+		  are checked against the tick at which each one has to expire.
+
+		Build and use:
+			cc -I. -I<SDK include> -o schedtest tools/schedtest.c SCHED.c
+			./schedtest [ticks, 2000000 by default] [seed]
+	\date	19/10/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "SCHED.h"
+#include "NVIC.h"
+
+/*Random timers*/
+#define TEST_TIMERS 32
+/*Ticks of the laps of the timers of 256 ticks*/
+#define TEST_LAP SCHED_ROOT_SIZE
+#define TEST_LAPS 1000
+
+/*The tick callback installed by SCHED_init*/
+static PIT_CallbackType testTick = 0;
+static long testErrors = 0;
+
+/*The PIT and the NVIC, only the tick callback is kept*/
+void PIT_clockGating(){
+}
+
+void PIT_enable(){
+}
+
+void PIT_loadCycles(PIT_TimerType pitTimer, uint32 cycles){
+	(void)pitTimer;
+	(void)cycles;
+}
+
+void PIT_callbackInstall(PIT_TimerType pitTimer, PIT_CallbackType callback){
+	(void)pitTimer;
+	testTick = callback;
+}
+
+void PIT_timerInterruptEnable(PIT_TimerType pitTimer){
+	(void)pitTimer;
+}
+
+void PIT_timerEnable(PIT_TimerType pitTimer){
+	(void)pitTimer;
+}
+
+void NVIC_enableInterruptAndPriority(InterruptType interruptNumber, PriorityLevelType priority){
+	(void)interruptNumber;
+	(void)priority;
+}
+
+static void testError(const char* what, long expected, long tick){
+	if(testErrors++ < 10){
+		fprintf(stderr, "%s: expected at tick %ld, called at tick %ld\n", what, expected, tick);
+	}
+}
+
+/*One tick of the PIT, and the main loop*/
+static void testStep(){
+	testTick();
+	SCHED_dispatch();
+}
+
+/*A timer of 256 ticks, periodic or started again from its callback*/
+static SCHED_TimerType testPeriodic;
+static SCHED_TimerType testRestarted;
+static long testPeriodicCalls = 0;
+static long testRestartedCalls = 0;
+
+/*A timer called twice in a tick is stopped, or it would be called forever*/
+static void testPeriodicCallback(){
+	if((long)SCHED_ticks() != TEST_LAP * (testPeriodicCalls + 1)){
+		testError("period of 256", TEST_LAP * (testPeriodicCalls + 1), SCHED_ticks());
+		SCHED_timerStop(&testPeriodic);
+	}
+	testPeriodicCalls++;
+}
+
+static void testRestartedCallback(){
+	if((long)SCHED_ticks() != TEST_LAP * (testRestartedCalls + 1)){
+		testError("started again with 256", TEST_LAP * (testRestartedCalls + 1), SCHED_ticks());
+		return;
+	}
+	testRestartedCalls++;
+	SCHED_timerStart(&testRestarted, TEST_LAP, 0, testRestartedCallback);
+}
+
+/*Two timers of the same slot, the callback of the first one stops the second one*/
+static SCHED_TimerType testStopper;
+static SCHED_TimerType testStopped;
+
+static void testStopperCallback(){
+	SCHED_timerStop(&testStopped);
+}
+
+static void testStoppedCallback(){
+	testError("stopped from a callback", -1, SCHED_ticks());
+}
+
+static int testLaps(){
+	long tick;
+
+	SCHED_init();
+	SCHED_timerStart(&testPeriodic, TEST_LAP, TEST_LAP, testPeriodicCallback);
+	SCHED_timerStart(&testRestarted, TEST_LAP, 0, testRestartedCallback);
+	for(tick = 0; tick < TEST_LAP * TEST_LAPS; tick++){
+		/*The last timer started is the first one of the slot, so the stopper is called first*/
+		if(!(tick % (TEST_LAP + 1))){
+			SCHED_timerStart(&testStopped, 10, 0, testStoppedCallback);
+			SCHED_timerStart(&testStopper, 10, 0, testStopperCallback);
+		}
+		testStep();
+	}
+	if((TEST_LAPS != testPeriodicCalls) || (TEST_LAPS != testRestartedCalls)){
+		fprintf(stderr, "%d laps: the period of 256 was called %ld times, the timer started again %ld times\n",
+				TEST_LAPS, testPeriodicCalls, testRestartedCalls);
+		testErrors++;
+	}
+	return testErrors ? 1 : 0;
+}
+
+/*Random timers, each one with the tick at which it has to be called next, or -1*/
+static SCHED_TimerType testTimer[TEST_TIMERS];
+static long testExpires[TEST_TIMERS];
+static uint32 testPeriod[TEST_TIMERS];
+static long testCalls = 0;
+static const SCHED_CallbackType testCallback[TEST_TIMERS];
+
+/*A delay that may land on any level of the wheel*/
+static uint32 testDelay(){
+	switch(rand() % 4){
+	case 0:
+		return 1 + rand() % 4;
+	case 1:
+		return 1 + rand() % (2 * SCHED_ROOT_SIZE);
+	case 2:
+		return 1 + rand() % (SCHED_ROOT_SIZE << SCHED_LEVEL_BITS);
+	default:
+		return 1 + rand() % (SCHED_ROOT_SIZE << (2 * SCHED_LEVEL_BITS));
+	}
+}
+
+static void testStart(int index){
+	uint32 delay = testDelay();
+
+	testPeriod[index] = (rand() % 2) ? testDelay() : 0;
+	testExpires[index] = (long)SCHED_ticks() + delay;
+	SCHED_timerStart(&testTimer[index], delay, testPeriod[index], testCallback[index]);
+}
+
+static void testStop(int index){
+	testExpires[index] = -1;
+	SCHED_timerStop(&testTimer[index]);
+}
+
+/*Callback of a random timer: it must be called at its tick, and it starts or stops
+ * another timer from time to time*/
+static void testRandomCallback(int index){
+	int other = rand() % TEST_TIMERS;
+
+	if(testExpires[index] != (long)SCHED_ticks()){
+		testError("random timer", testExpires[index], SCHED_ticks());
+	}
+	testExpires[index] = testPeriod[index] ? testExpires[index] + (long)testPeriod[index] : -1;
+	testCalls++;
+	switch(rand() % 8){
+	case 0:
+		testStop(other);
+		break;
+	case 1:
+		testStart(other);
+		break;
+	default:
+		break;
+	}
+}
+
+#define TEST_CALLBACK(index) static void testCallback##index(){ testRandomCallback(index); }
+TEST_CALLBACK(0) TEST_CALLBACK(1) TEST_CALLBACK(2) TEST_CALLBACK(3)
+TEST_CALLBACK(4) TEST_CALLBACK(5) TEST_CALLBACK(6) TEST_CALLBACK(7)
+TEST_CALLBACK(8) TEST_CALLBACK(9) TEST_CALLBACK(10) TEST_CALLBACK(11)
+TEST_CALLBACK(12) TEST_CALLBACK(13) TEST_CALLBACK(14) TEST_CALLBACK(15)
+TEST_CALLBACK(16) TEST_CALLBACK(17) TEST_CALLBACK(18) TEST_CALLBACK(19)
+TEST_CALLBACK(20) TEST_CALLBACK(21) TEST_CALLBACK(22) TEST_CALLBACK(23)
+TEST_CALLBACK(24) TEST_CALLBACK(25) TEST_CALLBACK(26) TEST_CALLBACK(27)
+TEST_CALLBACK(28) TEST_CALLBACK(29) TEST_CALLBACK(30) TEST_CALLBACK(31)
+
+static const SCHED_CallbackType testCallback[TEST_TIMERS] = {
+	testCallback0, testCallback1, testCallback2, testCallback3,
+	testCallback4, testCallback5, testCallback6, testCallback7,
+	testCallback8, testCallback9, testCallback10, testCallback11,
+	testCallback12, testCallback13, testCallback14, testCallback15,
+	testCallback16, testCallback17, testCallback18, testCallback19,
+	testCallback20, testCallback21, testCallback22, testCallback23,
+	testCallback24, testCallback25, testCallback26, testCallback27,
+	testCallback28, testCallback29, testCallback30, testCallback31
+};
+
+static int testRandom(long ticks){
+	long tick;
+	int index;
+
+	SCHED_init();
+	for(index = 0; index < TEST_TIMERS; index++){
+		testStart(index);
+	}
+	for(tick = 0; (tick < ticks) && !testErrors; tick++){
+		testStep();
+		/*A timer due up to this tick that is still waiting was not called*/
+		for(index = 0; index < TEST_TIMERS; index++){
+			if(SCHED_timerActive(&testTimer[index]) != (testExpires[index] >= 0) ||
+					((testExpires[index] >= 0) && (testExpires[index] <= (long)SCHED_ticks()))){
+				testError("random timer not called", testExpires[index], SCHED_ticks());
+			}
+		}
+		if(!(rand() % 64)){
+			testStart(rand() % TEST_TIMERS);
+		}
+	}
+	return testErrors ? 1 : 0;
+}
+
+int main(int argc, char** argv){
+	long ticks = (argc > 1) ? strtol(argv[1], 0, 0) : 2000000;
+
+	srand((argc > 2) ? strtol(argv[2], 0, 0) : 1);
+	if(testLaps() || testRandom(ticks)){
+		return 1;
+	}
+	printf("%d laps of 256 ticks ok, %ld ticks of random timers ok, %ld calls\n", TEST_LAPS, ticks, testCalls);
+	return 0;
+}
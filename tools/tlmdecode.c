@@ -0,0 +1,359 @@
+/**
+	\file
+	\brief
+		Host tool that decodes the telemetry frames (see TLM.h for the layout) from a serial
+		port, and writes them to stdout as CSV. The frames are split at each COBS_DELIMITER,
+		so the tool syncs to the stream at any point; the frames with a bad COBS block, size
+		or CRC are counted and skipped, and the gaps in the sequence numbers are counted as
+		frames lost (dropped by the board, or not received). The counters are written to
+		stderr at the end, or with Ctrl+C.
+
+		A pseudo terminal can stand in for the board: with socat the frames written in one
+		end come out of the other, and with -t the tool tests itself, writing frames (some of
+		them corrupted or missing) in the master of a pseudo terminal that it opens, and
+		decoding them from its slave, as it does with a serial port.
+
+		Build and use:
+			cc -I. -o tlmdecode tools/tlmdecode.c COBS.c CRC.c
+			./tlmdecode /dev/ttyACM0
+			socat -d -d pty,raw,echo=0 pty,raw,echo=0     (prints the two ends)
+			./tlmdecode /dev/pts/N
+			./tlmdecode -t [frames, 10000 by default]
+	\date	19/10/2026
+ */
+
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "TLM.h"
+#include "CRC.h"
+
+/*Longest run of bytes kept before a delimiter, a longer one is not a frame*/
+#define DEC_BUFFER 64
+/*Frames written in the pseudo terminal at a time by -t, less than its buffer*/
+#define TEST_BATCH 64
+
+/**
+ * Struct DecoderType has the bytes received since the last delimiter, and the counters
+ * **/
+typedef struct{
+	uint8 buffer[DEC_BUFFER];
+	uint16 length;
+	uint8 overflow;
+	uint8 synced;
+	uint16 sequence;
+	uint8 haveSequence;
+	long frames;
+	long errors;
+	long lost;
+}DecoderType;
+
+/*A status frame decoded*/
+typedef struct{
+	uint8 flags;
+	uint16 sequence;
+	uint32 time;
+	sint32 temperature;
+	sint32 frec;
+	uint8 speed;
+	uint8 alarm;
+	uint8 perInc;
+	uint8 state;
+}StatusType;
+
+static volatile sig_atomic_t stop = 0;
+
+static void onSignal(int signal){
+	(void)signal;
+	stop = 1;
+}
+
+/*Read a value in little endian*/
+static uint32 get(const uint8* data, int bytes){
+	uint32 value = 0;
+
+	while(bytes--){
+		value = (value << 8) | data[bytes];
+	}
+	return value & 0xFFFFFFFFUL;
+}
+
+/*Write a value in little endian*/
+static void put(uint8* data, uint32 value, int bytes){
+	while(bytes--){
+		*data++ = (uint8)value;
+		value >>= 8;
+	}
+}
+
+/*Unpack a frame decoded, FALSE if it is not a status frame*/
+static int unpack(const uint8* frame, uint16 length, StatusType* status){
+	uint16 crc;
+
+	if((TLM_FRAME_SIZE != length) || (TLM_KIND_STATUS != frame[TLM_KIND_OFFSET])){
+		return 0;
+	}
+	crc = CRC_ccitt(CRC_INIT, frame, TLM_CRC_OFFSET);
+	if(crc != (uint16)get(&frame[TLM_CRC_OFFSET], 2)){
+		return 0;
+	}
+	status->flags = frame[TLM_FLAGS_OFFSET];
+	status->sequence = (uint16)get(&frame[TLM_SEQUENCE_OFFSET], 2);
+	status->time = get(&frame[TLM_TIME_OFFSET], 4);
+	status->temperature = (sint32)(int)get(&frame[TLM_TEMPERATURE_OFFSET], 4);
+	status->frec = (sint32)(int)get(&frame[TLM_FREC_OFFSET], 4);
+	status->speed = frame[TLM_SPEED_OFFSET];
+	status->alarm = frame[TLM_ALARM_OFFSET];
+	status->perInc = frame[TLM_PERINC_OFFSET];
+	status->state = frame[TLM_STATE_OFFSET];
+	return 1;
+}
+
+/*Pack a status frame, like TLM_pack() in TLM.c*/
+static void pack(const StatusType* status, uint8* frame){
+	frame[TLM_KIND_OFFSET] = TLM_KIND_STATUS;
+	frame[TLM_FLAGS_OFFSET] = status->flags;
+	put(&frame[TLM_SEQUENCE_OFFSET], status->sequence, 2);
+	put(&frame[TLM_TIME_OFFSET], status->time, 4);
+	put(&frame[TLM_TEMPERATURE_OFFSET], (uint32)status->temperature, 4);
+	put(&frame[TLM_FREC_OFFSET], (uint32)status->frec, 4);
+	frame[TLM_SPEED_OFFSET] = status->speed;
+	frame[TLM_ALARM_OFFSET] = status->alarm;
+	frame[TLM_PERINC_OFFSET] = status->perInc;
+	frame[TLM_STATE_OFFSET] = status->state;
+	put(&frame[TLM_CRC_OFFSET], CRC_ccitt(CRC_INIT, frame, TLM_CRC_OFFSET), 2);
+}
+
+static void printHeader(FILE* out){
+	fprintf(out, "sequence,time_ms,temperature_C,frequency_Hz,speed,alarm_C,percentage,"
+			"format,manual,alarm_level,state\n");
+}
+
+static void printStatus(FILE* out, const StatusType* status){
+	fprintf(out, "%u,%lu,%.2f,%.2f,%u,%u,%u,%u,%u,%u,%u\n", status->sequence,
+			(unsigned long)status->time, status->temperature / 100.0, status->frec / 100.0,
+			status->speed, status->alarm, status->perInc,
+			(status->flags & TLM_FLAG_FORMAT) ? 1 : 0, (status->flags & TLM_FLAG_MANUAL) ? 1 : 0,
+			(status->flags & TLM_LEVEL_MASK) >> TLM_LEVEL_SHIFT, status->state);
+}
+
+/*Take a byte of the stream, returns TRUE and the status when it ends a valid frame*/
+static int feed(DecoderType* decoder, uint8 byte, StatusType* status){
+	uint16 length;
+
+	if(COBS_DELIMITER != byte){
+		if(decoder->length < DEC_BUFFER){
+			decoder->buffer[decoder->length++] = byte;
+		} else {
+			decoder->overflow = 1;
+		}
+		return 0;
+	}
+
+	length = decoder->length;
+	decoder->length = 0;
+	/*The bytes before the first delimiter are the end of a frame that started before*/
+	if(!decoder->synced){
+		decoder->synced = 1;
+		return 0;
+	}
+	if(decoder->overflow){
+		decoder->overflow = 0;
+		decoder->errors++;
+		return 0;
+	}
+	length = COBS_decode(decoder->buffer, length, decoder->buffer);
+	if((COBS_INVALID == length) || !unpack(decoder->buffer, length, status)){
+		decoder->errors++;
+		return 0;
+	}
+	if(decoder->haveSequence){
+		decoder->lost += (uint16)(status->sequence - decoder->sequence - 1);
+	}
+	decoder->sequence = status->sequence;
+	decoder->haveSequence = 1;
+	decoder->frames++;
+	return 1;
+}
+
+/*Raw bytes, no echo nor translations; the speed matters only for a real serial port*/
+static int setRaw(int fd){
+	struct termios settings;
+
+	if(tcgetattr(fd, &settings)){
+		return -1;
+	}
+	cfmakeraw(&settings);
+#ifdef B460800
+	cfsetispeed(&settings, B460800);
+	cfsetospeed(&settings, B460800);
+#endif
+	settings.c_cc[VMIN] = 1;
+	settings.c_cc[VTIME] = 0;
+	return tcsetattr(fd, TCSANOW, &settings);
+}
+
+static void printCounters(const DecoderType* decoder){
+	fprintf(stderr, "%ld frames, %ld bad, %ld lost\n", decoder->frames, decoder->errors,
+			decoder->lost);
+}
+
+/*Decode a serial port, or any file, until its end or Ctrl+C*/
+static int decodePort(const char* path){
+	DecoderType decoder;
+	StatusType status;
+	uint8 bytes[256];
+	ssize_t count;
+	ssize_t index;
+	int fd = open(path, O_RDONLY | O_NOCTTY);
+
+	if(fd < 0){
+		perror(path);
+		return 2;
+	}
+	if(isatty(fd) && setRaw(fd)){
+		perror(path);
+		return 2;
+	}
+	signal(SIGINT, onSignal);
+	memset(&decoder, 0, sizeof(decoder));
+	printHeader(stdout);
+	while(!stop && ((count = read(fd, bytes, sizeof(bytes))) > 0)){
+		for(index = 0; index < count; index++){
+			if(feed(&decoder, bytes[index], &status)){
+				printStatus(stdout, &status);
+			}
+		}
+		fflush(stdout);
+	}
+	close(fd);
+	printCounters(&decoder);
+	return 0;
+}
+
+/*Status of the frame with a sequence number, in the self test. The sequence number wraps,
+ * the status repeats with it*/
+static void testStatus(long frame, StatusType* status){
+	frame &= 0xFFFF;
+	status->sequence = (uint16)frame;
+	status->flags = (uint8)((frame & 3) | ((frame % 3) << TLM_LEVEL_SHIFT));
+	status->time = (uint32)(frame * 10);
+	status->temperature = (sint32)(frame % 9000) - 2000;
+	status->frec = (sint32)((frame * 37) % 100000);
+	status->speed = (uint8)(frame % 101);
+	status->alarm = (uint8)(15 + frame % 31);
+	status->perInc = (uint8)(5 * (1 + frame % 20));
+	status->state = (uint8)(frame % 8);
+}
+
+/*Write frames, some corrupted or missing, in a pseudo terminal and decode them from it*/
+static int selfTest(long frames){
+	DecoderType decoder;
+	StatusType status;
+	StatusType expected;
+	uint8 frame[TLM_FRAME_SIZE];
+	uint8 batch[TEST_BATCH * TLM_ENCODED_SIZE];
+	uint8 bytes[256];
+	long next = 0;
+	long corrupted = 0;
+	long skipped = 0;
+	long batchFrames;
+	size_t length;
+	size_t received;
+	ssize_t count;
+	ssize_t index;
+	uint16 size;
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	int slave;
+
+	if((master < 0) || grantpt(master) || unlockpt(master)){
+		perror("pseudo terminal");
+		return 2;
+	}
+	slave = open(ptsname(master), O_RDONLY | O_NOCTTY);
+	if((slave < 0) || setRaw(slave)){
+		perror(ptsname(master));
+		return 2;
+	}
+	memset(&decoder, 0, sizeof(decoder));
+	memset(&status, 0, sizeof(status));
+	memset(&expected, 0, sizeof(expected));
+	srand(1);
+	/*A partial frame first, the decoder must sync at its end*/
+	length = 0;
+	batch[length++] = 0x55;
+	batch[length++] = 0xAA;
+	batch[length++] = COBS_DELIMITER;
+
+	while(next < frames){
+		for(batchFrames = 0; (batchFrames < TEST_BATCH) && (next < frames); batchFrames++, next++){
+			/*The board dropped it. The first and last frames always arrive, so every
+			 * frame lost is between two that are decoded*/
+			if((0 == rand() % 50) && next && (next < frames - 1)){
+				skipped++;
+				continue;
+			}
+			testStatus(next, &status);
+			pack(&status, frame);
+			size = COBS_encode(frame, TLM_FRAME_SIZE, &batch[length]);
+			/*A bit flipped in the line, the delimiter is left as it is*/
+			if((0 == rand() % 20) && next && (next < frames - 1)){
+				batch[length + rand() % (size - 1)] ^= (uint8)(1 << (rand() % 8));
+				corrupted++;
+			}
+			length += size;
+		}
+		if(write(master, batch, length) != (ssize_t)length){
+			perror("write");
+			return 2;
+		}
+		for(received = 0; received < length; received += count){
+			count = read(slave, bytes, sizeof(bytes));
+			if(count <= 0){
+				perror("read");
+				return 2;
+			}
+			for(index = 0; index < count; index++){
+				if(!feed(&decoder, bytes[index], &status)){
+					continue;
+				}
+				testStatus(status.sequence, &expected);
+				if(memcmp(&status, &expected, sizeof(status))){
+					fprintf(stderr, "frame %u decoded wrong\n", status.sequence);
+					return 1;
+				}
+			}
+		}
+		length = 0;
+	}
+	close(slave);
+	close(master);
+
+	printCounters(&decoder);
+	/*A flipped bit can split a frame in two, both are bad*/
+	if((decoder.frames != frames - skipped - corrupted) || (decoder.errors < corrupted) ||
+			(decoder.lost != skipped + corrupted)){
+		fprintf(stderr, "expected %ld frames, %ld corrupted, %ld lost\n",
+				frames - skipped - corrupted, corrupted, skipped + corrupted);
+		return 1;
+	}
+	printf("%ld frames through a pseudo terminal: OK\n", frames);
+	return 0;
+}
+
+int main(int argc, char** argv){
+	if((argc > 1) && !strcmp(argv[1], "-t")){
+		return selfTest((argc > 2) ? strtol(argv[2], 0, 0) : 10000);
+	}
+	if(argc != 2){
+		fprintf(stderr, "use: %s serial port | -t [frames]\n", argv[0]);
+		return 2;
+	}
+	return decodePort(argv[1]);
+}